@@ -60,6 +60,17 @@ int CPL_DLL CPL_STDCALL GDALDitherRGB2PCT(
 int CPL_DLL CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff,
                                           int nYOff, int nXSize, int nYSize);
 
+/** Size in bytes of the hashes computed by GDALComputeImageHash() */
+#define GDAL_IMAGE_HASH_SIZE 32
+
+/** Size in pixels of the tiles hashed by GDALComputeImageHash() */
+#define GDAL_IMAGE_HASH_TILE_SIZE 256
+
+CPLErr CPL_DLL GDALComputeImageHash(GDALRasterBandH hBand, int nXOff,
+                                    int nYOff, int nXSize, int nYSize,
+                                    GByte *pabyHash, GByte **ppabyTileHashes,
+                                    int *pnTilesX, int *pnTilesY);
+
 CPLErr CPL_DLL CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
                                                 GDALRasterBandH hProximityBand,
                                                 char **papszOptions,
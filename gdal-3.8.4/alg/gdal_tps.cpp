@@ -32,6 +32,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <map>
 #include <utility>
 
@@ -66,6 +67,9 @@ typedef struct
 
     bool bReversed;
 
+    // Number of GCPs per cell in localized mode, or 0 for a global spline
+    int nLocalizedGCPsPerCell;
+
     int nGCPCount;
     GDAL_GCP *pasGCPList;
 
@@ -100,8 +104,17 @@ static void *GDALCreateSimilarTPSTransformer(void *hTransformArg,
             pasGCPList[i].dfGCPPixel /= dfRatioX;
             pasGCPList[i].dfGCPLine /= dfRatioY;
         }
-        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformer(
-            psInfo->nGCPCount, pasGCPList, psInfo->bReversed));
+        CPLStringList aosOptions;
+        if (psInfo->nLocalizedGCPsPerCell > 0)
+        {
+            aosOptions.SetNameValue("TPS_LOCALIZED", "YES");
+            aosOptions.SetNameValue(
+                "TPS_LOCALIZED_GCPS_PER_CELL",
+                CPLSPrintf("%d", psInfo->nLocalizedGCPsPerCell));
+        }
+        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformerInt(
+            psInfo->nGCPCount, pasGCPList, psInfo->bReversed,
+            aosOptions.List()));
         GDALDeinitGCPs(psInfo->nGCPCount, pasGCPList);
         CPLFree(pasGCPList);
     }
@@ -128,6 +141,13 @@ static void *GDALCreateSimilarTPSTransformer(void *hTransformArg,
  * for large numbers of GCPs.  For instance, for reference, it takes on the
  * order of 10s for 400 GCPs on a 2GHz Athlon processor.
  *
+ * Starting with GDAL 3.9, if the TPS_LOCALIZED=YES transformer option is set
+ * with GDALCreateGenImgProjTransformer2(), a localized variant is used:
+ * splines are fitted on the GCPs of each cell of a regular grid and its
+ * neighbours, and blended together. The transformation remains exact at the
+ * control points, while creation time and memory use grow linearly with the
+ * number of GCPs.
+ *
  * TPS Transformers are serializable.
  *
  * The GDAL Thin Plate Spline transformer is based on code provided by
@@ -256,6 +276,19 @@ void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
     psInfo->dfSrcApproxErrorReverse = CPLAtof(
         CSLFetchNameValueDef(papszOptions, "SRC_APPROX_ERROR_IN_PIXEL", "0"));
 
+    /* -------------------------------------------------------------------- */
+    /*      Use a localized spline if requested, as the global one is      */
+    /*      O(N^3) to solve and O(N) per transformed point.                 */
+    /* -------------------------------------------------------------------- */
+    if (CPLFetchBool(papszOptions, "TPS_LOCALIZED", false))
+    {
+        psInfo->nLocalizedGCPsPerCell = std::max(
+            1, atoi(CSLFetchNameValueDef(papszOptions,
+                                         "TPS_LOCALIZED_GCPS_PER_CELL", "16")));
+        psInfo->poForward->set_localized(psInfo->nLocalizedGCPsPerCell);
+        psInfo->poReverse->set_localized(psInfo->nLocalizedGCPsPerCell);
+    }
+
     int nThreads = 1;
     if (nGCPCount > 100)
     {
@@ -443,6 +476,14 @@ CPLXMLNode *GDALSerializeTPSTransformer(void *pTransformArg)
             CPLString().Printf("%g", psInfo->dfSrcApproxErrorReverse));
     }
 
+    if (psInfo->nLocalizedGCPsPerCell > 0)
+    {
+        CPLCreateXMLElementAndValue(psTree, "Localized", "YES");
+        CPLCreateXMLElementAndValue(
+            psTree, "LocalizedGCPsPerCell",
+            CPLString().Printf("%d", psInfo->nLocalizedGCPsPerCell));
+    }
+
     return psTree;
 }
 
@@ -475,6 +516,11 @@ void *GDALDeserializeTPSTransformer(CPLXMLNode *psTree)
     aosOptions.SetNameValue(
         "SRC_APPROX_ERROR_IN_PIXEL",
         CPLGetXMLValue(psTree, "SrcApproxErrorInPixel", nullptr));
+    aosOptions.SetNameValue("TPS_LOCALIZED",
+                            CPLGetXMLValue(psTree, "Localized", nullptr));
+    aosOptions.SetNameValue(
+        "TPS_LOCALIZED_GCPS_PER_CELL",
+        CPLGetXMLValue(psTree, "LocalizedGCPsPerCell", nullptr));
 
     /* -------------------------------------------------------------------- */
     /*      Generate transformation.                                        */
@@ -30,18 +30,273 @@
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_sha256.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
+namespace
+{
+/** Rectangle, relative to the processed window, read in one RasterIO() */
+struct GDALChecksumChunk
+{
+    int nXOff;
+    int nYOff;
+    int nXSize;
+    int nYSize;
+};
+}  // namespace
+
+/************************************************************************/
+/*                      GDALChecksumGetChunks()                         */
+/************************************************************************/
+
+// Split a window of nXSize x nYSize pixels into chunks whose width is a
+// multiple of nTileXSize (or the window width), and height is nTileYSize,
+// so that a chunk holds at most max(10 MB, GDAL_CACHEMAX / 10)
+static std::vector<GDALChecksumChunk>
+GDALChecksumGetChunks(int nXSize, int nYSize, int nTileXSize, int nTileYSize,
+                      int nDTSize, int &nChunkXSize, int &nChunkYSize)
+{
+    nChunkXSize = std::min(nTileXSize, nXSize);
+    nChunkYSize = std::min(nTileYSize, nYSize);
+    if (nTileXSize < nXSize)
+    {
+        const GIntBig nMaxChunkSize = std::max(
+            static_cast<GIntBig>(10 * 1000 * 1000), GDALGetCacheMax64() / 10);
+        if (nDTSize > 0 && static_cast<GIntBig>(nXSize) * nChunkYSize <
+                               nMaxChunkSize / nDTSize)
+        {
+            // A full line of height nChunkYSize can fit in the maximum
+            // allowed memory
+            nChunkXSize = nXSize;
+        }
+        else
+        {
+            // Otherwise compute a size that is a multiple of nTileXSize
+            nChunkXSize = static_cast<int>(std::min(
+                static_cast<GIntBig>(nXSize),
+                nTileXSize *
+                    std::max(static_cast<GIntBig>(1),
+                             nMaxChunkSize / (static_cast<GIntBig>(nTileXSize) *
+                                              nChunkYSize * nDTSize))));
+        }
+    }
+
+    std::vector<GDALChecksumChunk> aoChunks;
+    if (nXSize <= 0 || nYSize <= 0)
+        return aoChunks;
+    const int nYChunks = DIV_ROUND_UP(nYSize, nChunkYSize);
+    const int nXChunks = DIV_ROUND_UP(nXSize, nChunkXSize);
+    for (int iYChunk = 0; iYChunk < nYChunks; ++iYChunk)
+    {
+        const int iYStart = iYChunk * nChunkYSize;
+        const int iYEnd =
+            iYChunk == nYChunks - 1 ? nYSize : iYStart + nChunkYSize;
+        for (int iXChunk = 0; iXChunk < nXChunks; ++iXChunk)
+        {
+            const int iXStart = iXChunk * nChunkXSize;
+            const int iXEnd =
+                iXChunk == nXChunks - 1 ? nXSize : iXStart + nChunkXSize;
+            aoChunks.push_back(
+                GDALChecksumChunk{iXStart, iYStart, iXEnd - iXStart,
+                                  iYEnd - iYStart});
+        }
+    }
+    return aoChunks;
+}
+
+/************************************************************************/
+/*                    GDALChecksumReopenDataset()                       */
+/************************************************************************/
+
+// Open another handle on the dataset of hBand, so that it can be read from
+// another thread. Returns nullptr if that is not possible or safe.
+static GDALDatasetH GDALChecksumReopenDataset(GDALRasterBandH hBand)
+{
+    auto poBand = GDALRasterBand::FromHandle(hBand);
+    auto poDS = poBand->GetDataset();
+    const int nBand = poBand->GetBand();
+    // Mask and overview bands have no band number. Datasets in update mode
+    // may have pending changes in the block cache.
+    if (poDS == nullptr || nBand <= 0 || poDS->GetAccess() != GA_ReadOnly ||
+        poDS->GetDescription()[0] == '\0' || poDS->GetDriver() == nullptr ||
+        EQUAL(poDS->GetDriver()->GetDescription(), "MEM"))
+    {
+        return nullptr;
+    }
+
+    const char *const apszAllowedDrivers[] = {
+        poDS->GetDriver()->GetDescription(), nullptr};
+    GDALDatasetH hDS;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        hDS = GDALOpenEx(poDS->GetDescription(), GDAL_OF_RASTER,
+                         apszAllowedDrivers, poDS->GetOpenOptions(), nullptr);
+    }
+    if (hDS == nullptr)
+        return nullptr;
+
+    if (GDALGetRasterXSize(hDS) != poDS->GetRasterXSize() ||
+        GDALGetRasterYSize(hDS) != poDS->GetRasterYSize() ||
+        GDALGetRasterCount(hDS) != poDS->GetRasterCount() ||
+        GDALGetRasterDataType(GDALGetRasterBand(hDS, nBand)) !=
+            poBand->GetRasterDataType())
+    {
+        GDALClose(hDS);
+        return nullptr;
+    }
+    return hDS;
+}
+
+/************************************************************************/
+/*                    GDALChecksumProcessChunks()                       */
+/************************************************************************/
+
+typedef std::function<void(size_t, const GDALChecksumChunk &, void *)>
+    GDALChecksumChunkFunc;
+
+// Read each chunk of the window starting at (nXOff, nYOff) as eBufType, and
+// call fnProcess(iChunk, chunk, pData) on it.
+// When GDAL_NUM_THREADS is set and the dataset can be opened several times,
+// chunks are read and processed from several threads, each with its own
+// dataset handle. fnProcess() must then only write to state specific to
+// iChunk.
+static bool GDALChecksumProcessChunks(
+    GDALRasterBandH hBand, int nXOff, int nYOff,
+    const std::vector<GDALChecksumChunk> &aoChunks, int nChunkXSize,
+    int nChunkYSize, GDALDataType eBufType,
+    const GDALChecksumChunkFunc &fnProcess)
+{
+    // Empty window: nothing to read, and the result is the initial value
+    if (aoChunks.empty())
+        return true;
+
+    const int nBufDTSize = GDALGetDataTypeSizeBytes(eBufType);
+
+    struct Worker
+    {
+        GDALDatasetH hDS = nullptr;  // owned, if not null
+        GDALRasterBandH hBand = nullptr;
+        void *pBuffer = nullptr;
+    };
+    std::vector<Worker> aoWorkers;
+
+    const int nThreads = static_cast<int>(std::min<size_t>(
+        aoChunks.size(), GDALGetNumThreads(nullptr, nullptr,
+                                           /* nMaxThreads = */ 128)));
+
+    // The calling thread reads from the passed band, and other workers
+    // from other handles of the same dataset.
+    aoWorkers.emplace_back();
+    aoWorkers.back().hBand = hBand;
+    for (int i = 1; i < nThreads; ++i)
+    {
+        GDALDatasetH hDS = GDALChecksumReopenDataset(hBand);
+        if (hDS == nullptr)
+            break;
+        aoWorkers.emplace_back();
+        aoWorkers.back().hDS = hDS;
+        aoWorkers.back().hBand =
+            GDALGetRasterBand(hDS, GDALGetBandNumber(hBand));
+    }
+
+    bool bOK = true;
+    for (auto &oWorker : aoWorkers)
+    {
+        oWorker.pBuffer =
+            VSI_MALLOC3_VERBOSE(nChunkXSize, nChunkYSize, nBufDTSize);
+        if (oWorker.pBuffer == nullptr)
+            bOK = false;
+    }
+
+    std::atomic<size_t> nNextChunk{0};
+    std::atomic<bool> bError{false};
+    const auto RunWorker = [&](Worker &oWorker)
+    {
+        while (!bError)
+        {
+            const size_t iChunk = nNextChunk++;
+            if (iChunk >= aoChunks.size())
+                break;
+            const auto &oChunk = aoChunks[iChunk];
+            if (GDALRasterIO(oWorker.hBand, GF_Read, nXOff + oChunk.nXOff,
+                             nYOff + oChunk.nYOff, oChunk.nXSize,
+                             oChunk.nYSize, oWorker.pBuffer, oChunk.nXSize,
+                             oChunk.nYSize, eBufType, 0, 0) != CE_None)
+            {
+                bError = true;
+                break;
+            }
+            fnProcess(iChunk, oChunk, oWorker.pBuffer);
+        }
+    };
+
+    CPLWorkerThreadPool *poThreadPool =
+        bOK && aoWorkers.size() > 1
+            ? GDALGetGlobalThreadPool(static_cast<int>(aoWorkers.size()) - 1)
+            : nullptr;
+    if (poThreadPool)
+    {
+        struct JobStruct
+        {
+            const decltype(RunWorker) *pfnRunWorker;
+            Worker *poWorker;
+        };
+        std::vector<JobStruct> asJobs;
+        for (size_t i = 1; i < aoWorkers.size(); ++i)
+            asJobs.push_back(JobStruct{&RunWorker, &aoWorkers[i]});
+        auto poJobQueue = poThreadPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+        {
+            poJobQueue->SubmitJob(
+                [](void *pData)
+                {
+                    auto psJob = static_cast<JobStruct *>(pData);
+                    (*(psJob->pfnRunWorker))(*(psJob->poWorker));
+                },
+                &sJob);
+        }
+        RunWorker(aoWorkers[0]);
+        poJobQueue->WaitCompletion();
+    }
+    else if (bOK)
+    {
+        RunWorker(aoWorkers[0]);
+    }
+
+    for (auto &oWorker : aoWorkers)
+    {
+        VSIFree(oWorker.pBuffer);
+        if (oWorker.hDS)
+            GDALClose(oWorker.hDS);
+    }
+
+    if (bOK && bError)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Checksum value could not be computed due to I/O "
+                 "read error.");
+    }
+    return bOK && !bError;
+}
+
 /************************************************************************/
 /*                         GDALChecksumImage()                          */
 /************************************************************************/
@@ -54,6 +309,11 @@ CPL_CVSID("$Id$")
  * so decimal portions of such raster data will not affect the checksum.
  * Real and Imaginary components of complex bands influence the result.
  *
+ * Starting with GDAL 3.9, if the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than 1 (or ALL_CPUS), and the dataset of the band
+ * can be re-opened in read-only mode, the region is read and processed per
+ * block-aligned chunk from several threads. The checksum value is the same.
+ *
  * @param hBand the raster band to read from.
  * @param nXOff pixel offset of window to read.
  * @param nYOff line offset of window to read.
@@ -71,206 +331,287 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
 
     const static int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
 
-    int nChecksum = 0;
-    int iPrime = 0;
     const GDALDataType eDataType = GDALGetRasterDataType(hBand);
     const bool bComplex = CPL_TO_BOOL(GDALDataTypeIsComplex(eDataType));
+    const bool bFloat = eDataType == GDT_Float32 ||
+                        eDataType == GDT_Float64 ||
+                        eDataType == GDT_CFloat32 || eDataType == GDT_CFloat64;
+    const GDALDataType eDstDataType =
+        bFloat ? (bComplex ? GDT_CFloat64 : GDT_Float64)
+               : (bComplex ? GDT_CInt32 : GDT_Int32);
+    const int nValsPerIter = bComplex ? 2 : 1;
 
-    if (eDataType == GDT_Float32 || eDataType == GDT_Float64 ||
-        eDataType == GDT_CFloat32 || eDataType == GDT_CFloat64)
-    {
-        const GDALDataType eDstDataType = bComplex ? GDT_CFloat64 : GDT_Float64;
-
-        double *padfLineData = static_cast<double *>(VSI_MALLOC2_VERBOSE(
-            nXSize, GDALGetDataTypeSizeBytes(eDstDataType)));
-        if (padfLineData == nullptr)
-        {
-            return -1;
-        }
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hBand, &nBlockXSize, &nBlockYSize);
+    int nChunkXSize = 0;
+    int nChunkYSize = 0;
+    const auto aoChunks = GDALChecksumGetChunks(
+        nXSize, nYSize, nBlockXSize, nBlockYSize,
+        GDALGetDataTypeSizeBytes(eDstDataType), nChunkXSize, nChunkYSize);
 
-        for (int iLine = nYOff; iLine < nYOff + nYSize; iLine++)
+    // The checksum is the sum, modulo 2^16, of the values modulo a prime
+    // number that cycles with the index of the value in the window. It
+    // can thus be computed independently on each chunk. The sum is
+    // accumulated as unsigned to avoid signed overflow on very wide chunks,
+    // which gives the same result modulo 2^16.
+    std::vector<int> anChunkChecksums(aoChunks.size());
+    const auto ProcessChunk =
+        [&](size_t iChunk, const GDALChecksumChunk &oChunk, void *pData)
+    {
+        GUInt32 nChecksum = 0;
+        const size_t xIters = static_cast<size_t>(nValsPerIter) * oChunk.nXSize;
+        for (int iY = 0; iY < oChunk.nYSize; ++iY)
         {
-            if (GDALRasterIO(hBand, GF_Read, nXOff, iLine, nXSize, 1,
-                             padfLineData, nXSize, 1, eDstDataType, 0,
-                             0) != CE_None)
-            {
-                CPLError(CE_Failure, CPLE_FileIO,
-                         "Checksum value couldn't be computed due to "
-                         "I/O read error.");
-                nChecksum = -1;
-                break;
-            }
-            const size_t nCount = bComplex ? static_cast<size_t>(nXSize) * 2
-                                           : static_cast<size_t>(nXSize);
-
-            for (size_t i = 0; i < nCount; i++)
+            // Initialize iPrime so that it is consistent with a
+            // per full line iteration strategy
+            int iPrime = static_cast<int>(
+                (nValsPerIter *
+                 (static_cast<int64_t>(oChunk.nYOff + iY) * nXSize +
+                  oChunk.nXOff)) %
+                11);
+            const size_t nOffset = static_cast<size_t>(iY) * xIters;
+            if (bFloat)
             {
-                double dfVal = padfLineData[i];
-                int nVal;
-                if (CPLIsNan(dfVal) || CPLIsInf(dfVal))
+                const double *padfLineData =
+                    static_cast<const double *>(pData) + nOffset;
+                for (size_t i = 0; i < xIters; i++)
                 {
-                    // Most compilers seem to cast NaN or Inf to 0x80000000.
-                    // but VC7 is an exception. So we force the result
-                    // of such a cast.
-                    nVal = 0x80000000;
-                }
-                else
-                {
-                    // Standard behavior of GDALCopyWords when converting
-                    // from floating point to Int32.
-                    dfVal += 0.5;
-
-                    if (dfVal < -2147483647.0)
-                        nVal = -2147483647;
-                    else if (dfVal > 2147483647)
-                        nVal = 2147483647;
+                    double dfVal = padfLineData[i];
+                    int nVal;
+                    if (CPLIsNan(dfVal) || CPLIsInf(dfVal))
+                    {
+                        // Most compilers seem to cast NaN or Inf to
+                        // 0x80000000. but VC7 is an exception. So we force
+                        // the result of such a cast.
+                        nVal = 0x80000000;
+                    }
                     else
-                        nVal = static_cast<GInt32>(floor(dfVal));
-                }
-
-                nChecksum += nVal % anPrimes[iPrime++];
-                if (iPrime > 10)
-                    iPrime = 0;
+                    {
+                        // Standard behavior of GDALCopyWords when converting
+                        // from floating point to Int32.
+                        dfVal += 0.5;
 
-                nChecksum &= 0xffff;
-            }
-        }
+                        if (dfVal < -2147483647.0)
+                            nVal = -2147483647;
+                        else if (dfVal > 2147483647)
+                            nVal = 2147483647;
+                        else
+                            nVal = static_cast<GInt32>(floor(dfVal));
+                    }
 
-        CPLFree(padfLineData);
-    }
-    else if (nXOff == 0 && nYOff == 0)
-    {
-        const GDALDataType eDstDataType = bComplex ? GDT_CInt32 : GDT_Int32;
-        int nBlockXSize = 0;
-        int nBlockYSize = 0;
-        GDALGetBlockSize(hBand, &nBlockXSize, &nBlockYSize);
-        const int nDstDataTypeSize = GDALGetDataTypeSizeBytes(eDstDataType);
-        int nChunkXSize = nBlockXSize;
-        const int nChunkYSize = nBlockYSize;
-        if (nBlockXSize < nXSize)
-        {
-            const GIntBig nMaxChunkSize =
-                std::max(static_cast<GIntBig>(10 * 1000 * 1000),
-                         GDALGetCacheMax64() / 10);
-            if (nDstDataTypeSize > 0 &&
-                static_cast<GIntBig>(nXSize) * nChunkYSize <
-                    nMaxChunkSize / nDstDataTypeSize)
-            {
-                // A full line of height nChunkYSize can fit in the maximum
-                // allowed memory
-                nChunkXSize = nXSize;
+                    nChecksum +=
+                        static_cast<GUInt32>(nVal % anPrimes[iPrime++]);
+                    if (iPrime > 10)
+                        iPrime = 0;
+                }
             }
             else
             {
-                // Otherwise compute a size that is a multiple of nBlockXSize
-                nChunkXSize = static_cast<int>(std::min(
-                    static_cast<GIntBig>(nXSize),
-                    nBlockXSize *
-                        std::max(static_cast<GIntBig>(1),
-                                 nMaxChunkSize /
-                                     (static_cast<GIntBig>(nBlockXSize) *
-                                      nChunkYSize * nDstDataTypeSize))));
-            }
-        }
-
-        int *panChunkData = static_cast<GInt32 *>(
-            VSI_MALLOC3_VERBOSE(nChunkXSize, nChunkYSize, nDstDataTypeSize));
-        if (panChunkData == nullptr)
-        {
-            return -1;
-        }
-        const int nValsPerIter = bComplex ? 2 : 1;
-
-        const int nYBlocks = DIV_ROUND_UP(nYSize, nChunkYSize);
-        const int nXBlocks = DIV_ROUND_UP(nXSize, nChunkXSize);
-        for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
-        {
-            const int iYStart = iYBlock * nChunkYSize;
-            const int iYEnd =
-                iYBlock == nYBlocks - 1 ? nYSize : iYStart + nChunkYSize;
-            const int nChunkActualHeight = iYEnd - iYStart;
-            for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
-            {
-                const int iXStart = iXBlock * nChunkXSize;
-                const int iXEnd =
-                    iXBlock == nXBlocks - 1 ? nXSize : iXStart + nChunkXSize;
-                const int nChunkActualXSize = iXEnd - iXStart;
-                if (GDALRasterIO(
-                        hBand, GF_Read, iXStart, iYStart, nChunkActualXSize,
-                        nChunkActualHeight, panChunkData, nChunkActualXSize,
-                        nChunkActualHeight, eDstDataType, 0, 0) != CE_None)
+                const int *panLineData =
+                    static_cast<const int *>(pData) + nOffset;
+                for (size_t i = 0; i < xIters; ++i)
                 {
-                    CPLError(CE_Failure, CPLE_FileIO,
-                             "Checksum value could not be computed due to I/O "
-                             "read error.");
-                    nChecksum = -1;
-                    iYBlock = nYBlocks;
-                    break;
-                }
-                const size_t xIters =
-                    static_cast<size_t>(nValsPerIter) * nChunkActualXSize;
-                for (int iY = iYStart; iY < iYEnd; ++iY)
-                {
-                    // Initialize iPrime so that it is consistent with a
-                    // per full line iteration strategy
-                    iPrime = (nValsPerIter *
-                              (static_cast<int64_t>(iY) * nXSize + iXStart)) %
-                             11;
-                    const size_t nOffset = nValsPerIter *
-                                           static_cast<size_t>(iY - iYStart) *
-                                           nChunkActualXSize;
-                    for (size_t i = 0; i < xIters; ++i)
-                    {
-                        nChecksum +=
-                            panChunkData[nOffset + i] % anPrimes[iPrime++];
-                        if (iPrime > 10)
-                            iPrime = 0;
-                    }
-                    nChecksum &= 0xffff;
+                    nChecksum += static_cast<GUInt32>(panLineData[i] %
+                                                      anPrimes[iPrime++]);
+                    if (iPrime > 10)
+                        iPrime = 0;
                 }
             }
+            nChecksum &= 0xffff;
         }
+        anChunkChecksums[iChunk] = static_cast<int>(nChecksum & 0xffff);
+    };
 
-        CPLFree(panChunkData);
+    if (!GDALChecksumProcessChunks(hBand, nXOff, nYOff, aoChunks, nChunkXSize,
+                                   nChunkYSize, eDstDataType, ProcessChunk))
+    {
+        return -1;
     }
-    else
+
+    int nChecksum = 0;
+    for (const int nChunkChecksum : anChunkChecksums)
+        nChecksum = (nChecksum + nChunkChecksum) & 0xffff;
+
+    return nChecksum;
+}
+
+/************************************************************************/
+/*                        GDALComputeImageHash()                        */
+/************************************************************************/
+
+/**
+ * Compute a strong hash of an image region.
+ *
+ * Contrary to GDALChecksumImage(), which is a weak 16 bit checksum of the
+ * values converted to integers, this computes a SHA-256 based hash of the
+ * exact raw values, in the native data type of the band.
+ *
+ * The region is divided in tiles of GDAL_IMAGE_HASH_TILE_SIZE x
+ * GDAL_IMAGE_HASH_TILE_SIZE pixels (smaller on the right and bottom edges),
+ * and hashed as a Merkle tree: each tile is hashed separately, the hashes of
+ * the tiles of each row of tiles are hashed together, and the final hash is
+ * computed from the dimensions and data type of the region and the hashes of
+ * the rows of tiles. The per-tile hashes can be retrieved to locate which
+ * part of an image differs from a reference.
+ *
+ * The hash only depends on the values, the dimensions of the region and the
+ * data type. It does not depend on the storage format, its block layout or
+ * the byte order of the host. Note that values are compared at the binary
+ * level, so for example NaN values with different payloads lead to different
+ * hashes.
+ *
+ * As GDALChecksumImage(), the region is read per chunk from several threads
+ * when the GDAL_NUM_THREADS configuration option is set and the dataset can
+ * be re-opened in read-only mode.
+ *
+ * @param hBand the raster band to read from.
+ * @param nXOff pixel offset of window to read.
+ * @param nYOff line offset of window to read.
+ * @param nXSize pixel size of window to read.
+ * @param nYSize line size of window to read.
+ * @param pabyHash Array of GDAL_IMAGE_HASH_SIZE bytes, in which the hash of
+ *                 the region is written.
+ * @param ppabyTileHashes Pointer to an array that will be allocated with
+ *                        *pnTilesX * *pnTilesY * GDAL_IMAGE_HASH_SIZE bytes,
+ *                        and filled with the hash of each tile, in row major
+ *                        order. To be freed with VSIFree(). May be NULL.
+ * @param pnTilesX Pointer to the number of tiles horizontally. May be NULL.
+ * @param pnTilesY Pointer to the number of tiles vertically. May be NULL.
+ *
+ * @return CE_None in case of success, or CE_Failure in case of error.
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALComputeImageHash(GDALRasterBandH hBand, int nXOff, int nYOff,
+                            int nXSize, int nYSize, GByte *pabyHash,
+                            GByte **ppabyTileHashes, int *pnTilesX,
+                            int *pnTilesY)
+{
+    VALIDATE_POINTER1(hBand, "GDALComputeImageHash", CE_Failure);
+    VALIDATE_POINTER1(pabyHash, "GDALComputeImageHash", CE_Failure);
+
+    if (ppabyTileHashes)
+        *ppabyTileHashes = nullptr;
+    if (nXSize < 0 || nYSize < 0)
     {
-        const GDALDataType eDstDataType = bComplex ? GDT_CInt32 : GDT_Int32;
+        CPLError(CE_Failure, CPLE_IllegalArg, "Invalid window size");
+        return CE_Failure;
+    }
 
-        int *panLineData = static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(
-            nXSize, GDALGetDataTypeSizeBytes(eDstDataType)));
-        if (panLineData == nullptr)
-        {
-            return -1;
-        }
+    static_assert(GDAL_IMAGE_HASH_SIZE == CPL_SHA256_HASH_SIZE,
+                  "GDAL_IMAGE_HASH_SIZE == CPL_SHA256_HASH_SIZE");
+    constexpr int TILE_SIZE = GDAL_IMAGE_HASH_TILE_SIZE;
+
+    const GDALDataType eDataType = GDALGetRasterDataType(hBand);
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const bool bComplex = CPL_TO_BOOL(GDALDataTypeIsComplex(eDataType));
+    const int nTilesX = DIV_ROUND_UP(nXSize, TILE_SIZE);
+    const int nTilesY = DIV_ROUND_UP(nYSize, TILE_SIZE);
 
-        for (int iLine = nYOff; iLine < nYOff + nYSize; iLine++)
+    int nChunkXSize = 0;
+    int nChunkYSize = 0;
+    const auto aoChunks =
+        GDALChecksumGetChunks(nXSize, nYSize, TILE_SIZE, TILE_SIZE, nDTSize,
+                              nChunkXSize, nChunkYSize);
+
+    std::vector<GByte> abyTileHashes;
+    try
+    {
+        abyTileHashes.resize(static_cast<size_t>(nTilesX) * nTilesY *
+                             GDAL_IMAGE_HASH_SIZE);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        return CE_Failure;
+    }
+
+    // Chunks are made of whole tiles, except on the right and bottom edges
+    const auto ProcessChunk =
+        [&](size_t, const GDALChecksumChunk &oChunk, void *pData)
+    {
+#ifdef CPL_MSB
+        // Hash little-endian values, whatever the host
+        GDALSwapWordsEx(pData, bComplex ? nDTSize / 2 : nDTSize,
+                        static_cast<size_t>(oChunk.nXSize) * oChunk.nYSize *
+                            (bComplex ? 2 : 1),
+                        bComplex ? nDTSize / 2 : nDTSize);
+#else
+        CPL_IGNORE_RET_VAL(bComplex);
+#endif
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+        const size_t nLineSize = static_cast<size_t>(oChunk.nXSize) * nDTSize;
+        for (int iTileX = 0; iTileX * TILE_SIZE < oChunk.nXSize; ++iTileX)
         {
-            if (GDALRasterIO(hBand, GF_Read, nXOff, iLine, nXSize, 1,
-                             panLineData, nXSize, 1, eDstDataType, 0,
-                             0) != CE_None)
+            const int nTileXOff = iTileX * TILE_SIZE;
+            const int nTileXSize =
+                std::min(TILE_SIZE, oChunk.nXSize - nTileXOff);
+            CPL_SHA256Context sCtxt;
+            CPL_SHA256Init(&sCtxt);
+            for (int iY = 0; iY < oChunk.nYSize; ++iY)
             {
-                CPLError(CE_Failure, CPLE_FileIO,
-                         "Checksum value could not be computed due to I/O "
-                         "read error.");
-                nChecksum = -1;
-                break;
+                CPL_SHA256Update(&sCtxt,
+                                 pabyData + iY * nLineSize +
+                                     static_cast<size_t>(nTileXOff) * nDTSize,
+                                 static_cast<size_t>(nTileXSize) * nDTSize);
             }
-            const size_t nCount = bComplex ? static_cast<size_t>(nXSize) * 2
-                                           : static_cast<size_t>(nXSize);
+            const size_t iTile =
+                static_cast<size_t>(oChunk.nYOff / TILE_SIZE) * nTilesX +
+                (oChunk.nXOff + nTileXOff) / TILE_SIZE;
+            CPL_SHA256Final(&sCtxt, abyTileHashes.data() +
+                                        iTile * GDAL_IMAGE_HASH_SIZE);
+        }
+    };
 
-            for (size_t i = 0; i < nCount; i++)
-            {
-                nChecksum += panLineData[i] % anPrimes[iPrime++];
-                if (iPrime > 10)
-                    iPrime = 0;
+    if (!GDALChecksumProcessChunks(hBand, nXOff, nYOff, aoChunks, nChunkXSize,
+                                   nChunkYSize, eDataType, ProcessChunk))
+    {
+        return CE_Failure;
+    }
 
-                nChecksum &= 0xffff;
-            }
-        }
+    CPL_SHA256Context sCtxt;
+    CPL_SHA256Init(&sCtxt);
+    constexpr char szSignature[] = "GDAL_IMAGE_HASH_V1";
+    CPL_SHA256Update(&sCtxt, szSignature, strlen(szSignature));
+    for (const GUInt32 nVal : {static_cast<GUInt32>(nXSize),
+                               static_cast<GUInt32>(nYSize),
+                               static_cast<GUInt32>(TILE_SIZE)})
+    {
+        const GByte abyVal[] = {
+            static_cast<GByte>(nVal & 0xff),
+            static_cast<GByte>((nVal >> 8) & 0xff),
+            static_cast<GByte>((nVal >> 16) & 0xff),
+            static_cast<GByte>((nVal >> 24) & 0xff)};
+        CPL_SHA256Update(&sCtxt, abyVal, sizeof(abyVal));
+    }
+    const char *pszDTName = GDALGetDataTypeName(eDataType);
+    CPL_SHA256Update(&sCtxt, pszDTName, strlen(pszDTName));
+    for (int iTileY = 0; iTileY < nTilesY; ++iTileY)
+    {
+        GByte abyRowHash[CPL_SHA256_HASH_SIZE];
+        CPL_SHA256(abyTileHashes.data() + static_cast<size_t>(iTileY) *
+                                              nTilesX * GDAL_IMAGE_HASH_SIZE,
+                   static_cast<size_t>(nTilesX) * GDAL_IMAGE_HASH_SIZE,
+                   abyRowHash);
+        CPL_SHA256Update(&sCtxt, abyRowHash, sizeof(abyRowHash));
+    }
+    CPL_SHA256Final(&sCtxt, pabyHash);
 
-        CPLFree(panLineData);
+    if (ppabyTileHashes)
+    {
+        *ppabyTileHashes =
+            static_cast<GByte *>(VSI_MALLOC_VERBOSE(abyTileHashes.size()));
+        if (*ppabyTileHashes == nullptr && !abyTileHashes.empty())
+            return CE_Failure;
+        if (!abyTileHashes.empty())
+            memcpy(*ppabyTileHashes, abyTileHashes.data(),
+                   abyTileHashes.size());
     }
+    if (pnTilesX)
+        *pnTilesX = nTilesX;
+    if (pnTilesY)
+        *pnTilesY = nTilesY;
 
-    return nChecksum;
+    return CE_None;
 }
@@ -42,7 +42,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -50,8 +52,10 @@
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "memdataset.h"
 
 constexpr float INVALID_BMXY = -10.0f;
@@ -671,7 +675,7 @@ int GDALGeoLoc<Accessors>::Transform(void *pTransformArg, int bDstToSrc,
         const bool bGeolocMaxAccuracy = CPLTestBool(
             CPLGetConfigOption("GDAL_GEOLOC_USE_MAX_ACCURACY", "YES"));
 
-        // Keep those objects in this outer scope, so they are re-used, to
+        // Keep those objects in this scope, so they are re-used, to
         // save memory allocations.
         OGRPoint oPoint;
         OGRLinearRing oRing;
@@ -1007,6 +1011,46 @@ void GDALInverseBilinearInterpolation(const double x, const double y,
     j += s;
 }
 
+/************************************************************************/
+/*                     GDALGeoLocRunPerLineChunk()                      */
+/************************************************************************/
+
+// Split [0, nLines[ into chunks of consecutive lines, run fn(iYStart, iYEnd)
+// on each of them from the job queue, and wait for completion.
+static void
+GDALGeoLocRunPerLineChunk(CPLJobQueue *poJobQueue, int nThreads, int nLines,
+                          const std::function<void(int, int)> &fn)
+{
+    struct JobStruct
+    {
+        const std::function<void(int, int)> *pfn;
+        int iYStart;
+        int iYEnd;
+    };
+    // A few chunks per thread for load balancing.
+    const int nChunks = std::max(1, std::min(nLines, nThreads * 4));
+    std::vector<JobStruct> asJobs;
+    for (int i = 0; i < nChunks; ++i)
+    {
+        const int iYStart =
+            static_cast<int>(static_cast<GIntBig>(nLines) * i / nChunks);
+        const int iYEnd =
+            static_cast<int>(static_cast<GIntBig>(nLines) * (i + 1) / nChunks);
+        asJobs.push_back(JobStruct{&fn, iYStart, iYEnd});
+    }
+    for (auto &job : asJobs)
+    {
+        poJobQueue->SubmitJob(
+            [](void *pData)
+            {
+                auto psJob = static_cast<JobStruct *>(pData);
+                (*(psJob->pfn))(psJob->iYStart, psJob->iYEnd);
+            },
+            &job);
+    }
+    poJobQueue->WaitCompletion();
+}
+
 /************************************************************************/
 /*                       GeoLocGenerateBackMap()                        */
 /************************************************************************/
@@ -1152,12 +1196,6 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         }
     };
 
-    // Keep those objects in this outer scope, so they are re-used, to
-    // save memory allocations.
-    OGRPoint oPoint;
-    OGRLinearRing oRing;
-    oRing.setNumPoints(5);
-
     /* -------------------------------------------------------------------- */
     /*      Run through the whole geoloc array forward projecting and       */
     /*      pushing into the backmap.                                       */
@@ -1215,228 +1253,367 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         xStartEnd[iXBlock].second = dfX + dfStep / 10;
     }
 
-    for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+    // Materialize the sampled pixel positions of each block, so that the
+    // work units processed by different threads visit exactly the same
+    // positions as a sequential scan would.
+    const auto GetSamplePositions =
+        [dfStep](const std::pair<double, double> &startEnd)
     {
-        for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+        std::vector<double> adfPos;
+        for (double dfPos = startEnd.first; dfPos < startEnd.second;
+             dfPos += dfStep)
         {
-#if 0
-        CPLDebug("Process geoloc block (y=%d,x=%d) for y in [%f, %f] and x in [%f, %f]",
-                 iYBlock, iXBlock,
-                 yStartEnd[iYBlock].first, yStartEnd[iYBlock].second,
-                 xStartEnd[iXBlock].first, xStartEnd[iXBlock].second);
-#endif
-            for (double dfY = yStartEnd[iYBlock].first;
-                 dfY < yStartEnd[iYBlock].second; dfY += dfStep)
-            {
-                for (double dfX = xStartEnd[iXBlock].first;
-                     dfX < xStartEnd[iXBlock].second; dfX += dfStep)
-                {
-                    // Use forward geolocation array interpolation to compute
-                    // the georeferenced position corresponding to (dfX, dfY)
-                    double dfGeoLocX;
-                    double dfGeoLocY;
-                    if (!PixelLineToXY(psTransform, dfX, dfY, dfGeoLocX,
-                                       dfGeoLocY))
-                        continue;
+            adfPos.push_back(dfPos);
+        }
+        return adfPos;
+    };
+    std::vector<std::vector<double>> aadfXPerBlock;
+    for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+        aadfXPerBlock.emplace_back(GetSamplePositions(xStartEnd[iXBlock]));
+
+    // The forward projection of the geolocation array and the search of
+    // the geolocation cell containing each backmap node only read the
+    // geolocation arrays. They are done in parallel, on work units made of
+    // a few sampled lines of a block, and produce one GDALGeoLocBackMapSample
+    // per position. Those samples are then merged into the backmap by the
+    // calling thread, in the order of a sequential scan, so that the result
+    // does not depend on the number of threads.
+    const int nThreads =
+        Accessors::SUPPORTS_CONCURRENT_ACCESS
+            ? GDALGetNumThreads(nullptr, nullptr, /* nMaxThreads = */ 128)
+            : 1;
+    auto poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+
+    struct GDALGeoLocBackMapSample
+    {
+        double dfX;  // pixel position in geolocation array
+        double dfY;  // line position in geolocation array
+        double dBMX;  // pixel position in backmap
+        double dBMY;  // line position in backmap
+        float fBMXValue;  // value to set if bExactMatch
+        float fBMYValue;  // value to set if bExactMatch
+        bool bExactMatch;
+    };
 
-                    // Compute the floating point coordinates in the pixel space
-                    // of the backmap
-                    const double dBMX = static_cast<double>(
-                        (dfGeoLocX - dfMinX) / dfPixelXSize);
+    struct BackMapWorkUnit
+    {
+        const std::vector<double> *padfX = nullptr;
+        const double *padfY = nullptr;
+        size_t nYCount = 0;
+        std::vector<GDALGeoLocBackMapSample> aoSamples{};
+    };
 
-                    const double dBMY = static_cast<double>(
-                        (dfMaxY - dfGeoLocY) / dfPixelYSize);
+    const auto ComputeSamples = [&](BackMapWorkUnit &unit)
+    {
+        // Keep those objects in this scope, so they are re-used, to
+        // save memory allocations.
+        OGRPoint oPoint;
+        OGRLinearRing oRing;
+        oRing.setNumPoints(5);
 
-                    // Get top left index by truncation
-                    const int iBMX = static_cast<int>(std::floor(dBMX));
-                    const int iBMY = static_cast<int>(std::floor(dBMY));
+        unit.aoSamples.reserve(unit.nYCount * unit.padfX->size());
+        for (size_t iY = 0; iY < unit.nYCount; ++iY)
+        {
+            const double dfY = unit.padfY[iY];
+            for (const double dfX : *(unit.padfX))
+            {
+                // Use forward geolocation array interpolation to compute
+                // the georeferenced position corresponding to (dfX, dfY)
+                double dfGeoLocX;
+                double dfGeoLocY;
+                if (!PixelLineToXY(psTransform, dfX, dfY, dfGeoLocX, dfGeoLocY))
+                    continue;
 
-                    if (iBMX >= 0 && iBMX < nBMXSize && iBMY >= 0 &&
-                        iBMY < nBMYSize)
+                // Compute the floating point coordinates in the pixel space
+                // of the backmap
+                const double dBMX =
+                    static_cast<double>((dfGeoLocX - dfMinX) / dfPixelXSize);
+
+                const double dBMY =
+                    static_cast<double>((dfMaxY - dfGeoLocY) / dfPixelYSize);
+
+                // Get top left index by truncation
+                const int iBMX = static_cast<int>(std::floor(dBMX));
+                const int iBMY = static_cast<int>(std::floor(dBMY));
+
+                GDALGeoLocBackMapSample sample;
+                sample.dfX = dfX;
+                sample.dfY = dfY;
+                sample.dBMX = dBMX;
+                sample.dBMY = dBMY;
+                sample.fBMXValue = 0;
+                sample.fBMYValue = 0;
+                sample.bExactMatch = false;
+
+                if (iBMX >= 0 && iBMX < nBMXSize && iBMY >= 0 &&
+                    iBMY < nBMYSize)
+                {
+                    // Compute the georeferenced position of the top-left
+                    // index of the backmap
+                    double dfGeoX = dfMinX + iBMX * dfPixelXSize;
+                    const double dfGeoY = dfMaxY - iBMY * dfPixelYSize;
+
+                    const int nOuterIters =
+                        psTransform->bGeographicSRSWithMinus180Plus180LongRange &&
+                                fabs(dfGeoX) >= 180
+                            ? 2
+                            : 1;
+
+                    for (int iOuterIter = 0; iOuterIter < nOuterIters;
+                         ++iOuterIter)
                     {
-                        // Compute the georeferenced position of the top-left
-                        // index of the backmap
-                        double dfGeoX = dfMinX + iBMX * dfPixelXSize;
-                        const double dfGeoY = dfMaxY - iBMY * dfPixelYSize;
-
-                        bool bMatchingGeoLocCellFound = false;
-
-                        const int nOuterIters =
-                            psTransform->bGeographicSRSWithMinus180Plus180LongRange &&
-                                    fabs(dfGeoX) >= 180
-                                ? 2
-                                : 1;
-
-                        for (int iOuterIter = 0; iOuterIter < nOuterIters;
-                             ++iOuterIter)
+                        if (iOuterIter == 1 && dfGeoX >= 180)
+                            dfGeoX -= 360;
+                        else if (iOuterIter == 1 && dfGeoX <= -180)
+                            dfGeoX += 360;
+
+                        // Identify a cell (quadrilateral in georeferenced
+                        // space) in the geolocation array in which dfGeoX,
+                        // dfGeoY falls into.
+                        oPoint.setX(dfGeoX);
+                        oPoint.setY(dfGeoY);
+                        const int nX = static_cast<int>(std::floor(dfX));
+                        const int nY = static_cast<int>(std::floor(dfY));
+                        for (int sx = -1; !sample.bExactMatch && sx <= 0; sx++)
                         {
-                            if (iOuterIter == 1 && dfGeoX >= 180)
-                                dfGeoX -= 360;
-                            else if (iOuterIter == 1 && dfGeoX <= -180)
-                                dfGeoX += 360;
-
-                            // Identify a cell (quadrilateral in georeferenced
-                            // space) in the geolocation array in which dfGeoX,
-                            // dfGeoY falls into.
-                            oPoint.setX(dfGeoX);
-                            oPoint.setY(dfGeoY);
-                            const int nX = static_cast<int>(std::floor(dfX));
-                            const int nY = static_cast<int>(std::floor(dfY));
-                            for (int sx = -1;
-                                 !bMatchingGeoLocCellFound && sx <= 0; sx++)
+                            for (int sy = -1; !sample.bExactMatch && sy <= 0;
+                                 sy++)
                             {
-                                for (int sy = -1;
-                                     !bMatchingGeoLocCellFound && sy <= 0; sy++)
+                                const int pixel = nX + sx;
+                                const int line = nY + sy;
+                                double x0, y0, x1, y1, x2, y2, x3, y3;
+                                if (!PixelLineToXY(psTransform, pixel, line, x0,
+                                                   y0) ||
+                                    !PixelLineToXY(psTransform, pixel + 1, line,
+                                                   x2, y2) ||
+                                    !PixelLineToXY(psTransform, pixel, line + 1,
+                                                   x1, y1) ||
+                                    !PixelLineToXY(psTransform, pixel + 1,
+                                                   line + 1, x3, y3))
                                 {
-                                    const int pixel = nX + sx;
-                                    const int line = nY + sy;
-                                    double x0, y0, x1, y1, x2, y2, x3, y3;
-                                    if (!PixelLineToXY(psTransform, pixel, line,
-                                                       x0, y0) ||
-                                        !PixelLineToXY(psTransform, pixel + 1,
-                                                       line, x2, y2) ||
-                                        !PixelLineToXY(psTransform, pixel,
-                                                       line + 1, x1, y1) ||
-                                        !PixelLineToXY(psTransform, pixel + 1,
-                                                       line + 1, x3, y3))
-                                    {
-                                        break;
-                                    }
+                                    break;
+                                }
 
-                                    int nIters = 1;
-                                    if (psTransform
-                                            ->bGeographicSRSWithMinus180Plus180LongRange &&
-                                        std::fabs(x0) > 170 &&
-                                        std::fabs(x1) > 170 &&
-                                        std::fabs(x2) > 170 &&
-                                        std::fabs(x3) > 170 &&
-                                        (std::fabs(x1 - x0) > 180 ||
-                                         std::fabs(x2 - x0) > 180 ||
-                                         std::fabs(x3 - x0) > 180))
+                                int nIters = 1;
+                                if (psTransform
+                                        ->bGeographicSRSWithMinus180Plus180LongRange &&
+                                    std::fabs(x0) > 170 &&
+                                    std::fabs(x1) > 170 &&
+                                    std::fabs(x2) > 170 &&
+                                    std::fabs(x3) > 170 &&
+                                    (std::fabs(x1 - x0) > 180 ||
+                                     std::fabs(x2 - x0) > 180 ||
+                                     std::fabs(x3 - x0) > 180))
+                                {
+                                    nIters = 2;
+                                    if (x0 > 0)
+                                        x0 -= 360;
+                                    if (x1 > 0)
+                                        x1 -= 360;
+                                    if (x2 > 0)
+                                        x2 -= 360;
+                                    if (x3 > 0)
+                                        x3 -= 360;
+                                }
+                                for (int iIter = 0; iIter < nIters; ++iIter)
+                                {
+                                    if (iIter == 1)
                                     {
-                                        nIters = 2;
-                                        if (x0 > 0)
-                                            x0 -= 360;
-                                        if (x1 > 0)
-                                            x1 -= 360;
-                                        if (x2 > 0)
-                                            x2 -= 360;
-                                        if (x3 > 0)
-                                            x3 -= 360;
+                                        x0 += 360;
+                                        x1 += 360;
+                                        x2 += 360;
+                                        x3 += 360;
                                     }
-                                    for (int iIter = 0; iIter < nIters; ++iIter)
+
+                                    oRing.setPoint(0, x0, y0);
+                                    oRing.setPoint(1, x2, y2);
+                                    oRing.setPoint(2, x3, y3);
+                                    oRing.setPoint(3, x1, y1);
+                                    oRing.setPoint(4, x0, y0);
+                                    if (oRing.isPointInRing(&oPoint) ||
+                                        oRing.isPointOnRingBoundary(&oPoint))
                                     {
-                                        if (iIter == 1)
-                                        {
-                                            x0 += 360;
-                                            x1 += 360;
-                                            x2 += 360;
-                                            x3 += 360;
-                                        }
-
-                                        oRing.setPoint(0, x0, y0);
-                                        oRing.setPoint(1, x2, y2);
-                                        oRing.setPoint(2, x3, y3);
-                                        oRing.setPoint(3, x1, y1);
-                                        oRing.setPoint(4, x0, y0);
-                                        if (oRing.isPointInRing(&oPoint) ||
-                                            oRing.isPointOnRingBoundary(
-                                                &oPoint))
-                                        {
-                                            bMatchingGeoLocCellFound = true;
-                                            double dfBMXValue = pixel;
-                                            double dfBMYValue = line;
-                                            GDALInverseBilinearInterpolation(
-                                                dfGeoX, dfGeoY, x0, y0, x1, y1,
-                                                x2, y2, x3, y3, dfBMXValue,
-                                                dfBMYValue);
-
-                                            dfBMXValue =
-                                                (dfBMXValue +
-                                                 dfGeorefConventionOffset) *
-                                                    psTransform->dfPIXEL_STEP +
-                                                psTransform->dfPIXEL_OFFSET;
-                                            dfBMYValue =
-                                                (dfBMYValue +
-                                                 dfGeorefConventionOffset) *
-                                                    psTransform->dfLINE_STEP +
-                                                psTransform->dfLINE_OFFSET;
-
-                                            pAccessors->backMapXAccessor.Set(
-                                                iBMX, iBMY,
-                                                static_cast<float>(dfBMXValue));
-                                            pAccessors->backMapYAccessor.Set(
-                                                iBMX, iBMY,
-                                                static_cast<float>(dfBMYValue));
-                                            pAccessors->backMapWeightAccessor
-                                                .Set(iBMX, iBMY, 1.0f);
-                                        }
+                                        sample.bExactMatch = true;
+                                        double dfBMXValue = pixel;
+                                        double dfBMYValue = line;
+                                        GDALInverseBilinearInterpolation(
+                                            dfGeoX, dfGeoY, x0, y0, x1, y1, x2,
+                                            y2, x3, y3, dfBMXValue, dfBMYValue);
+
+                                        dfBMXValue =
+                                            (dfBMXValue +
+                                             dfGeorefConventionOffset) *
+                                                psTransform->dfPIXEL_STEP +
+                                            psTransform->dfPIXEL_OFFSET;
+                                        dfBMYValue =
+                                            (dfBMYValue +
+                                             dfGeorefConventionOffset) *
+                                                psTransform->dfLINE_STEP +
+                                            psTransform->dfLINE_OFFSET;
+
+                                        sample.fBMXValue =
+                                            static_cast<float>(dfBMXValue);
+                                        sample.fBMYValue =
+                                            static_cast<float>(dfBMYValue);
                                     }
                                 }
                             }
                         }
-                        if (bMatchingGeoLocCellFound)
-                            continue;
                     }
+                }
+                else if (iBMX < -1 || iBMY < -1 || iBMX > nBMXSize ||
+                         iBMY > nBMYSize)
+                {
+                    // Out of range: would not contribute to the backmap
+                    continue;
+                }
 
-                    // We will end up here in non-nominal cases, with nodata,
-                    // holes, etc.
+                unit.aoSamples.push_back(sample);
+            }
+        }
+    };
 
-                    // Check if the center is in range
-                    if (iBMX < -1 || iBMY < -1 || iBMX > nBMXSize ||
-                        iBMY > nBMYSize)
-                        continue;
+    const auto MergeSamples = [&](const BackMapWorkUnit &unit)
+    {
+        for (const auto &sample : unit.aoSamples)
+        {
+            const int iBMX = static_cast<int>(std::floor(sample.dBMX));
+            const int iBMY = static_cast<int>(std::floor(sample.dBMY));
 
-                    const double fracBMX = dBMX - iBMX;
-                    const double fracBMY = dBMY - iBMY;
+            if (sample.bExactMatch)
+            {
+                pAccessors->backMapXAccessor.Set(iBMX, iBMY, sample.fBMXValue);
+                pAccessors->backMapYAccessor.Set(iBMX, iBMY, sample.fBMYValue);
+                pAccessors->backMapWeightAccessor.Set(iBMX, iBMY, 1.0f);
+                continue;
+            }
 
-                    // Check logic for top left pixel
-                    if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) &&
-                        (iBMY < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX, iBMY) !=
-                            1.0f)
-                    {
-                        const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
-                        UpdateBackmap(iBMX, iBMY, dfX, dfY, tempwt);
-                    }
+            // We will end up here in non-nominal cases, with nodata,
+            // holes, etc.
 
-                    // Check logic for top right pixel
-                    if ((iBMY >= 0) && (iBMX + 1 < nBMXSize) &&
-                        (iBMY < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY) !=
-                            1.0f)
-                    {
-                        const double tempwt = fracBMX * (1.0 - fracBMY);
-                        UpdateBackmap(iBMX + 1, iBMY, dfX, dfY, tempwt);
-                    }
+            const double dfX = sample.dfX;
+            const double dfY = sample.dfY;
+            const double fracBMX = sample.dBMX - iBMX;
+            const double fracBMY = sample.dBMY - iBMY;
 
-                    // Check logic for bottom right pixel
-                    if ((iBMX + 1 < nBMXSize) && (iBMY + 1 < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX + 1,
-                                                              iBMY + 1) != 1.0f)
-                    {
-                        const double tempwt = fracBMX * fracBMY;
-                        UpdateBackmap(iBMX + 1, iBMY + 1, dfX, dfY, tempwt);
-                    }
+            // Check logic for top left pixel
+            if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) &&
+                (iBMY < nBMYSize) &&
+                pAccessors->backMapWeightAccessor.Get(iBMX, iBMY) != 1.0f)
+            {
+                const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
+                UpdateBackmap(iBMX, iBMY, dfX, dfY, tempwt);
+            }
 
-                    // Check logic for bottom left pixel
-                    if ((iBMX >= 0) && (iBMX < nBMXSize) &&
-                        (iBMY + 1 < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX, iBMY + 1) !=
-                            1.0f)
+            // Check logic for top right pixel
+            if ((iBMY >= 0) && (iBMX + 1 < nBMXSize) && (iBMY < nBMYSize) &&
+                pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY) != 1.0f)
+            {
+                const double tempwt = fracBMX * (1.0 - fracBMY);
+                UpdateBackmap(iBMX + 1, iBMY, dfX, dfY, tempwt);
+            }
+
+            // Check logic for bottom right pixel
+            if ((iBMX + 1 < nBMXSize) && (iBMY + 1 < nBMYSize) &&
+                pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY + 1) !=
+                    1.0f)
+            {
+                const double tempwt = fracBMX * fracBMY;
+                UpdateBackmap(iBMX + 1, iBMY + 1, dfX, dfY, tempwt);
+            }
+
+            // Check logic for bottom left pixel
+            if ((iBMX >= 0) && (iBMX < nBMXSize) && (iBMY + 1 < nBMYSize) &&
+                pAccessors->backMapWeightAccessor.Get(iBMX, iBMY + 1) != 1.0f)
+            {
+                const double tempwt = (1.0 - fracBMX) * fracBMY;
+                UpdateBackmap(iBMX, iBMY + 1, dfX, dfY, tempwt);
+            }
+        }
+    };
+
+    // Bound the number of samples held in memory at once, whatever the
+    // number of threads: work units get smaller as there are more of them
+    // (1M samples take 40 MB).
+    constexpr size_t MAX_PENDING_SAMPLES = 1024 * 1024;
+    const size_t nMaxPendingUnits =
+        poJobQueue ? static_cast<size_t>(nThreads) * 4 : 1;
+    const size_t nSamplesPerWorkUnit = std::max<size_t>(
+        4096, std::min<size_t>(64 * 1024,
+                               MAX_PENDING_SAMPLES / nMaxPendingUnits));
+    std::vector<BackMapWorkUnit> aoPendingUnits;
+
+    const auto ProcessPendingUnits = [&]()
+    {
+        if (poJobQueue)
+        {
+            struct JobStruct
+            {
+                const decltype(ComputeSamples) *pfnCompute;
+                BackMapWorkUnit *pUnit;
+            };
+            std::vector<JobStruct> asJobs;
+            asJobs.reserve(aoPendingUnits.size());
+            for (auto &unit : aoPendingUnits)
+                asJobs.push_back(JobStruct{&ComputeSamples, &unit});
+            for (auto &job : asJobs)
+            {
+                poJobQueue->SubmitJob(
+                    [](void *pData)
                     {
-                        const double tempwt = (1.0 - fracBMX) * fracBMY;
-                        UpdateBackmap(iBMX, iBMY + 1, dfX, dfY, tempwt);
-                    }
-                }
+                        auto psJob = static_cast<JobStruct *>(pData);
+                        (*(psJob->pfnCompute))(*(psJob->pUnit));
+                    },
+                    &job);
             }
+            poJobQueue->WaitCompletion();
         }
+        else
+        {
+            for (auto &unit : aoPendingUnits)
+                ComputeSamples(unit);
+        }
+        for (const auto &unit : aoPendingUnits)
+            MergeSamples(unit);
+        aoPendingUnits.clear();
+    };
+
+    for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+    {
+        const auto adfY = GetSamplePositions(yStartEnd[iYBlock]);
+        for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+        {
+#if 0
+        CPLDebug("Process geoloc block (y=%d,x=%d) for y in [%f, %f] and x in [%f, %f]",
+                 iYBlock, iXBlock,
+                 yStartEnd[iYBlock].first, yStartEnd[iYBlock].second,
+                 xStartEnd[iXBlock].first, xStartEnd[iXBlock].second);
+#endif
+            const auto &adfX = aadfXPerBlock[iXBlock];
+            const size_t nLinesPerUnit = std::max<size_t>(
+                1, nSamplesPerWorkUnit / std::max<size_t>(1, adfX.size()));
+            for (size_t iY = 0; iY < adfY.size(); iY += nLinesPerUnit)
+            {
+                BackMapWorkUnit unit;
+                unit.padfX = &adfX;
+                unit.padfY = adfY.data() + iY;
+                unit.nYCount = std::min(nLinesPerUnit, adfY.size() - iY);
+                aoPendingUnits.emplace_back(std::move(unit));
+                if (aoPendingUnits.size() == nMaxPendingUnits)
+                    ProcessPendingUnits();
+            }
+        }
+        // adfY is about to go out of scope
+        ProcessPendingUnits();
     }
 
     // Each pixel in the backmap may have multiple entries.
     // We now go in average it out using the weights
-    START_ITER_PER_BLOCK(nBMXSize, TILE_SIZE, nBMYSize, TILE_SIZE, (void)0,
-                         iXStart, iXEnd, iYStart, iYEnd)
+    const auto NormalizeBackMap = [&](int iXStart, int iXEnd, int iYStart,
+                                      int iYEnd)
     {
         for (int iY = iYStart; iY < iYEnd; ++iY)
         {
@@ -1463,8 +1640,22 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
                 }
             }
         }
+    };
+    if (poJobQueue)
+    {
+        GDALGeoLocRunPerLineChunk(
+            poJobQueue.get(), nThreads, nBMYSize, [&](int iYStart, int iYEnd)
+            { NormalizeBackMap(0, nBMXSize, iYStart, iYEnd); });
+    }
+    else
+    {
+        START_ITER_PER_BLOCK(nBMXSize, TILE_SIZE, nBMYSize, TILE_SIZE, (void)0,
+                             iXStart, iXEnd, iYStart, iYEnd)
+        {
+            NormalizeBackMap(iXStart, iXEnd, iYStart, iYEnd);
+        }
+        END_ITER_PER_BLOCK
     }
-    END_ITER_PER_BLOCK
 
     pAccessors->FreeWghtsBackMap();
 
@@ -1509,59 +1700,80 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         int iX = -1;
         float bmX = 0;
     };
-    std::vector<LastValidStruct> lastValid(TILE_SIZE);
-    const auto reinitLine = [&lastValid]()
+    const auto FillLineHoles =
+        [&](int iBMY, int iXStart, int iXEnd, LastValidStruct &lastValid)
     {
-        const size_t nSize = lastValid.size();
-        lastValid.clear();
-        lastValid.resize(nSize);
-    };
-    START_ITER_PER_BLOCK(nBMXSize, TILE_SIZE, nBMYSize, TILE_SIZE, reinitLine(),
-                         iXStart, iXEnd, iYStart, iYEnd)
-    {
-        const int iYCount = iYEnd - iYStart;
-        for (int iYIter = 0; iYIter < iYCount; ++iYIter)
+        int iLastValidIX = lastValid.iX;
+        float bmXLastValid = lastValid.bmX;
+        for (int iBMX = iXStart; iBMX < iXEnd; ++iBMX)
         {
-            int iLastValidIX = lastValid[iYIter].iX;
-            float bmXLastValid = lastValid[iYIter].bmX;
-            const int iBMY = iYStart + iYIter;
-            for (int iBMX = iXStart; iBMX < iXEnd; ++iBMX)
+            const float bmX = pAccessors->backMapXAccessor.Get(iBMX, iBMY);
+            if (bmX == INVALID_BMXY)
+                continue;
+            if (iLastValidIX != -1 && iBMX > iLastValidIX + 1 &&
+                fabs(bmX - bmXLastValid) <= 2)
             {
-                const float bmX = pAccessors->backMapXAccessor.Get(iBMX, iBMY);
-                if (bmX == INVALID_BMXY)
-                    continue;
-                if (iLastValidIX != -1 && iBMX > iLastValidIX + 1 &&
-                    fabs(bmX - bmXLastValid) <= 2)
+                const float bmY = pAccessors->backMapYAccessor.Get(iBMX, iBMY);
+                const float bmYLastValid =
+                    pAccessors->backMapYAccessor.Get(iLastValidIX, iBMY);
+                if (fabs(bmY - bmYLastValid) <= 2)
                 {
-                    const float bmY =
-                        pAccessors->backMapYAccessor.Get(iBMX, iBMY);
-                    const float bmYLastValid =
-                        pAccessors->backMapYAccessor.Get(iLastValidIX, iBMY);
-                    if (fabs(bmY - bmYLastValid) <= 2)
+                    for (int iBMXInner = iLastValidIX + 1; iBMXInner < iBMX;
+                         ++iBMXInner)
                     {
-                        for (int iBMXInner = iLastValidIX + 1; iBMXInner < iBMX;
-                             ++iBMXInner)
-                        {
-                            const float alpha =
-                                static_cast<float>(iBMXInner - iLastValidIX) /
-                                (iBMX - iLastValidIX);
-                            pAccessors->backMapXAccessor.Set(
-                                iBMXInner, iBMY,
-                                (1.0f - alpha) * bmXLastValid + alpha * bmX);
-                            pAccessors->backMapYAccessor.Set(
-                                iBMXInner, iBMY,
-                                (1.0f - alpha) * bmYLastValid + alpha * bmY);
-                        }
+                        const float alpha =
+                            static_cast<float>(iBMXInner - iLastValidIX) /
+                            (iBMX - iLastValidIX);
+                        pAccessors->backMapXAccessor.Set(
+                            iBMXInner, iBMY,
+                            (1.0f - alpha) * bmXLastValid + alpha * bmX);
+                        pAccessors->backMapYAccessor.Set(
+                            iBMXInner, iBMY,
+                            (1.0f - alpha) * bmYLastValid + alpha * bmY);
                     }
                 }
-                iLastValidIX = iBMX;
-                bmXLastValid = bmX;
             }
-            lastValid[iYIter].iX = iLastValidIX;
-            lastValid[iYIter].bmX = bmXLastValid;
+            iLastValidIX = iBMX;
+            bmXLastValid = bmX;
         }
+        lastValid.iX = iLastValidIX;
+        lastValid.bmX = bmXLastValid;
+    };
+    if (poJobQueue)
+    {
+        // Lines are independent from each other
+        GDALGeoLocRunPerLineChunk(
+            poJobQueue.get(), nThreads, nBMYSize,
+            [&](int iYStart, int iYEnd)
+            {
+                for (int iBMY = iYStart; iBMY < iYEnd; ++iBMY)
+                {
+                    LastValidStruct lastValid;
+                    FillLineHoles(iBMY, 0, nBMXSize, lastValid);
+                }
+            });
+    }
+    else
+    {
+        std::vector<LastValidStruct> lastValid(TILE_SIZE);
+        const auto reinitLine = [&lastValid]()
+        {
+            const size_t nSize = lastValid.size();
+            lastValid.clear();
+            lastValid.resize(nSize);
+        };
+        START_ITER_PER_BLOCK(nBMXSize, TILE_SIZE, nBMYSize, TILE_SIZE,
+                             reinitLine(), iXStart, iXEnd, iYStart, iYEnd)
+        {
+            const int iYCount = iYEnd - iYStart;
+            for (int iYIter = 0; iYIter < iYCount; ++iYIter)
+            {
+                FillLineHoles(iYStart + iYIter, iXStart, iXEnd,
+                              lastValid[iYIter]);
+            }
+        }
+        END_ITER_PER_BLOCK
     }
-    END_ITER_PER_BLOCK
 
 #ifdef DEBUG_GEOLOC
     if (CPLTestBool(CPLGetConfigOption("GEOLOC_DUMP", "NO")))
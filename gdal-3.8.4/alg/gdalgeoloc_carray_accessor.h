@@ -46,6 +46,10 @@ class GDALGeoLocCArrayAccessors
     bool LoadGeoloc(bool bIsRegularGrid);
 
   public:
+    // Backmap generation may read the geolocation arrays, and write disjoint
+    // parts of the backmap, from several threads.
+    static constexpr bool SUPPORTS_CONCURRENT_ACCESS = true;
+
     template <class Type> struct CArrayAccessor
     {
         Type *m_array;
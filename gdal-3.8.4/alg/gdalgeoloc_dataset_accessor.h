@@ -55,6 +55,9 @@ class GDALGeoLocDatasetAccessors
   public:
     static constexpr int TILE_SIZE = 1024;
 
+    // GDALCachedPixelAccessor is not thread-safe.
+    static constexpr bool SUPPORTS_CONCURRENT_ACCESS = false;
+
     GDALCachedPixelAccessor<double, TILE_SIZE> geolocXAccessor;
     GDALCachedPixelAccessor<double, TILE_SIZE> geolocYAccessor;
     GDALCachedPixelAccessor<float, TILE_SIZE> backMapXAccessor;
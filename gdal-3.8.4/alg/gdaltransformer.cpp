@@ -1725,6 +1725,17 @@ static void GDALGCPAntimeridianUnwrap(int nGCPCount, GDAL_GCP *pasGCPList,
  * possible.  The default is to autoselect based on the number of GCPs.
  * A value of -1 triggers use of Thin Plate Spline instead of polynomials.
  * </li>
+ * <li> TPS_LOCALIZED=YES/NO. (GDAL &gt;= 3.9) Whether the Thin Plate
+ * Spline transformer should use a localized spline, made of splines fitted on
+ * the GCPs of the cells of a regular grid and their neighbours, rather than a
+ * global one. This is much faster and less memory hungry for large numbers of
+ * GCPs, at the expense of limiting the influence of each GCP to its
+ * neighbourhood. Defaults to NO.
+ * </li>
+ * <li> TPS_LOCALIZED_GCPS_PER_CELL=number. (GDAL &gt;= 3.9) Target number of
+ * GCPs per cell in the localized Thin Plate Spline mode. Each local spline
+ * uses the GCPs of a block of at least 3x3 cells. Defaults to 16.
+ * </li>
  * <li>GCP_ANTIMERIDIAN_UNWRAP=AUTO/YES/NO. (GDAL &gt;= 3.8) Whether to
  * "unwrap" longitudes of ground control points that span the antimeridian.
  * For datasets with GCPs in longitude/latitude coordinate space spanning the
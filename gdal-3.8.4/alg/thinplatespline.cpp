@@ -37,12 +37,15 @@
 #include "gdallinearsystem.h"
 
 #include <climits>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_vsi.h"
@@ -550,6 +553,12 @@ int VizGeorefSpline2D::solve()
         return 3;
     }
 
+    if (_local_points_per_cell > 0 &&
+        _nof_points > 9 * _local_points_per_cell)
+    {
+        return solve_localized();
+    }
+
     type = VIZ_GEOREF_SPLINE_FULL;
     // Make the necessary memory allocations.
 
@@ -625,6 +634,212 @@ int VizGeorefSpline2D::solve()
     return 4;
 }
 
+/************************************************************************/
+/*                          solve_localized()                           */
+/************************************************************************/
+
+// The global solution needs solving a dense (N+3)x(N+3) system, which is
+// O(N^3) in time and O(N^2) in memory, and evaluating N radial terms per
+// point, which becomes impractical beyond a few thousands of points.
+//
+// The localized mode divides the extent of the points into a regular grid of
+// cells, holding about _local_points_per_cell points each. For each cell, a
+// spline is fitted on the points of the 3x3 block of cells centered on it
+// (or a larger block if there are not enough points in it, or if they are
+// degenerate). Evaluation blends, with bilinear weights, the splines of the
+// 4 cells whose centers surround the point. As each of those 4 splines
+// interpolates all points of the neighbouring cells, the result is still
+// exact at the control points, and is continuous. Solving is O(N) and
+// evaluation is O(_local_points_per_cell). Compared to the global spline, the
+// influence of a control point is limited to a few cells around it: the
+// larger _local_points_per_cell is, the closer the result is to the global
+// solution.
+
+int VizGeorefSpline2D::solve_localized()
+{
+    double xmin = x[0];
+    double xmax = x[0];
+    double ymin = y[0];
+    double ymax = y[0];
+    for (int p = 1; p < _nof_points; p++)
+    {
+        xmin = std::min(xmin, x[p]);
+        xmax = std::max(xmax, x[p]);
+        ymin = std::min(ymin, y[p]);
+        ymax = std::max(ymax, y[p]);
+    }
+    const double delx = xmax - xmin;
+    const double dely = ymax - ymin;
+
+    // Dimension the grid such that cells are approximately square
+    constexpr int MAX_CELLS_PER_DIM = 4096;
+    const double dfCellCount =
+        static_cast<double>(_nof_points) / _local_points_per_cell;
+    const double dfCellsX = sqrt(dfCellCount * delx / dely);
+    _local_cells_x = static_cast<int>(
+        std::max(1.0, std::min<double>(MAX_CELLS_PER_DIM, dfCellsX + 0.5)));
+    _local_cells_y = static_cast<int>(std::max(
+        1.0, std::min<double>(MAX_CELLS_PER_DIM,
+                              dfCellCount / _local_cells_x + 0.5)));
+    _local_min_x = xmin;
+    _local_min_y = ymin;
+    _local_cell_size_x = delx / _local_cells_x;
+    _local_cell_size_y = dely / _local_cells_y;
+
+    // Spatial index: indices of points in each cell
+    std::vector<std::vector<int>> aanCellPoints(
+        static_cast<size_t>(_local_cells_x) * _local_cells_y);
+    for (int p = 0; p < _nof_points; p++)
+    {
+        const int iX = std::min(
+            _local_cells_x - 1,
+            static_cast<int>((x[p] - _local_min_x) / _local_cell_size_x));
+        const int iY = std::min(
+            _local_cells_y - 1,
+            static_cast<int>((y[p] - _local_min_y) / _local_cell_size_y));
+        aanCellPoints[static_cast<size_t>(iY) * _local_cells_x + iX].push_back(
+            p);
+    }
+
+    const int nMinPoints = std::max(10, _local_points_per_cell);
+    const int nMaxRadius = std::max(_local_cells_x, _local_cells_y);
+    int nMaxLocalPoints = 0;
+    std::vector<double> adfVars(_nof_vars);
+
+    _local_splines.clear();
+    _local_splines.reserve(aanCellPoints.size());
+    for (int iCellY = 0; iCellY < _local_cells_y; iCellY++)
+    {
+        for (int iCellX = 0; iCellX < _local_cells_x; iCellX++)
+        {
+            std::unique_ptr<VizGeorefSpline2D> poSpline;
+            for (int nRadius = 1; nRadius <= nMaxRadius; nRadius++)
+            {
+                const int iXMin = std::max(0, iCellX - nRadius);
+                const int iXMax =
+                    std::min(_local_cells_x - 1, iCellX + nRadius);
+                const int iYMin = std::max(0, iCellY - nRadius);
+                const int iYMax =
+                    std::min(_local_cells_y - 1, iCellY + nRadius);
+                size_t nCount = 0;
+                for (int iY = iYMin; iY <= iYMax; iY++)
+                    for (int iX = iXMin; iX <= iXMax; iX++)
+                        nCount += aanCellPoints[static_cast<size_t>(iY) *
+                                                    _local_cells_x +
+                                                iX]
+                                      .size();
+                if (static_cast<int>(nCount) < std::min(nMinPoints,
+                                                        _nof_points) &&
+                    nRadius < nMaxRadius)
+                {
+                    continue;
+                }
+
+                poSpline = cpl::make_unique<VizGeorefSpline2D>(_nof_vars);
+                for (int iY = iYMin; iY <= iYMax; iY++)
+                {
+                    for (int iX = iXMin; iX <= iXMax; iX++)
+                    {
+                        for (const int p :
+                             aanCellPoints[static_cast<size_t>(iY) *
+                                               _local_cells_x +
+                                           iX])
+                        {
+                            for (int v = 0; v < _nof_vars; v++)
+                                adfVars[v] = rhs[v][p + 3];
+                            if (!poSpline->add_point(x[p], y[p],
+                                                     adfVars.data()))
+                                return 0;
+                        }
+                    }
+                }
+
+                // Degenerate local configurations (aligned points) are
+                // not an error as long as a larger neighbourhood can be used.
+                int nRet;
+                {
+                    CPLErrorStateBackuper oErrorStateBackuper;
+                    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+                    nRet = poSpline->solve();
+                }
+                // Nearly aligned points only give a one-dimensional
+                // interpolation (return value 3), which is not a valid
+                // surface around the cell: grow the neighbourhood. Once it
+                // covers all points, accept it as the global solve() does.
+                if (nRet == 3 && nRadius < nMaxRadius)
+                    nRet = 0;
+                if (nRet != 0)
+                {
+                    nMaxLocalPoints =
+                        std::max(nMaxLocalPoints, static_cast<int>(nCount));
+                    break;
+                }
+                poSpline.reset();
+            }
+            if (!poSpline)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Degenerate system. Computation aborted.");
+                _local_splines.clear();
+                return 0;
+            }
+            _local_splines.emplace_back(std::move(poSpline));
+        }
+    }
+
+    CPLDebug("GDAL",
+             "Thin plate spline: localized mode with %dx%d cells, "
+             "at most %d points per local spline",
+             _local_cells_x, _local_cells_y, nMaxLocalPoints);
+
+    type = VIZ_GEOREF_SPLINE_LOCALIZED;
+    return 5;
+}
+
+/************************************************************************/
+/*                        get_point_localized()                         */
+/************************************************************************/
+
+void VizGeorefSpline2D::get_point_localized(const double Px, const double Py,
+                                            double *vars)
+{
+    // Position relative to cell centers
+    const double dfX = (Px - _local_min_x) / _local_cell_size_x - 0.5;
+    const double dfY = (Py - _local_min_y) / _local_cell_size_y - 0.5;
+    const int iX0 = static_cast<int>(std::max(
+        0.0, std::min<double>(_local_cells_x - 1, std::floor(dfX))));
+    const int iY0 = static_cast<int>(std::max(
+        0.0, std::min<double>(_local_cells_y - 1, std::floor(dfY))));
+    const int iX1 = std::min(iX0 + 1, _local_cells_x - 1);
+    const int iY1 = std::min(iY0 + 1, _local_cells_y - 1);
+    const double tx = std::max(0.0, std::min(1.0, dfX - iX0));
+    const double ty = std::max(0.0, std::min(1.0, dfY - iY0));
+
+    for (int v = 0; v < _nof_vars; v++)
+        vars[v] = 0.0;
+
+    const struct
+    {
+        int iX;
+        int iY;
+        double dfWeight;
+    } asContributions[] = {{iX0, iY0, (1 - tx) * (1 - ty)},
+                           {iX1, iY0, tx * (1 - ty)},
+                           {iX0, iY1, (1 - tx) * ty},
+                           {iX1, iY1, tx * ty}};
+    double adfLocalVars[VIZGEOREF_MAX_VARS] = {};
+    for (const auto &sContrib : asContributions)
+    {
+        if (sContrib.dfWeight == 0)
+            continue;
+        _local_splines[static_cast<size_t>(sContrib.iY) * _local_cells_x +
+                       sContrib.iX]
+            ->get_point(Px, Py, adfLocalVars);
+        for (int v = 0; v < _nof_vars; v++)
+            vars[v] += sContrib.dfWeight * adfLocalVars[v];
+    }
+}
+
 int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
 {
     switch (type)
@@ -707,6 +922,11 @@ int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
             }
             break;
         }
+        case VIZ_GEOREF_SPLINE_LOCALIZED:
+        {
+            get_point_localized(Px, Py, vars);
+            break;
+        }
         case VIZ_GEOREF_SPLINE_POINT_WAS_ADDED:
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -38,6 +38,9 @@
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 
+#include <memory>
+#include <vector>
+
 typedef enum
 {
     VIZ_GEOREF_SPLINE_ZERO_POINTS,
@@ -45,6 +48,7 @@ typedef enum
     VIZ_GEOREF_SPLINE_TWO_POINTS,
     VIZ_GEOREF_SPLINE_ONE_DIMENSIONAL,
     VIZ_GEOREF_SPLINE_FULL,
+    VIZ_GEOREF_SPLINE_LOCALIZED,
 
     VIZ_GEOREF_SPLINE_POINT_WAS_ADDED,
     VIZ_GEOREF_SPLINE_POINT_WAS_DELETED
@@ -140,6 +144,15 @@ class VizGeorefSpline2D
     }
 #endif
 
+    // Must be called before solve(). When nof_points_per_cell > 0, and
+    // there are enough points, a grid of local splines, each fitted on the
+    // points of a cell and its neighbours, is used instead of a single global
+    // spline. See solve_localized().
+    void set_localized(int nof_points_per_cell)
+    {
+        _local_points_per_cell = nof_points_per_cell;
+    }
+
     bool add_point(const double Px, const double Py, const double *Pvars);
     int get_point(const double Px, const double Py, double *Pvars);
 #if 0
@@ -151,6 +164,9 @@ class VizGeorefSpline2D
     int solve(void);
 
   private:
+    int solve_localized();
+    void get_point_localized(const double Px, const double Py, double *Pvars);
+
     vizGeorefInterType type;
 
     const int _nof_vars;
@@ -181,6 +197,16 @@ class VizGeorefSpline2D
     double x_mean;
     double y_mean;
 
+    // Localized mode
+    int _local_points_per_cell = 0;
+    int _local_cells_x = 0;
+    int _local_cells_y = 0;
+    double _local_min_x = 0;
+    double _local_min_y = 0;
+    double _local_cell_size_x = 0;
+    double _local_cell_size_y = 0;
+    std::vector<std::unique_ptr<VizGeorefSpline2D>> _local_splines{};
+
   private:
     CPL_DISALLOW_COPY_ASSIGN(VizGeorefSpline2D)
 };
@@ -43,7 +43,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
     fprintf(bIsError ? stderr : stdout,
             "Usage: gdal_footprint [--help] [--help-general]\n"
             "       [-b <band>]... [-combine_bands union|intersection]\n"
-            "       [-oo <NAME>=<VALUE>]... [-ovr <index>]\n"
+            "       [-oo <NAME>=<VALUE>]... [-ovr <index>|AUTO]\n"
             "       [-srcnodata \"<value>[ <value>]...\"]\n"
             "       [-t_cs pixel|georef] [-t_srs <srs_def>] [-split_polys]\n"
             "       [-convex_hull] [-densify <value>] [-simplify <value>]\n"
@@ -51,7 +51,9 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
             "       [-of <ogr_format>] [-lyr_name <dst_layername>]\n"
             "       [-dsco <name>=<value>]... [-lco <name>=<value>]... "
             "[-overwrite] [-q]\n"
-            "       <src_filename> <dst_filename>\n");
+            "       [-location_field_name <field_name>]\n"
+            "       <src_filename> <dst_filename>\n"
+            "       | -input_file_list <filename> <dst_filename>\n");
 
     if (pszErrorMsg != nullptr)
         fprintf(stderr, "\nFAILURE: %s\n", pszErrorMsg);
@@ -110,23 +112,29 @@ MAIN_START(argc, argv)
         GDALFootprintOptionsSetProgress(psOptions, GDALTermProgress, nullptr);
     }
 
-    if (sOptionsForBinary.osSource.empty())
+    const bool bBatch = !sOptionsForBinary.aosInputFiles.empty();
+    if (sOptionsForBinary.osSource.empty() && !bBatch)
         Usage(true, "No input file specified.");
 
     if (!sOptionsForBinary.bDestSpecified)
         Usage(true, "No output file specified.");
 
     /* -------------------------------------------------------------------- */
-    /*      Open input file.                                                */
+    /*      Open input file (input files are opened by GDALFootprintBatch() */
+    /*      in batch mode).                                                 */
     /* -------------------------------------------------------------------- */
-    GDALDatasetH hInDS = GDALOpenEx(sOptionsForBinary.osSource.c_str(),
-                                    GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-                                    /*papszAllowedDrivers=*/nullptr,
-                                    sOptionsForBinary.aosOpenOptions.List(),
-                                    /*papszSiblingFiles=*/nullptr);
+    GDALDatasetH hInDS = nullptr;
+    if (!bBatch)
+    {
+        hInDS = GDALOpenEx(sOptionsForBinary.osSource.c_str(),
+                           GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                           /*papszAllowedDrivers=*/nullptr,
+                           sOptionsForBinary.aosOpenOptions.List(),
+                           /*papszSiblingFiles=*/nullptr);
 
-    if (hInDS == nullptr)
-        exit(1);
+        if (hInDS == nullptr)
+            exit(1);
+    }
 
     /* -------------------------------------------------------------------- */
     /*      Open output file if it exists.                                  */
@@ -217,13 +225,19 @@ MAIN_START(argc, argv)
     }
 
     int bUsageError = FALSE;
-    GDALDatasetH hRetDS = GDALFootprint(sOptionsForBinary.osDest.c_str(),
-                                        hDstDS, hInDS, psOptions, &bUsageError);
+    GDALDatasetH hRetDS =
+        bBatch ? GDALFootprintBatch(sOptionsForBinary.osDest.c_str(), hDstDS,
+                                    sOptionsForBinary.aosInputFiles.size(),
+                                    sOptionsForBinary.aosInputFiles.List(),
+                                    psOptions, &bUsageError)
+               : GDALFootprint(sOptionsForBinary.osDest.c_str(), hDstDS, hInDS,
+                               psOptions, &bUsageError);
     if (bUsageError == TRUE)
         Usage(true);
     int nRetCode = hRetDS ? 0 : 1;
 
-    GDALClose(hInDS);
+    if (hInDS)
+        GDALClose(hInDS);
     if (GDALClose(hRetDS) != CE_None)
         nRetCode = 1;
     GDALFootprintOptionsFree(psOptions);
@@ -31,12 +31,16 @@
 #include "gdal_utils_priv.h"
 
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "commonutils.h"
@@ -44,9 +48,11 @@
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_mem.h"
@@ -55,6 +61,14 @@
 
 constexpr const char *DEFAULT_LAYER_NAME = "footprint";
 
+constexpr const char *DEFAULT_LOCATION_FIELD_NAME = "location";
+
+/** Value of GDALFootprintOptions::nOvrIndex for -ovr AUTO */
+constexpr int OVR_INDEX_AUTO = -2;
+
+/** Minimum largest dimension of the overview selected by -ovr AUTO */
+constexpr int AUTO_OVR_MIN_SIZE = 1024;
+
 /************************************************************************/
 /*                          GDALFootprintOptions                        */
 /************************************************************************/
@@ -80,7 +94,8 @@ struct GDALFootprintOptions
     /*! Dataset creation options */
     CPLStringList aosDSCO{};
 
-    /*! Overview index: 0 = first overview level */
+    /*! Overview index: 0 = first overview level, -1 = full resolution,
+     * OVR_INDEX_AUTO = automatic selection */
     int nOvrIndex = -1;
 
     /** Whether output geometry should be in georeferenced coordinates, if
@@ -113,6 +128,13 @@ struct GDALFootprintOptions
     bool bCombineBandsUnion = true;
 
     std::string osSrcNoData;
+
+    /*! Name of the field receiving the source dataset name, if not empty.
+     * GDALFootprintBatch() defaults it to DEFAULT_LOCATION_FIELD_NAME */
+    std::string osLocationFieldName{};
+
+    /*! Open options of source datasets opened by GDALFootprintBatch() */
+    CPLStringList aosOpenOptions{};
 };
 
 /************************************************************************/
@@ -633,59 +655,103 @@ static double GetMinDistanceBetweenTwoPoints(const OGRGeometry *poGeom)
 }
 
 /************************************************************************/
-/*                       GDALFootprintProcess()                         */
+/*                       GDALFootprintBufferBand                        */
 /************************************************************************/
 
-static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
-                                 const GDALFootprintOptions *psOptions)
+// Band serving a mask, with 0/1 values, entirely held in memory, either
+// owned by the band, or a view on lines of another buffer band.
+class GDALFootprintBufferBand final : public GDALRasterBand
 {
-    std::unique_ptr<OGRCoordinateTransformation> poCT_SRS;
-    const OGRSpatialReference *poDstSRS = poDstLayer->GetSpatialRef();
-    if (!psOptions->oOutputSRS.IsEmpty())
-        poDstSRS = &(psOptions->oOutputSRS);
-    if (poDstSRS)
+    std::vector<GByte> m_abyData{};
+    const GByte *m_pabyData = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALFootprintBufferBand)
+
+  public:
+    GDALFootprintBufferBand(int nXSize, int nYSize,
+                            std::vector<GByte> &&abyData)
+        : m_abyData(std::move(abyData)), m_pabyData(m_abyData.data())
     {
-        auto poSrcSRS = poSrcDS->GetSpatialRef();
-        if (!poSrcSRS)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Output layer has CRS, but input is not georeferenced");
-            return false;
-        }
-        poCT_SRS.reset(OGRCreateCoordinateTransformation(poSrcSRS, poDstSRS));
-        if (!poCT_SRS)
-            return false;
+        nRasterXSize = nXSize;
+        nRasterYSize = nYSize;
+        eDataType = GDT_Byte;
+        nBlockXSize = nXSize;
+        nBlockYSize = 1;
     }
 
-    std::vector<int> anBands = psOptions->anBands;
-    const int nBandCount = poSrcDS->GetRasterCount();
-    if (anBands.empty())
+    // View on nYSize lines of poParent, starting at line nYOff
+    GDALFootprintBufferBand(const GDALFootprintBufferBand *poParent, int nYOff,
+                            int nYSize)
+        : m_pabyData(poParent->m_pabyData +
+                     static_cast<size_t>(nYOff) * poParent->nRasterXSize)
     {
-        for (int i = 1; i <= nBandCount; ++i)
-            anBands.push_back(i);
+        nRasterXSize = poParent->nRasterXSize;
+        nRasterYSize = nYSize;
+        eDataType = GDT_Byte;
+        nBlockXSize = nRasterXSize;
+        nBlockYSize = 1;
     }
 
-    std::vector<GDALRasterBand *> apoSrcMaskBands;
-    const CPLStringList aosSrcNoData(
-        CSLTokenizeString2(psOptions->osSrcNoData.c_str(), " ", 0));
-    std::vector<double> adfSrcNoData;
-    if (!psOptions->osSrcNoData.empty())
+  protected:
+    CPLErr IReadBlock(int, int nBlockYOff, void *pData) override
     {
-        if (aosSrcNoData.size() != 1 &&
-            static_cast<size_t>(aosSrcNoData.size()) != anBands.size())
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Number of values in -srcnodata should be 1 or the number "
-                     "of bands");
-            return false;
-        }
-        for (int i = 0; i < aosSrcNoData.size(); ++i)
+        memcpy(pData,
+               m_pabyData + static_cast<size_t>(nBlockYOff) * nBlockXSize,
+               nBlockXSize);
+        return CE_None;
+    }
+
+    CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                     int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                     GDALDataType eBufType, GSpacing nPixelSpace,
+                     GSpacing nLineSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override
+    {
+        if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
         {
-            adfSrcNoData.emplace_back(CPLAtof(aosSrcNoData[i]));
+            GByte *pabyData = static_cast<GByte *>(pData);
+            for (int iY = 0; iY < nYSize; ++iY)
+            {
+                GDALCopyWords64(m_pabyData +
+                                    static_cast<size_t>(nYOff + iY) *
+                                        nRasterXSize +
+                                    nXOff,
+                                GDT_Byte, 1, pabyData + iY * nLineSpace,
+                                eBufType, static_cast<int>(nPixelSpace),
+                                nXSize);
+            }
+            return CE_None;
         }
+
+        return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                         pData, nBufXSize, nBufYSize, eBufType,
+                                         nPixelSpace, nLineSpace, psExtraArg);
     }
+};
+
+/************************************************************************/
+/*                          GDALFootprintMask                           */
+/************************************************************************/
+
+// Mask band to polygonize for a dataset, and the bands it derives from.
+struct GDALFootprintMask
+{
+    std::vector<std::unique_ptr<GDALRasterBand>> apoTmpNoDataMaskBands{};
+    std::vector<GDALRasterBand *> apoSrcMaskBands{};
+    std::unique_ptr<GDALRasterBand> poMaskForPolygonize{};
+
+    bool Init(GDALDataset *poSrcDS, const std::vector<int> &anBands,
+              const std::vector<double> &adfSrcNoData, int nOvrIndex,
+              bool bCombineBandsUnion);
+};
+
+bool GDALFootprintMask::Init(GDALDataset *poSrcDS,
+                             const std::vector<int> &anBands,
+                             const std::vector<double> &adfSrcNoData,
+                             int nOvrIndex, bool bCombineBandsUnion)
+{
+    const int nBandCount = poSrcDS->GetRasterCount();
     bool bGlobalMask = true;
-    std::vector<std::unique_ptr<GDALRasterBand>> apoTmpNoDataMaskBands;
     for (size_t i = 0; i < anBands.size(); ++i)
     {
         const int nBand = anBands[i];
@@ -721,14 +787,14 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                 }
                 poMaskBand = poBand->GetMaskBand();
             }
-            if (psOptions->nOvrIndex >= 0)
+            if (nOvrIndex >= 0)
             {
                 if (nMaskFlags == GMF_NODATA)
                 {
                     // If the mask band is based on nodata, we don't need
                     // to check the overviews of the mask band, but we
                     // can take the mask band of the overviews
-                    auto poOvrBand = poBand->GetOverview(psOptions->nOvrIndex);
+                    auto poOvrBand = poBand->GetOverview(nOvrIndex);
                     if (!poOvrBand)
                     {
                         if (poBand->GetOverviewCount() == 0)
@@ -738,7 +804,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 "Overview index %d invalid for this dataset. "
                                 "Bands of this dataset have no "
                                 "precomputed overviews",
-                                psOptions->nOvrIndex);
+                                nOvrIndex);
                         }
                         else
                         {
@@ -746,8 +812,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 CE_Failure, CPLE_AppDefined,
                                 "Overview index %d invalid for this dataset. "
                                 "Value should be in [0,%d] range",
-                                psOptions->nOvrIndex,
-                                poBand->GetOverviewCount() - 1);
+                                nOvrIndex, poBand->GetOverviewCount() - 1);
                         }
                         return false;
                     }
@@ -761,7 +826,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                 }
                 else
                 {
-                    poMaskBand = poMaskBand->GetOverview(psOptions->nOvrIndex);
+                    poMaskBand = poMaskBand->GetOverview(nOvrIndex);
                     if (!poMaskBand)
                     {
                         if (poBand->GetMaskBand()->GetOverviewCount() == 0)
@@ -771,7 +836,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 "Overview index %d invalid for this dataset. "
                                 "Mask bands of this dataset have no "
                                 "precomputed overviews",
-                                psOptions->nOvrIndex);
+                                nOvrIndex);
                         }
                         else
                         {
@@ -779,7 +844,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 CE_Failure, CPLE_AppDefined,
                                 "Overview index %d invalid for this dataset. "
                                 "Value should be in [0,%d] range",
-                                psOptions->nOvrIndex,
+                                nOvrIndex,
                                 poBand->GetMaskBand()->GetOverviewCount() - 1);
                         }
                         return false;
@@ -790,12 +855,466 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
         }
     }
 
+    if (bGlobalMask || anBands.size() == 1)
+    {
+        poMaskForPolygonize =
+            cpl::make_unique<GDALFootprintMaskBand>(apoSrcMaskBands[0]);
+    }
+    else
+    {
+        poMaskForPolygonize = cpl::make_unique<GDALFootprintCombinedMaskBand>(
+            apoSrcMaskBands, bCombineBandsUnion);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                  GDALFootprintGetAutoOverviewIndex()                 */
+/************************************************************************/
+
+// Returns the index of the coarsest overview level, common to all bands,
+// whose largest dimension is at least AUTO_OVR_MIN_SIZE pixels, or -1 to use
+// full resolution.
+static int GDALFootprintGetAutoOverviewIndex(GDALDataset *poSrcDS,
+                                             const std::vector<int> &anBands)
+{
+    int nOvrIndex = std::numeric_limits<int>::max();
+    for (const int nBand : anBands)
+    {
+        if (nBand <= 0 || nBand > poSrcDS->GetRasterCount())
+            return -1;
+        auto poBand = poSrcDS->GetRasterBand(nBand);
+        const int nMaskFlags = poBand->GetMaskFlags();
+        // Same logic as in GDALFootprintMask::Init()
+        GDALRasterBand *poOvrParent =
+            (nMaskFlags == GMF_NODATA ||
+             poBand->GetColorInterpretation() == GCI_AlphaBand)
+                ? poBand
+                : poBand->GetMaskBand();
+        int nBandOvrIndex = -1;
+        for (int i = poOvrParent->GetOverviewCount() - 1; i >= 0; --i)
+        {
+            auto poOvrBand = poOvrParent->GetOverview(i);
+            if (poOvrBand &&
+                std::max(poOvrBand->GetXSize(), poOvrBand->GetYSize()) >=
+                    AUTO_OVR_MIN_SIZE &&
+                (nMaskFlags != GMF_NODATA ||
+                 poOvrBand->GetMaskFlags() == GMF_NODATA))
+            {
+                nBandOvrIndex = i;
+                break;
+            }
+        }
+        if (nBandOvrIndex < 0)
+            return -1;
+        nOvrIndex = std::min(nOvrIndex, nBandOvrIndex);
+    }
+    return nOvrIndex == std::numeric_limits<int>::max() ? -1 : nOvrIndex;
+}
+
+/************************************************************************/
+/*                        GDALFootprintReadMask()                       */
+/************************************************************************/
+
+// Read the mask to polygonize in memory, by strips of blocks read from
+// several threads, each with its own handle on the source dataset.
+// On success, poBufferBand is set to the in-memory mask, unless this is not
+// possible or not worth it (single thread, mask too large, single strip),
+// in which case the mask will be read by GDALPolygonize() itself.
+// Returns false in case of read error.
+static bool
+GDALFootprintReadMask(GDALDataset *poSrcDS, GDALFootprintMask &oMainMask,
+                      const std::vector<int> &anBands,
+                      const std::vector<double> &adfSrcNoData, int nOvrIndex,
+                      bool bCombineBandsUnion, GDALProgressFunc pfnProgress,
+                      void *pProgressData,
+                      std::unique_ptr<GDALFootprintBufferBand> &poBufferBand)
+{
+    auto poMask = oMainMask.poMaskForPolygonize.get();
+    const int nXSize = poMask->GetXSize();
+    const int nYSize = poMask->GetYSize();
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poMask->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+
+    // Strips of whole blocks, of at least 1 MB
+    const int nMinLines = std::max(1, 1024 * 1024 / nXSize);
+    const int nStripLines =
+        DIV_ROUND_UP(std::max(nMinLines, nBlockYSize), nBlockYSize) *
+        nBlockYSize;
+    const int nStrips = DIV_ROUND_UP(nYSize, nStripLines);
+
+    const int nThreads = std::min(
+        GDALGetNumThreads(nullptr, nullptr, /* nMaxThreads = */ 128), nStrips);
+    const GUIntBig nMaskBytes = static_cast<GUIntBig>(nXSize) * nYSize;
+    if (nThreads <= 1 ||
+        nMaskBytes > static_cast<GUIntBig>(GDALGetCacheMax64()) ||
+        nMaskBytes > std::numeric_limits<size_t>::max() ||
+        poSrcDS->GetAccess() != GA_ReadOnly ||
+        poSrcDS->GetDescription()[0] == '\0' ||
+        poSrcDS->GetDriver() == nullptr ||
+        EQUAL(poSrcDS->GetDriver()->GetDescription(), "MEM"))
+    {
+        return true;
+    }
+
+    struct Worker
+    {
+        std::unique_ptr<GDALDataset> poDS{};  // null for the main worker
+        GDALFootprintMask oMask{};
+        GDALRasterBand *poMask = nullptr;
+    };
+    std::vector<std::unique_ptr<Worker>> apoWorkers;
+    apoWorkers.emplace_back(cpl::make_unique<Worker>());
+    apoWorkers.back()->poMask = poMask;
+
+    const char *const apszAllowedDrivers[] = {
+        poSrcDS->GetDriver()->GetDescription(), nullptr};
+    for (int i = 1; i < nThreads; ++i)
+    {
+        auto poWorker = cpl::make_unique<Worker>();
+        {
+            CPLErrorStateBackuper oErrorStateBackuper;
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            poWorker->poDS.reset(GDALDataset::Open(
+                poSrcDS->GetDescription(), GDAL_OF_RASTER, apszAllowedDrivers,
+                poSrcDS->GetOpenOptions(), nullptr));
+            if (!poWorker->poDS ||
+                poWorker->poDS->GetRasterXSize() !=
+                    poSrcDS->GetRasterXSize() ||
+                poWorker->poDS->GetRasterYSize() !=
+                    poSrcDS->GetRasterYSize() ||
+                poWorker->poDS->GetRasterCount() !=
+                    poSrcDS->GetRasterCount() ||
+                !poWorker->oMask.Init(poWorker->poDS.get(), anBands,
+                                      adfSrcNoData, nOvrIndex,
+                                      bCombineBandsUnion))
+            {
+                break;
+            }
+        }
+        poWorker->poMask = poWorker->oMask.poMaskForPolygonize.get();
+        if (poWorker->poMask->GetXSize() != nXSize ||
+            poWorker->poMask->GetYSize() != nYSize)
+        {
+            break;
+        }
+        apoWorkers.emplace_back(std::move(poWorker));
+    }
+    if (apoWorkers.size() == 1)
+        return true;
+
+    std::vector<GByte> abyMask;
+    try
+    {
+        abyMask.resize(static_cast<size_t>(nMaskBytes));
+    }
+    catch (const std::exception &)
+    {
+        return true;
+    }
+
+    std::atomic<int> nNextStrip{0};
+    std::atomic<int> nStripsDone{0};
+    std::atomic<bool> bError{false};
+    const auto RunWorker = [&](Worker &oWorker, bool bMainThread)
+    {
+        while (!bError)
+        {
+            const int iStrip = nNextStrip++;
+            if (iStrip >= nStrips)
+                break;
+            const int nYOff = iStrip * nStripLines;
+            const int nLines = std::min(nStripLines, nYSize - nYOff);
+            // Reading as Byte with a pixel spacing of 1 is what the
+            // mask bands above expect, and gives 0/1 values.
+            if (oWorker.poMask->RasterIO(
+                    GF_Read, 0, nYOff, nXSize, nLines,
+                    abyMask.data() + static_cast<size_t>(nYOff) * nXSize,
+                    nXSize, nLines, GDT_Byte, 1, nXSize,
+                    nullptr) != CE_None)
+            {
+                bError = true;
+                break;
+            }
+            const int nDone = ++nStripsDone;
+            if (bMainThread &&
+                !pfnProgress(static_cast<double>(nDone) / nStrips, "",
+                             pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bError = true;
+                break;
+            }
+        }
+    };
+
+    CPLWorkerThreadPool *poThreadPool =
+        GDALGetGlobalThreadPool(static_cast<int>(apoWorkers.size()) - 1);
+    if (!poThreadPool)
+        return true;
+    struct JobStruct
+    {
+        const decltype(RunWorker) *pfnRunWorker;
+        Worker *poWorker;
+    };
+    std::vector<JobStruct> asJobs;
+    for (size_t i = 1; i < apoWorkers.size(); ++i)
+        asJobs.push_back(JobStruct{&RunWorker, apoWorkers[i].get()});
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+    {
+        poJobQueue->SubmitJob(
+            [](void *pData)
+            {
+                auto psJob = static_cast<JobStruct *>(pData);
+                (*(psJob->pfnRunWorker))(*(psJob->poWorker), false);
+            },
+            &sJob);
+    }
+    RunWorker(*(apoWorkers[0]), true);
+    poJobQueue->WaitCompletion();
+
+    if (bError)
+        return false;
+
+    poBufferBand = cpl::make_unique<GDALFootprintBufferBand>(
+        nXSize, nYSize, std::move(abyMask));
+    return true;
+}
+
+/************************************************************************/
+/*                  GDALFootprintPolygonizeByStrips()                   */
+/************************************************************************/
+
+// Polygonize the in-memory mask by horizontal strips, from several threads,
+// and add the resulting polygons, in pixel coordinates of the mask, as
+// features of poMemLayer.
+// Polygons that touch the seam between two strips are merged with GEOS, so
+// the result is the same set of polygons as polygonizing the mask in one
+// go, except for the order of polygons and of their vertices.
+static bool GDALFootprintPolygonizeByStrips(
+    GDALFootprintBufferBand *poBufferBand, int nStrips,
+    GDALProgressFunc pfnProgress, void *pProgressData, OGRLayer *poMemLayer)
+{
+    const int nYSize = poBufferBand->GetYSize();
+    const int nStripLines = DIV_ROUND_UP(nYSize, nStrips);
+    nStrips = DIV_ROUND_UP(nYSize, nStripLines);
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nStrips - 1);
+    if (!poThreadPool)
+        return false;
+
+    std::vector<std::vector<std::unique_ptr<OGRGeometry>>> aapoStripPolys(
+        nStrips);
+    std::atomic<int> nNextStrip{0};
+    std::atomic<int> nStripsDone{0};
+    std::atomic<bool> bError{false};
+    auto RunWorker = [&](bool bMainThread)
+    {
+        while (!bError)
+        {
+            const int iStrip = nNextStrip++;
+            if (iStrip >= nStrips)
+                break;
+            const int nYOff = iStrip * nStripLines;
+            GDALFootprintBufferBand oStripBand(
+                poBufferBand, nYOff, std::min(nStripLines, nYSize - nYOff));
+            auto hBand = GDALRasterBand::ToHandle(&oStripBand);
+            OGRMemLayer oStripLayer("", nullptr, wkbUnknown);
+            if (GDALPolygonize(hBand, hBand, OGRLayer::ToHandle(&oStripLayer),
+                               /* iPixValField = */ -1,
+                               /* papszOptions = */ nullptr, nullptr,
+                               nullptr) != CE_None)
+            {
+                bError = true;
+                break;
+            }
+
+            // From strip to mask pixel coordinates
+            const std::array<double, 6> adfStripGT{
+                {0.0, 1.0, 0.0, double(nYOff), 0.0, 1.0}};
+            GeoTransformCoordinateTransformation oCT(adfStripGT);
+            for (auto &&poFeature : oStripLayer)
+            {
+                std::unique_ptr<OGRGeometry> poGeom(
+                    poFeature->StealGeometry());
+                if (poGeom && poGeom->getGeometryType() == wkbPolygon &&
+                    poGeom->transform(&oCT) == OGRERR_NONE)
+                {
+                    aapoStripPolys[iStrip].push_back(std::move(poGeom));
+                }
+            }
+
+            const int nDone = ++nStripsDone;
+            if (bMainThread &&
+                !pfnProgress(0.9 * nDone / nStrips, "", pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bError = true;
+                break;
+            }
+        }
+    };
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    for (int i = 1; i < nStrips; ++i)
+    {
+        poJobQueue->SubmitJob(
+            [](void *pData)
+            { (*static_cast<decltype(RunWorker) *>(pData))(false); },
+            &RunWorker);
+    }
+    RunWorker(true);
+    poJobQueue->WaitCompletion();
+    if (bError)
+        return false;
+
+    // Polygons that reach a seam between two strips may continue in the
+    // adjacent strip: union them.
+    const auto AddPolygon = [poMemLayer](std::unique_ptr<OGRGeometry> poGeom)
+    {
+        auto poFeature =
+            cpl::make_unique<OGRFeature>(poMemLayer->GetLayerDefn());
+        poFeature->SetGeometryDirectly(poGeom.release());
+        return poMemLayer->CreateFeature(poFeature.get()) == OGRERR_NONE;
+    };
+    auto poSeamPolys = cpl::make_unique<OGRMultiPolygon>();
+    for (int iStrip = 0; iStrip < nStrips; ++iStrip)
+    {
+        const double dfTop = double(iStrip) * nStripLines;
+        const double dfBottom =
+            std::min(double(iStrip + 1) * nStripLines, double(nYSize));
+        for (auto &poGeom : aapoStripPolys[iStrip])
+        {
+            OGREnvelope sEnvelope;
+            poGeom->getEnvelope(&sEnvelope);
+            if ((iStrip > 0 && sEnvelope.MinY == dfTop) ||
+                (iStrip + 1 < nStrips && sEnvelope.MaxY == dfBottom))
+            {
+                poSeamPolys->addGeometryDirectly(poGeom.release());
+            }
+            else if (!AddPolygon(std::move(poGeom)))
+            {
+                return false;
+            }
+        }
+    }
+    if (!poSeamPolys->IsEmpty())
+    {
+        std::unique_ptr<OGRGeometry> poUnion(poSeamPolys->UnionCascaded());
+        if (!poUnion)
+            return false;
+        // Remove the vertices that the union leaves along the seams.
+        // A tolerance of 0 only removes collinear vertices.
+        poUnion.reset(poUnion->Simplify(0.0));
+        if (!poUnion)
+            return false;
+        const auto eType = wkbFlatten(poUnion->getGeometryType());
+        if (eType == wkbPolygon)
+        {
+            if (!AddPolygon(std::move(poUnion)))
+                return false;
+        }
+        else if (eType == wkbMultiPolygon)
+        {
+            auto poMP = std::unique_ptr<OGRMultiPolygon>(
+                poUnion.release()->toMultiPolygon());
+            while (!poMP->IsEmpty())
+            {
+                std::unique_ptr<OGRGeometry> poPoly(poMP->getGeometryRef(0));
+                poMP->removeGeometry(0, /* bDelete = */ false);
+                if (!AddPolygon(std::move(poPoly)))
+                    return false;
+            }
+        }
+    }
+
+    return pfnProgress(1.0, "", pProgressData) != FALSE;
+}
+
+/************************************************************************/
+/*                   GDALFootprintComputeGeometries()                   */
+/************************************************************************/
+
+// Compute the footprint geometries of poSrcDS, in the poDstSRS CRS if not
+// null.
+static bool GDALFootprintComputeGeometries(
+    GDALDataset *poSrcDS, const OGRSpatialReference *poDstSRS,
+    const GDALFootprintOptions *psOptions, GDALProgressFunc pfnProgress,
+    void *pProgressData, std::vector<std::unique_ptr<OGRGeometry>> &apoGeoms)
+{
+    std::unique_ptr<OGRCoordinateTransformation> poCT_SRS;
+    if (!psOptions->oOutputSRS.IsEmpty())
+        poDstSRS = &(psOptions->oOutputSRS);
+    if (poDstSRS)
+    {
+        auto poSrcSRS = poSrcDS->GetSpatialRef();
+        if (!poSrcSRS)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Output layer has CRS, but input is not georeferenced");
+            return false;
+        }
+        poCT_SRS.reset(OGRCreateCoordinateTransformation(poSrcSRS, poDstSRS));
+        if (!poCT_SRS)
+            return false;
+    }
+
+    std::vector<int> anBands = psOptions->anBands;
+    const int nBandCount = poSrcDS->GetRasterCount();
+    if (anBands.empty())
+    {
+        for (int i = 1; i <= nBandCount; ++i)
+            anBands.push_back(i);
+    }
+
+    const CPLStringList aosSrcNoData(
+        CSLTokenizeString2(psOptions->osSrcNoData.c_str(), " ", 0));
+    std::vector<double> adfSrcNoData;
+    if (!psOptions->osSrcNoData.empty())
+    {
+        if (aosSrcNoData.size() != 1 &&
+            static_cast<size_t>(aosSrcNoData.size()) != anBands.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Number of values in -srcnodata should be 1 or the number "
+                     "of bands");
+            return false;
+        }
+        for (int i = 0; i < aosSrcNoData.size(); ++i)
+        {
+            adfSrcNoData.emplace_back(CPLAtof(aosSrcNoData[i]));
+        }
+    }
+
+    int nOvrIndex = psOptions->nOvrIndex;
+    if (nOvrIndex == OVR_INDEX_AUTO)
+    {
+        nOvrIndex = adfSrcNoData.empty()
+                        ? GDALFootprintGetAutoOverviewIndex(poSrcDS, anBands)
+                        : -1;
+        if (nOvrIndex >= 0)
+        {
+            CPLDebug("GDAL", "gdal_footprint: using overview level %d",
+                     nOvrIndex);
+        }
+    }
+
+    GDALFootprintMask oMask;
+    if (!oMask.Init(poSrcDS, anBands, adfSrcNoData, nOvrIndex,
+                    psOptions->bCombineBandsUnion))
+    {
+        return false;
+    }
+
     std::unique_ptr<OGRCoordinateTransformation> poCT_GT;
     std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
     if (psOptions->bOutCSGeoref &&
         poSrcDS->GetGeoTransform(adfGeoTransform.data()) == CE_None)
     {
-        auto poMaskBand = apoSrcMaskBands[0];
+        auto poMaskBand = oMask.apoSrcMaskBands[0];
         adfGeoTransform[1] *=
             double(poSrcDS->GetRasterXSize()) / poMaskBand->GetXSize();
         adfGeoTransform[2] *=
@@ -814,11 +1333,11 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                  "input dataset has no geotransform.");
         return false;
     }
-    else if (psOptions->nOvrIndex >= 0)
+    else if (nOvrIndex >= 0)
     {
         // Transform from overview pixel coordinates to full resolution
         // pixel coordinates
-        auto poMaskBand = apoSrcMaskBands[0];
+        auto poMaskBand = oMask.apoSrcMaskBands[0];
         adfGeoTransform[1] =
             double(poSrcDS->GetRasterXSize()) / poMaskBand->GetXSize();
         adfGeoTransform[2] = 0;
@@ -829,29 +1348,68 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
             adfGeoTransform);
     }
 
-    std::unique_ptr<GDALRasterBand> poMaskForRasterize;
-    if (bGlobalMask || anBands.size() == 1)
-    {
-        poMaskForRasterize =
-            cpl::make_unique<GDALFootprintMaskBand>(apoSrcMaskBands[0]);
-    }
-    else
+    // Read the mask in memory from several threads if possible. Half of the
+    // progress is then attributed to reading, and half to polygonization.
+    std::unique_ptr<GDALFootprintBufferBand> poBufferBand;
     {
-        poMaskForRasterize = cpl::make_unique<GDALFootprintCombinedMaskBand>(
-            apoSrcMaskBands, psOptions->bCombineBandsUnion);
+        std::unique_ptr<void, decltype(&GDALDestroyScaledProgress)>
+            pScaledProgress(GDALCreateScaledProgress(0.0, 0.5, pfnProgress,
+                                                     pProgressData),
+                            GDALDestroyScaledProgress);
+        if (!GDALFootprintReadMask(poSrcDS, oMask, anBands, adfSrcNoData,
+                                   nOvrIndex, psOptions->bCombineBandsUnion,
+                                   GDALScaledProgress, pScaledProgress.get(),
+                                   poBufferBand))
+        {
+            return false;
+        }
     }
 
-    auto hBand = GDALRasterBand::ToHandle(poMaskForRasterize.get());
     auto poMemLayer = cpl::make_unique<OGRMemLayer>("", nullptr, wkbUnknown);
-    const CPLErr eErr =
-        GDALPolygonize(hBand, hBand, OGRLayer::ToHandle(poMemLayer.get()),
-                       /* iPixValField = */ -1,
-                       /* papszOptions = */ nullptr, psOptions->pfnProgress,
-                       psOptions->pProgressData);
-    if (eErr != CE_None)
     {
-        return false;
+        std::unique_ptr<void, decltype(&GDALDestroyScaledProgress)>
+            pScaledProgress(GDALCreateScaledProgress(poBufferBand ? 0.5 : 0.0,
+                                                     1.0, pfnProgress,
+                                                     pProgressData),
+                            GDALDestroyScaledProgress);
+
+        // Once the mask is in memory, polygonize it by strips from several
+        // threads if GEOS is available to merge polygons across strips.
+        // Strips are large enough for the merge to be cheap.
+        constexpr int MIN_POLYGONIZE_STRIP_LINES = 256;
+        const int nPolygonizeStrips =
+            poBufferBand && OGRGeometryFactory::haveGEOS()
+                ? std::min(GDALGetNumThreads(nullptr, nullptr,
+                                             /* nMaxThreads = */ 128),
+                           poBufferBand->GetYSize() /
+                               MIN_POLYGONIZE_STRIP_LINES)
+                : 1;
+        if (nPolygonizeStrips > 1)
+        {
+            if (!GDALFootprintPolygonizeByStrips(
+                    poBufferBand.get(), nPolygonizeStrips, GDALScaledProgress,
+                    pScaledProgress.get(), poMemLayer.get()))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            auto hBand = GDALRasterBand::ToHandle(
+                poBufferBand ? poBufferBand.get()
+                             : oMask.poMaskForPolygonize.get());
+            const CPLErr eErr = GDALPolygonize(
+                hBand, hBand, OGRLayer::ToHandle(poMemLayer.get()),
+                /* iPixValField = */ -1,
+                /* papszOptions = */ nullptr, GDALScaledProgress,
+                pScaledProgress.get());
+            if (eErr != CE_None)
+            {
+                return false;
+            }
+        }
     }
+    poBufferBand.reset();
 
     if (!psOptions->bSplitPolys)
     {
@@ -880,10 +1438,6 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
         if (poGeom->IsEmpty())
             continue;
 
-        auto poDstFeature =
-            cpl::make_unique<OGRFeature>(poDstLayer->GetLayerDefn());
-        poDstFeature->SetFrom(poFeature.get());
-
         if (poCT_GT)
         {
             if (poGeom->transform(poCT_GT.get()) != OGRERR_NONE)
@@ -1007,6 +1561,28 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
             poGeom.reset(
                 OGRGeometryFactory::forceToMultiPolygon(poGeom.release()));
 
+        apoGeoms.push_back(std::move(poGeom));
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                      GDALFootprintWriteGeometries()                  */
+/************************************************************************/
+
+// Write the geometries as features of poDstLayer. If iLocationField >= 0,
+// pszLocation is set as the value of that field.
+static bool GDALFootprintWriteGeometries(
+    OGRLayer *poDstLayer, std::vector<std::unique_ptr<OGRGeometry>> &apoGeoms,
+    int iLocationField, const char *pszLocation)
+{
+    for (auto &poGeom : apoGeoms)
+    {
+        auto poDstFeature =
+            cpl::make_unique<OGRFeature>(poDstLayer->GetLayerDefn());
+        if (iLocationField >= 0)
+            poDstFeature->SetField(iLocationField, pszLocation);
         poDstFeature->SetGeometryDirectly(poGeom.release());
 
         if (poDstLayer->CreateFeature(poDstFeature.get()) != OGRERR_NONE)
@@ -1018,6 +1594,59 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
     return true;
 }
 
+/************************************************************************/
+/*                    GDALFootprintGetLocationField()                   */
+/************************************************************************/
+
+// Returns the index of the field of poDstLayer to store the source dataset
+// name, creating it if needed, -2 in case of error, or -1 if no field is
+// requested.
+static int GDALFootprintGetLocationField(OGRLayer *poDstLayer,
+                                         const std::string &osFieldName)
+{
+    if (osFieldName.empty())
+        return -1;
+    auto poDefn = poDstLayer->GetLayerDefn();
+    int iField = poDefn->GetFieldIndex(osFieldName.c_str());
+    if (iField < 0)
+    {
+        OGRFieldDefn oFieldDefn(osFieldName.c_str(), OFTString);
+        if (poDstLayer->CreateField(&oFieldDefn) == OGRERR_NONE)
+            iField = poDefn->GetFieldIndex(osFieldName.c_str());
+        if (iField < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot create field %s",
+                     osFieldName.c_str());
+            return -2;
+        }
+    }
+    return iField;
+}
+
+/************************************************************************/
+/*                       GDALFootprintProcess()                         */
+/************************************************************************/
+
+static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
+                                 const GDALFootprintOptions *psOptions)
+{
+    const int iLocationField = GDALFootprintGetLocationField(
+        poDstLayer, psOptions->osLocationFieldName);
+    if (iLocationField == -2)
+        return false;
+
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms;
+    if (!GDALFootprintComputeGeometries(
+            poSrcDS, poDstLayer->GetSpatialRef(), psOptions,
+            psOptions->pfnProgress, psOptions->pProgressData, apoGeoms))
+    {
+        return false;
+    }
+
+    return GDALFootprintWriteGeometries(poDstLayer, apoGeoms, iLocationField,
+                                        poSrcDS->GetDescription());
+}
+
 /************************************************************************/
 /*                             GDALFootprint()                          */
 /************************************************************************/
@@ -1127,6 +1756,285 @@ GDALDatasetH GDALFootprint(const char *pszDest, GDALDatasetH hDstDS,
     return hDstDS;
 }
 
+/************************************************************************/
+/*                          GDALFootprintBatch()                        */
+/************************************************************************/
+
+/* clang-format off */
+/**
+ * Computes the footprints of several rasters into a single layer.
+ *
+ * This is the equivalent of the
+ * <a href="/programs/gdal_footprint.html">gdal_footprint</a> utility with
+ * the -input_file_list switch.
+ *
+ * Source datasets are opened and their footprints computed in parallel, in
+ * as many threads as specified by the GDAL_NUM_THREADS configuration option
+ * (defaults to 1). Footprints are written to the output layer in the
+ * order of papszSrcDSNames, with the name of their source dataset in the
+ * field specified with -location_field_name (defaults to "location").
+ * Source datasets that cannot be opened or processed are skipped with a
+ * warning.
+ *
+ * GDALFootprintOptions* must be allocated and freed with
+ * GDALFootprintOptionsNew() and GDALFootprintOptionsFree() respectively.
+ * pszDest and hDstDS cannot be used at the same time.
+ *
+ * @param pszDest the vector destination dataset path or NULL.
+ * @param hDstDS the vector destination dataset or NULL.
+ * @param nSrcCount the number of input datasets.
+ * @param papszSrcDSNames the list of input dataset names.
+ * @param psOptionsIn the options struct returned by GDALFootprintOptionsNew()
+ * or NULL.
+ * @param pbUsageError pointer to a integer output variable to store if any
+ * usage error has occurred or NULL.
+ * @return the output dataset (new dataset that must be closed using
+ * GDALClose(), or hDstDS is not NULL) or NULL in case of error.
+ *
+ * @since GDAL 3.9
+ */
+/* clang-format on */
+
+GDALDatasetH GDALFootprintBatch(const char *pszDest, GDALDatasetH hDstDS,
+                                int nSrcCount,
+                                const char *const *papszSrcDSNames,
+                                const GDALFootprintOptions *psOptionsIn,
+                                int *pbUsageError)
+{
+    if (pszDest == nullptr && hDstDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "pszDest == NULL && hDstDS == NULL");
+
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return nullptr;
+    }
+    if (nSrcCount <= 0 || papszSrcDSNames == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "No source dataset");
+
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return nullptr;
+    }
+    if (hDstDS != nullptr && psOptionsIn && psOptionsIn->bCreateOutput)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "hDstDS != NULL but options that imply creating a new dataset "
+                 "have been set.");
+
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return nullptr;
+    }
+
+    GDALFootprintOptions *psOptionsToFree = nullptr;
+    if (psOptionsIn == nullptr)
+    {
+        psOptionsToFree = GDALFootprintOptionsNew(nullptr, nullptr);
+        psOptionsIn = psOptionsToFree;
+    }
+    GDALFootprintOptions sOptions(*psOptionsIn);
+    GDALFootprintOptionsFree(psOptionsToFree);
+    if (sOptions.osLocationFieldName.empty())
+        sOptions.osLocationFieldName = DEFAULT_LOCATION_FIELD_NAME;
+
+    const bool bCloseOutDSOnError = hDstDS == nullptr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Create or open the output layer, using the first source        */
+    /*      dataset that can be opened as the template.                     */
+    /* -------------------------------------------------------------------- */
+    OGRLayer *poLayer = nullptr;
+    for (int i = 0; i < nSrcCount && !poLayer; ++i)
+    {
+        std::unique_ptr<GDALDataset> poSrcDS(GDALDataset::Open(
+            papszSrcDSNames[i], GDAL_OF_RASTER, nullptr,
+            sOptions.aosOpenOptions.List(), nullptr));
+        if (poSrcDS && poSrcDS->GetRasterCount() > 0)
+        {
+            poLayer = GetOutputLayerAndUpdateDstDS(pszDest, hDstDS,
+                                                   poSrcDS.get(), &sOptions);
+            if (!poLayer)
+            {
+                if (hDstDS && bCloseOutDSOnError)
+                    GDALClose(hDstDS);
+                return nullptr;
+            }
+        }
+    }
+    if (!poLayer)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "None of the source datasets could be opened");
+        return nullptr;
+    }
+
+    const int iLocationField =
+        GDALFootprintGetLocationField(poLayer, sOptions.osLocationFieldName);
+    if (iLocationField < 0)
+    {
+        if (bCloseOutDSOnError)
+            GDALClose(hDstDS);
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute footprints from worker threads, and write them from    */
+    /*      this thread, in the order of the source datasets.               */
+    /* -------------------------------------------------------------------- */
+    struct Result
+    {
+        bool bDone = false;
+        bool bOK = false;
+        std::string osErrorMsg{};
+        std::vector<std::unique_ptr<OGRGeometry>> apoGeoms{};
+    };
+    std::vector<Result> aoResults(nSrcCount);
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::atomic<bool> bStop{false};
+    const OGRSpatialReference *poLayerSRS = poLayer->GetSpatialRef();
+
+    const int nThreads = std::min(
+        GDALGetNumThreads(nullptr, nullptr, /* nMaxThreads = */ 128),
+        nSrcCount);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue =
+        poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    const bool bUseThreads = poJobQueue != nullptr;
+
+    const auto ProcessSource = [&](int iSrc)
+    {
+        Result oResult;
+        if (!bStop)
+        {
+            // Each thread works on its own dataset, so do not read each
+            // of them from several threads.
+            std::unique_ptr<CPLConfigOptionSetter> poThreadsSetter;
+            if (bUseThreads)
+            {
+                poThreadsSetter = cpl::make_unique<CPLConfigOptionSetter>(
+                    "GDAL_NUM_THREADS", "1", false);
+            }
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            CPLErrorStateBackuper oErrorStateBackuper;
+
+            // Objects with a CRS are not safe for concurrent use, hence
+            // per-source copies.
+            std::unique_ptr<GDALFootprintOptions> psJobOptions;
+            std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceReleaser>
+                poDstSRS;
+            {
+                std::lock_guard<std::mutex> oLock(oMutex);
+                psJobOptions = cpl::make_unique<GDALFootprintOptions>(sOptions);
+                if (poLayerSRS)
+                    poDstSRS.reset(poLayerSRS->Clone());
+            }
+
+            std::unique_ptr<GDALDataset> poSrcDS(GDALDataset::Open(
+                papszSrcDSNames[iSrc], GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                nullptr, psJobOptions->aosOpenOptions.List(), nullptr));
+            if (poSrcDS && poSrcDS->GetRasterCount() == 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Input dataset has no raster band.");
+            }
+            else if (poSrcDS)
+            {
+                oResult.bOK = GDALFootprintComputeGeometries(
+                    poSrcDS.get(), poDstSRS.get(), psJobOptions.get(),
+                    GDALDummyProgress, nullptr, oResult.apoGeoms);
+            }
+            if (!oResult.bOK)
+                oResult.osErrorMsg = CPLGetLastErrorMsg();
+        }
+
+        std::lock_guard<std::mutex> oLock(oMutex);
+        aoResults[iSrc] = std::move(oResult);
+        aoResults[iSrc].bDone = true;
+        oCV.notify_all();
+    };
+
+    struct JobStruct
+    {
+        const decltype(ProcessSource) *pfnProcessSource;
+        int iSrc;
+    };
+    std::vector<JobStruct> asJobs;
+    if (bUseThreads)
+    {
+        for (int i = 0; i < nSrcCount; ++i)
+            asJobs.push_back(JobStruct{&ProcessSource, i});
+        for (auto &sJob : asJobs)
+        {
+            poJobQueue->SubmitJob(
+                [](void *pData)
+                {
+                    auto psJob = static_cast<JobStruct *>(pData);
+                    (*(psJob->pfnProcessSource))(psJob->iSrc);
+                },
+                &sJob);
+        }
+    }
+
+    bool bRet = true;
+    for (int i = 0; i < nSrcCount; ++i)
+    {
+        Result oResult;
+        if (bUseThreads)
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [&aoResults, i] { return aoResults[i].bDone; });
+            oResult = std::move(aoResults[i]);
+        }
+        else
+        {
+            ProcessSource(i);
+            oResult = std::move(aoResults[i]);
+        }
+
+        if (!oResult.bOK)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Cannot compute footprint of %s: %s. Skipping it.",
+                     papszSrcDSNames[i], oResult.osErrorMsg.c_str());
+        }
+        else if (!GDALFootprintWriteGeometries(poLayer, oResult.apoGeoms,
+                                               iLocationField,
+                                               papszSrcDSNames[i]))
+        {
+            bRet = false;
+            break;
+        }
+
+        if (!sOptions.pfnProgress(static_cast<double>(i + 1) / nSrcCount, "",
+                                  sOptions.pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bRet = false;
+            break;
+        }
+    }
+
+    if (bUseThreads)
+    {
+        bStop = true;
+        poJobQueue->WaitCompletion();
+    }
+
+    if (!bRet)
+    {
+        if (bCloseOutDSOnError)
+            GDALClose(hDstDS);
+        return nullptr;
+    }
+
+    return hDstDS;
+}
+
 /************************************************************************/
 /*                           GDALFootprintOptionsNew()                  */
 /************************************************************************/
@@ -1187,18 +2095,47 @@ GDALFootprintOptionsNew(char **papszArgv,
         else if (i < argc - 1 && EQUAL(papszArgv[i], "-oo"))
         {
             i++;
+            psOptions->aosOpenOptions.AddString(papszArgv[i]);
             if (psOptionsForBinary)
             {
                 psOptionsForBinary->aosOpenOptions.AddString(papszArgv[i]);
             }
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-input_file_list"))
+        {
+            i++;
+            if (psOptionsForBinary)
+            {
+                VSILFILE *fp = VSIFOpenL(papszArgv[i], "r");
+                if (fp == nullptr)
+                {
+                    CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s",
+                             papszArgv[i]);
+                    return nullptr;
+                }
+                while (const char *pszLine = CPLReadLineL(fp))
+                {
+                    if (pszLine[0] != '\0')
+                        psOptionsForBinary->aosInputFiles.AddString(pszLine);
+                }
+                VSIFCloseL(fp);
+            }
             else
             {
-                CPLError(
-                    CE_Failure, CPLE_NotSupported,
-                    "-oo switch only supported from gdal_footprint binary.");
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "-input_file_list switch only supported from "
+                         "gdal_footprint binary.");
+                return nullptr;
             }
         }
 
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-location_field_name"))
+        {
+            i++;
+            psOptions->osLocationFieldName = papszArgv[i];
+        }
+
         else if (i < argc - 1 && EQUAL(papszArgv[i], "-t_cs"))
         {
             i++;
@@ -1347,7 +2284,10 @@ GDALFootprintOptionsNew(char **papszArgv,
         else if (i < argc - 1 && EQUAL(papszArgv[i], "-ovr"))
         {
             i++;
-            psOptions->nOvrIndex = atoi(papszArgv[i]);
+            if (EQUAL(papszArgv[i], "AUTO"))
+                psOptions->nOvrIndex = OVR_INDEX_AUTO;
+            else
+                psOptions->nOvrIndex = atoi(papszArgv[i]);
         }
 
         else if (papszArgv[i][0] == '-')
@@ -1402,6 +2342,23 @@ GDALFootprintOptionsNew(char **papszArgv,
 
     if (psOptionsForBinary)
     {
+        // With -input_file_list, the only positional argument is the
+        // destination.
+        if (!psOptionsForBinary->aosInputFiles.empty() && bGotSourceFilename)
+        {
+            if (bGotDestFilename)
+            {
+                psOptionsForBinary->aosInputFiles.InsertString(
+                    0, psOptionsForBinary->osSource.c_str());
+            }
+            else
+            {
+                psOptionsForBinary->bDestSpecified = true;
+                psOptionsForBinary->osDest = psOptionsForBinary->osSource;
+            }
+            psOptionsForBinary->osSource.clear();
+        }
+
         psOptionsForBinary->bCreateOutput = psOptions->bCreateOutput;
         psOptionsForBinary->osFormat = psOptions->osFormat;
         psOptionsForBinary->osDestLayerName = psOptions->osDestLayerName;
@@ -232,6 +232,12 @@ GDALDatasetH CPL_DLL GDALFootprint(const char *pszDest, GDALDatasetH hDstDS,
                                    const GDALFootprintOptions *psOptions,
                                    int *pbUsageError);
 
+GDALDatasetH CPL_DLL GDALFootprintBatch(const char *pszDest,
+                                        GDALDatasetH hDstDS, int nSrcCount,
+                                        const char *const *papszSrcDSNames,
+                                        const GDALFootprintOptions *psOptions,
+                                        int *pbUsageError);
+
 /*! Options for GDALBuildVRT(). Opaque type */
 typedef struct GDALBuildVRTOptions GDALBuildVRTOptions;
 
@@ -209,6 +209,8 @@ struct GDALRasterizeOptionsForBinary
 struct GDALFootprintOptionsForBinary
 {
     std::string osSource{};
+    /*! source datasets given with -input_file_list */
+    CPLStringList aosInputFiles{};
     bool bDestSpecified = false;
     std::string osDest{};
     bool bQuiet = false;
@@ -37,6 +37,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -44,8 +46,10 @@
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #include "nearblack_lib.h"
 
@@ -333,6 +337,140 @@ GDALDatasetH CPL_DLL GDALNearblack(const char *pszDest, GDALDatasetH hDstDS,
     return hDstDS;
 }
 
+/************************************************************************/
+/*                      GDALNearblackRunParallel()                      */
+/************************************************************************/
+
+// Split [0, nItems[ into ranges of consecutive items, run fn(iStart, iEnd)
+// on each of them from the job queue, and wait for completion.
+static void GDALNearblackRunParallel(CPLJobQueue *poJobQueue, int nThreads,
+                                     int nItems,
+                                     const std::function<void(int, int)> &fn)
+{
+    struct JobStruct
+    {
+        const std::function<void(int, int)> *pfn;
+        int iStart;
+        int iEnd;
+    };
+
+    // A few ranges per thread for load balancing.
+    const int nRanges = std::max(1, std::min(nItems, nThreads * 4));
+    std::vector<JobStruct> asJobs;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        const int iStart =
+            static_cast<int>(static_cast<GIntBig>(nItems) * i / nRanges);
+        const int iEnd =
+            static_cast<int>(static_cast<GIntBig>(nItems) * (i + 1) / nRanges);
+        asJobs.push_back(JobStruct{&fn, iStart, iEnd});
+    }
+    for (auto &job : asJobs)
+    {
+        poJobQueue->SubmitJob(
+            [](void *pData)
+            {
+                auto psJob = static_cast<JobStruct *>(pData);
+                (*(psJob->pfn))(psJob->iStart, psJob->iEnd);
+            },
+            &job);
+    }
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                          ProcessLineChunk()                          */
+/*                                                                      */
+/*      Process a chunk of consecutive scanlines, either from the top   */
+/*      or from the bottom of the chunk.                                */
+/************************************************************************/
+
+// The vertical check of a column only depends on panLastLineCounts[] for
+// that column, so columns are processed in parallel, line after line, and
+// the per-line counts are saved in anLineCounts. The horizontal checks of a
+// line only depend on the counts after the vertical check of that line, so
+// lines are then processed in parallel. This gives exactly the same result as
+// calling ProcessLine() sequentially on each line.
+static void ProcessLineChunk(GByte *pabyChunk, GByte *pabyMaskChunk,
+                             int nXSize, int nLines, int nSrcBands,
+                             int nDstBands, int nNearDist, int nMaxNonBlack,
+                             bool bNearWhite, const Colors &oColors,
+                             int *panLastLineCounts,
+                             std::vector<int> &anLineCounts, int nStepLines,
+                             bool bBottomUp, int iFirstLineFromTopOrBottom,
+                             CPLJobQueue *poJobQueue, int nThreads)
+{
+    const size_t nLineSize = static_cast<size_t>(nXSize) * nDstBands;
+    const auto GetRow = [bBottomUp, nLines](int k)
+    { return static_cast<size_t>(bBottomUp ? nLines - 1 - k : k); };
+
+    for (int kStart = 0; kStart < nLines; kStart += nStepLines)
+    {
+        const int kEnd = std::min(nLines, kStart + nStepLines);
+
+        const auto VerticalCheck = [&](int iXStart, int iXEnd)
+        {
+            for (int k = kStart; k < kEnd; ++k)
+            {
+                const size_t iRow = GetRow(k);
+                ProcessLine(pabyChunk + iRow * nLineSize +
+                                static_cast<size_t>(iXStart) * nDstBands,
+                            pabyMaskChunk
+                                ? pabyMaskChunk + iRow * nXSize + iXStart
+                                : nullptr,
+                            0, iXEnd - iXStart - 1, nSrcBands, nDstBands,
+                            nNearDist, nMaxNonBlack, bNearWhite, oColors,
+                            panLastLineCounts + iXStart,
+                            false,  // bDoHorizontalCheck
+                            true,   // bDoVerticalCheck
+                            bBottomUp, iFirstLineFromTopOrBottom + k);
+                memcpy(anLineCounts.data() +
+                           static_cast<size_t>(k - kStart) * nXSize + iXStart,
+                       panLastLineCounts + iXStart,
+                       sizeof(int) * (iXEnd - iXStart));
+            }
+        };
+
+        const auto HorizontalCheck = [&](int kLineStart, int kLineEnd)
+        {
+            for (int k = kStart + kLineStart; k < kStart + kLineEnd; ++k)
+            {
+                const size_t iRow = GetRow(k);
+                GByte *pabyLine = pabyChunk + iRow * nLineSize;
+                GByte *pabyMask =
+                    pabyMaskChunk ? pabyMaskChunk + iRow * nXSize : nullptr;
+                int *panCounts = anLineCounts.data() +
+                                 static_cast<size_t>(k - kStart) * nXSize;
+                ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nSrcBands,
+                            nDstBands, nNearDist, nMaxNonBlack, bNearWhite,
+                            oColors, panCounts,
+                            true,   // bDoHorizontalCheck
+                            false,  // bDoVerticalCheck
+                            bBottomUp, iFirstLineFromTopOrBottom + k);
+                ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nSrcBands,
+                            nDstBands, nNearDist, nMaxNonBlack, bNearWhite,
+                            oColors, panCounts,
+                            true,   // bDoHorizontalCheck
+                            false,  // bDoVerticalCheck
+                            bBottomUp, iFirstLineFromTopOrBottom + k);
+            }
+        };
+
+        if (poJobQueue)
+        {
+            GDALNearblackRunParallel(poJobQueue, nThreads, nXSize,
+                                     VerticalCheck);
+            GDALNearblackRunParallel(poJobQueue, nThreads, kEnd - kStart,
+                                     HorizontalCheck);
+        }
+        else
+        {
+            VerticalCheck(0, nXSize);
+            HorizontalCheck(0, kEnd - kStart);
+        }
+    }
+}
+
 /************************************************************************/
 /*                   GDALNearblackTwoPassesAlgorithm()                  */
 /*                                                                      */
@@ -355,95 +493,177 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     const bool bSetAlpha = psOptions->bSetAlpha;
 
     /* -------------------------------------------------------------------- */
-    /*      Allocate a line buffer.                                         */
+    /*      Determine the chunk size. Chunks are made of whole blocks of    */
+    /*      the source dataset when possible.                               */
     /* -------------------------------------------------------------------- */
+    const size_t nLineSize = static_cast<size_t>(nXSize) * nDstBands;
+    const size_t nBytesPerLine = nLineSize + (bSetMask ? nXSize : 0);
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GDALGetBlockSize(GDALGetRasterBand(hSrcDataset, 1), &nBlockXSize,
+                     &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+
+    constexpr size_t CHUNK_MAX_BYTES = 32 * 1024 * 1024;
+    const int nLinesInBudget = static_cast<int>(std::min<size_t>(
+        nYSize, std::max<size_t>(1, CHUNK_MAX_BYTES / nBytesPerLine)));
+    const int nChunkLines = nLinesInBudget >= nBlockYSize
+                                ? (nLinesInBudget / nBlockYSize) * nBlockYSize
+                                : nLinesInBudget;
+    const int nChunks = DIV_ROUND_UP(nYSize, nChunkLines);
+
+    // Number of lines processed between two synchronizations of the worker
+    // threads, bounded by the size of the per-line counts buffer.
+    constexpr size_t COUNTS_MAX_BYTES = 16 * 1024 * 1024;
+    const int nStepLines = static_cast<int>(std::min<size_t>(
+        256, std::max<size_t>(1, COUNTS_MAX_BYTES / (sizeof(int) * nXSize))));
 
-    std::vector<GByte> abyLine(nXSize * nDstBands);
-    GByte *pabyLine = abyLine.data();
-
-    std::vector<GByte> abyMask;
-    GByte *pabyMask = nullptr;
-    if (bSetMask)
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers. If the whole image fits within the   */
+    /*      block cache size, keep it in memory between the two passes,    */
+    /*      so that the source is read once and the output written once.   */
+    /* -------------------------------------------------------------------- */
+    std::vector<GByte> abyBuffer;
+    std::vector<GByte> abyMaskBuffer;
+    std::vector<int> anLastLineCounts;
+    std::vector<int> anLineCounts;
+
+    bool bInMemory = false;
+    const GUIntBig nImageBytes = static_cast<GUIntBig>(nBytesPerLine) * nYSize;
+    if (nImageBytes <= static_cast<GUIntBig>(GDALGetCacheMax64()) &&
+        nImageBytes <= std::numeric_limits<size_t>::max())
     {
-        abyMask.resize(nXSize);
-        pabyMask = abyMask.data();
+        try
+        {
+            abyBuffer.resize(nLineSize * nYSize);
+            if (bSetMask)
+                abyMaskBuffer.resize(static_cast<size_t>(nXSize) * nYSize);
+            bInMemory = true;
+        }
+        catch (const std::exception &)
+        {
+            abyBuffer.clear();
+            abyMaskBuffer.clear();
+        }
     }
 
-    std::vector<int> anLastLineCounts(nXSize);
+    try
+    {
+        if (!bInMemory)
+        {
+            abyBuffer.resize(nLineSize * nChunkLines);
+            if (bSetMask)
+                abyMaskBuffer.resize(static_cast<size_t>(nXSize) *
+                                     nChunkLines);
+        }
+        anLastLineCounts.resize(nXSize);
+        anLineCounts.resize(static_cast<size_t>(nXSize) * nStepLines);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers: %s", e.what());
+        return false;
+    }
     int *panLastLineCounts = anLastLineCounts.data();
 
-    /* -------------------------------------------------------------------- */
-    /*      Processing data one line at a time.                             */
-    /* -------------------------------------------------------------------- */
-    int iLine;
+    const int nThreads = std::min(
+        GDALGetNumThreads(nullptr, nullptr, /* nMaxThreads = */ 128), nXSize);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue =
+        poThreadPool ? poThreadPool->CreateJobQueue()
+                     : std::unique_ptr<CPLJobQueue>(nullptr);
 
-    for (iLine = 0; iLine < nYSize; iLine++)
+    const auto GetChunk = [&](int iChunk, int &nYOff, int &nLines,
+                              GByte *&pabyChunk, GByte *&pabyMaskChunk)
+    {
+        nYOff = iChunk * nChunkLines;
+        nLines = std::min(nChunkLines, nYSize - nYOff);
+        const size_t nOffset = bInMemory ? static_cast<size_t>(nYOff) : 0;
+        pabyChunk = abyBuffer.data() + nOffset * nLineSize;
+        pabyMaskChunk =
+            bSetMask ? abyMaskBuffer.data() + nOffset * nXSize : nullptr;
+    };
+
+    const auto WriteChunk = [&](int nYOff, int nLines, GByte *pabyChunk,
+                                GByte *pabyMaskChunk)
     {
         CPLErr eErr = GDALDatasetRasterIO(
-            hSrcDataset, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1,
-            GDT_Byte, nBands, nullptr, nDstBands, nXSize * nDstBands, 1);
+            hDstDS, GF_Write, 0, nYOff, nXSize, nLines, pabyChunk, nXSize,
+            nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+            static_cast<int>(nLineSize), 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        if (bSetAlpha)
-        {
-            for (int iCol = 0; iCol < nXSize; iCol++)
-            {
-                pabyLine[iCol * nDstBands + nDstBands - 1] = 255;
-            }
-        }
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, nYOff, nXSize, nLines,
+                                pabyMaskChunk, nXSize, nLines, GDT_Byte, 0, 0);
+            if (eErr != CE_None)
             {
-                pabyMask[iCol] = 255;
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "ERROR writing out line to mask band.");
+                return false;
             }
         }
+        return true;
+    };
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    true,   // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+    /* -------------------------------------------------------------------- */
+    /*      Process from the top down, one chunk of lines at a time.        */
+    /* -------------------------------------------------------------------- */
+    for (int iChunk = 0; iChunk < nChunks; iChunk++)
+    {
+        int nYOff = 0;
+        int nLines = 0;
+        GByte *pabyChunk = nullptr;
+        GByte *pabyMaskChunk = nullptr;
+        GetChunk(iChunk, nYOff, nLines, pabyChunk, pabyMaskChunk);
 
+        CPLErr eErr = GDALDatasetRasterIO(
+            hSrcDataset, GF_Read, 0, nYOff, nXSize, nLines, pabyChunk, nXSize,
+            nLines, GDT_Byte, nBands, nullptr, nDstBands,
+            static_cast<int>(nLineSize), 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
-
-        if (bSetMask)
+        const size_t nPixels = static_cast<size_t>(nXSize) * nLines;
+        if (bSetAlpha)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
-            if (eErr != CE_None)
+            for (size_t iPixel = 0; iPixel < nPixels; iPixel++)
             {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "ERROR writing out line to mask band.");
-                return false;
+                pabyChunk[iPixel * nDstBands + nDstBands - 1] = 255;
             }
         }
 
+        if (bSetMask)
+        {
+            memset(pabyMaskChunk, 255, nPixels);
+        }
+
+        ProcessLineChunk(pabyChunk, pabyMaskChunk, nXSize, nLines, nBands,
+                         nDstBands, nNearDist, nMaxNonBlack, bNearWhite,
+                         oColors, panLastLineCounts, anLineCounts, nStepLines,
+                         false,  // bBottomUp
+                         nYOff, poJobQueue.get(), nThreads);
+
+        if (!bInMemory &&
+            !WriteChunk(nYOff, nLines, pabyChunk, pabyMaskChunk))
+        {
+            return false;
+        }
+
         if (!(psOptions->pfnProgress(
-                0.5 * ((iLine + 1) / static_cast<double>(nYSize)), nullptr,
-                psOptions->pProgressData)))
+                0.5 * ((nYOff + nLines) / static_cast<double>(nYSize)),
+                nullptr, psOptions->pProgressData)))
         {
             return false;
         }
@@ -454,64 +674,51 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     /* -------------------------------------------------------------------- */
     memset(panLastLineCounts, 0, sizeof(int) * nXSize);
 
-    for (iLine = nYSize - 1; hDstDS != nullptr && iLine >= 0; iLine--)
+    for (int iChunk = nChunks - 1; iChunk >= 0; iChunk--)
     {
-        CPLErr eErr = GDALDatasetRasterIO(
-            hDstDS, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1, GDT_Byte,
-            nDstBands, nullptr, nDstBands, nXSize * nDstBands, 1);
-        if (eErr != CE_None)
-        {
-            return false;
-        }
-
-        /***** read the mask band line back in *****/
+        int nYOff = 0;
+        int nLines = 0;
+        GByte *pabyChunk = nullptr;
+        GByte *pabyMaskChunk = nullptr;
+        GetChunk(iChunk, nYOff, nLines, pabyChunk, pabyMaskChunk);
 
-        if (bSetMask)
+        if (!bInMemory)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            CPLErr eErr = GDALDatasetRasterIO(
+                hDstDS, GF_Read, 0, nYOff, nXSize, nLines, pabyChunk, nXSize,
+                nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+                static_cast<int>(nLineSize), 1);
             if (eErr != CE_None)
             {
                 return false;
             }
-        }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,  // bDoHorizontalCheck
-                    true,  // bDoVerticalCheck
-                    true,  // bBottomUp
-                    nYSize - 1 - iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    true,   // bBottomUp
-                    nYSize - 1 - iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
-        if (eErr != CE_None)
-        {
-            return false;
+            /***** read the mask band lines back in *****/
+
+            if (bSetMask)
+            {
+                eErr = GDALRasterIO(hMaskBand, GF_Read, 0, nYOff, nXSize,
+                                    nLines, pabyMaskChunk, nXSize, nLines,
+                                    GDT_Byte, 0, 0);
+                if (eErr != CE_None)
+                {
+                    return false;
+                }
+            }
         }
 
-        /***** write out the mask band line *****/
+        ProcessLineChunk(pabyChunk, pabyMaskChunk, nXSize, nLines, nBands,
+                         nDstBands, nNearDist, nMaxNonBlack, bNearWhite,
+                         oColors, panLastLineCounts, anLineCounts, nStepLines,
+                         true,  // bBottomUp
+                         nYSize - nYOff - nLines, poJobQueue.get(), nThreads);
 
-        if (bSetMask)
+        if (!WriteChunk(nYOff, nLines, pabyChunk, pabyMaskChunk))
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
-            if (eErr != CE_None)
-            {
-                return false;
-            }
+            return false;
         }
 
-        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - iLine) /
+        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - nYOff) /
                                                static_cast<double>(nYSize),
                                      nullptr, psOptions->pProgressData)))
         {
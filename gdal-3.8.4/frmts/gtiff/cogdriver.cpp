@@ -66,17 +66,44 @@ static bool HasZSTDCompression()
     return bHasZSTD;
 }
 
+/************************************************************************/
+/*                          CanUseInMemoryTmp()                         */
+/************************************************************************/
+
+// Returns whether a temporary file whose uncompressed content is dfBytes
+// large can be kept in memory, given that dfBytesInMemory are already used
+// by other in-memory temporary files. The limit is set by the
+// COG_TMP_MAX_MEMORY configuration option, in bytes. It defaults to the part
+// of the block cache size that is not used yet, so that the temporary files
+// and the block cache together stay within the cache size, as much as
+// possible.
+static bool CanUseInMemoryTmp(double dfBytes, double dfBytesInMemory = 0)
+{
+    const char *pszMaxMemory =
+        CPLGetConfigOption("COG_TMP_MAX_MEMORY", nullptr);
+    const double dfMaxMemory =
+        pszMaxMemory ? CPLAtof(pszMaxMemory)
+                     : static_cast<double>(GDALGetCacheMax64()) -
+                           static_cast<double>(GDALGetCacheUsed64());
+    return dfBytes + dfBytesInMemory <= dfMaxMemory;
+}
+
 /************************************************************************/
 /*                           GetTmpFilename()                           */
 /************************************************************************/
 
-static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
+static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                                bool bInMemory = false)
 {
-    const bool bSupportsRandomWrite =
-        VSISupportsRandomWrite(pszFilename, false);
     CPLString osTmpFilename;
-    if (!bSupportsRandomWrite ||
-        CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
+    if (bInMemory)
+    {
+        osTmpFilename = "/vsimem/";
+        osTmpFilename += CPLGetFilename(
+            CPLGenerateTempFilename(CPLGetBasename(pszFilename)));
+    }
+    else if (!VSISupportsRandomWrite(pszFilename, false) ||
+             CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
     {
         osTmpFilename = CPLGenerateTempFilename(CPLGetBasename(pszFilename));
     }
@@ -590,28 +617,39 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     const char *const *papszOptions, const CPLString &osResampling,
     const CPLString &osTargetSRS, const int nXSize, const int nYSize,
     const double dfMinX, const double dfMinY, const double dfMaxX,
-    const double dfMaxY, const double dfRes, GDALProgressFunc pfnProgress,
-    void *pProgressData, double &dfCurPixels, double &dfTotalPixelsToProcess)
+    const double dfMaxY, const double dfRes, bool bStreaming,
+    GDALProgressFunc pfnProgress, void *pProgressData, double &dfCurPixels,
+    double &dfTotalPixelsToProcess)
 {
     char **papszArg = nullptr;
-    // We could have done a warped VRT, but overview building on it might be
-    // slow, so materialize as GTiff
-    papszArg = CSLAddString(papszArg, "-of");
-    papszArg = CSLAddString(papszArg, "GTiff");
-    papszArg = CSLAddString(papszArg, "-co");
-    papszArg = CSLAddString(papszArg, "TILED=YES");
-    papszArg = CSLAddString(papszArg, "-co");
-    papszArg = CSLAddString(papszArg, "SPARSE_OK=YES");
-    const char *pszBIGTIFF = CSLFetchNameValue(papszOptions, "BIGTIFF");
-    if (pszBIGTIFF)
+    if (bStreaming)
     {
+        // Warp on the fly, so that no temporary file is written.
+        papszArg = CSLAddString(papszArg, "-of");
+        papszArg = CSLAddString(papszArg, "VRT");
+    }
+    else
+    {
+        // We could have done a warped VRT, but overview building on it might
+        // be slow, so materialize as GTiff
+        papszArg = CSLAddString(papszArg, "-of");
+        papszArg = CSLAddString(papszArg, "GTiff");
+        papszArg = CSLAddString(papszArg, "-co");
+        papszArg = CSLAddString(papszArg, "TILED=YES");
+        papszArg = CSLAddString(papszArg, "-co");
+        papszArg = CSLAddString(papszArg, "SPARSE_OK=YES");
+        const char *pszBIGTIFF = CSLFetchNameValue(papszOptions, "BIGTIFF");
+        if (pszBIGTIFF)
+        {
+            papszArg = CSLAddString(papszArg, "-co");
+            papszArg = CSLAddString(
+                papszArg, (CPLString("BIGTIFF=") + pszBIGTIFF).c_str());
+        }
         papszArg = CSLAddString(papszArg, "-co");
-        papszArg = CSLAddString(papszArg,
-                                (CPLString("BIGTIFF=") + pszBIGTIFF).c_str());
+        papszArg = CSLAddString(papszArg, HasZSTDCompression()
+                                              ? "COMPRESS=ZSTD"
+                                              : "COMPRESS=LZW");
     }
-    papszArg = CSLAddString(papszArg, "-co");
-    papszArg = CSLAddString(papszArg, HasZSTDCompression() ? "COMPRESS=ZSTD"
-                                                           : "COMPRESS=LZW");
     papszArg = CSLAddString(papszArg, "-t_srs");
     papszArg = CSLAddString(papszArg, osTargetSRS);
     papszArg = CSLAddString(papszArg, "-te");
@@ -668,17 +706,29 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
         CSLFetchNameValueDef(papszOptions, "OVERVIEWS", "AUTO");
     const bool bUseExistingOrNone = EQUAL(pszOverviews, "FORCE_USE_EXISTING") ||
                                     EQUAL(pszOverviews, "NONE");
-    dfTotalPixelsToProcess =
-        double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) +
-        ((bHasMask && !bUseExistingOrNone) ? double(nXSize) * nYSize / 3 : 0) +
-        (!bUseExistingOrNone ? double(nXSize) * nYSize * nBands / 3 : 0) +
-        double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) * 4. / 3;
 
     auto psOptions = GDALWarpAppOptionsNew(papszArg, nullptr);
     CSLDestroy(papszArg);
     if (psOptions == nullptr)
         return nullptr;
 
+    auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
+    if (bStreaming)
+    {
+        // Nothing is computed at that point, so progress is left to the
+        // final copy.
+        CPLDebug("COG", "Creating warped VRT");
+        auto hRet = GDALWarp("", nullptr, 1, &hSrcDS, psOptions, nullptr);
+        GDALWarpAppOptionsFree(psOptions);
+        return std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(hRet));
+    }
+
+    dfTotalPixelsToProcess =
+        double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) +
+        ((bHasMask && !bUseExistingOrNone) ? double(nXSize) * nYSize / 3 : 0) +
+        (!bUseExistingOrNone ? double(nXSize) * nYSize * nBands / 3 : 0) +
+        double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) * 4. / 3;
+
     const double dfNextPixels =
         double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0));
     void *pScaledProgress = GDALCreateScaledProgress(
@@ -689,8 +739,12 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     CPLDebug("COG", "Reprojecting source dataset: start");
     GDALWarpAppOptionsSetProgress(psOptions, GDALScaledProgress,
                                   pScaledProgress);
-    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp"));
-    auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
+    // Keep the warped dataset in memory if it is small enough
+    const double dfWarpedBytes =
+        double(nXSize) * nYSize * (nBands + 1) *
+        GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType());
+    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp",
+                                       CanUseInMemoryTmp(dfWarpedBytes)));
 
     std::unique_ptr<CPLConfigOptionSetter> poWarpThreadSetter;
     if (pszNumThreads)
@@ -741,7 +795,9 @@ GDALCOGCreator::~GDALCOGCreator()
     {
         CPLString osProjectedDSName(m_poReprojectedDS->GetDescription());
         m_poReprojectedDS.reset();
-        VSIUnlink(osProjectedDSName);
+        // Empty for the warped VRT of streaming mode
+        if (!osProjectedDSName.empty())
+            VSIUnlink(osProjectedDSName);
     }
     if (!m_osTmpOverviewFilename.empty())
     {
@@ -800,6 +856,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         bRemoveStats = true;
     }
 
+    // In streaming mode, no temporary file is written: the reprojection and
+    // the overviews are computed on the fly while the final file is written.
+    const bool bStreaming = CPLFetchBool(papszOptions, "STREAMING", false);
+
     double dfCurPixels = 0;
     double dfTotalPixelsToProcess = 0;
     GDALDataset *poCurDS = poSrcDS;
@@ -873,8 +933,9 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
             m_poReprojectedDS = CreateReprojectedDS(
                 pszFilename, poCurDS, papszOptions, osTargetResampling,
                 osTargetSRS, nTargetXSize, nTargetYSize, dfTargetMinX,
-                dfTargetMinY, dfTargetMaxX, dfTargetMaxY, dfRes, pfnProgress,
-                pProgressData, dfCurPixels, dfTotalPixelsToProcess);
+                dfTargetMinY, dfTargetMaxX, dfTargetMaxY, dfRes, bStreaming,
+                pfnProgress, pProgressData, dfCurPixels,
+                dfTotalPixelsToProcess);
             if (!m_poReprojectedDS)
                 return nullptr;
             poCurDS = m_poReprojectedDS.get();
@@ -1009,13 +1070,13 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     const int nOverviewCount =
         atoi(CSLFetchNameValueDef(papszOptions, "OVERVIEW_COUNT", "-1"));
 
-    const bool bGenerateMskOvr =
+    bool bGenerateMskOvr =
         !bUseExistingOrNone && bHasMask &&
         (nXSize > nOvrThresholdSize || nYSize > nOvrThresholdSize ||
          nOverviewCount > 0) &&
         (EQUAL(osOverviews, "IGNORE_EXISTING") ||
          poFirstBand->GetMaskBand()->GetOverviewCount() == 0);
-    const bool bGenerateOvr =
+    bool bGenerateOvr =
         !bUseExistingOrNone &&
         (nXSize > nOvrThresholdSize || nYSize > nOvrThresholdSize ||
          nOverviewCount > 0) &&
@@ -1101,6 +1162,75 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         }
     }
 
+    const char *pszOvrResampling = CSLFetchNameValueDef(
+        papszOptions, "OVERVIEW_RESAMPLING",
+        CSLFetchNameValueDef(papszOptions, "RESAMPLING",
+                             GetResampling(poSrcDS)));
+
+    if (bStreaming && bGenerateOvr)
+    {
+        // Expose the overviews as virtual overviews of a VRT of the full
+        // resolution dataset. Each overview level is then computed from the
+        // full resolution when it is copied into the final file, and the
+        // mask overviews are nearest-neighbour subsampled.
+        // Virtual overviews are sized by integer decimation factors, so the
+        // dimensions of the overviews must match them.
+        std::vector<int> anOvrFactors;
+        for (const auto &oDim : asOverviewDims)
+        {
+            const int nFactor =
+                anOvrFactors.size() < 30 ? 2 << anOvrFactors.size() : 0;
+            if (nFactor == 0 || nXSize / nFactor != oDim.first ||
+                nYSize / nFactor != oDim.second)
+            {
+                anOvrFactors.clear();
+                break;
+            }
+            anOvrFactors.push_back(nFactor);
+        }
+
+        // Nested in-memory VRTs would be seen as a recursion when reading
+        // the virtual overviews.
+        const auto poSrcDriver = poSrcDS->GetDriver();
+        const bool bSrcIsInMemoryVRT =
+            !m_poReprojectedDS && poSrcDriver &&
+            EQUAL(poSrcDriver->GetDescription(), "VRT") &&
+            poSrcDS->GetDescription()[0] == '\0';
+
+        if (anOvrFactors.empty() || bSrcIsInMemoryVRT)
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "STREAMING=YES cannot be honored for overviews of this "
+                     "dataset. They will be generated in temporary files");
+        }
+        else
+        {
+            // Do not modify the source dataset
+            if (poCurDS != m_poRGBMaskDS.get() &&
+                poCurDS != m_poVRTWithOrWithoutStats.get() &&
+                !CreateVRTWithOrWithoutStats())
+            {
+                return nullptr;
+            }
+
+            const char *const apszOptions[] = {"VRT_VIRTUAL_OVERVIEWS=YES",
+                                               nullptr};
+            if (poCurDS->BuildOverviews(
+                    pszOvrResampling, static_cast<int>(anOvrFactors.size()),
+                    anOvrFactors.data(), 0, nullptr, nullptr, nullptr,
+                    apszOptions) != CE_None ||
+                poCurDS->GetRasterBand(1)->GetOverviewCount() !=
+                    static_cast<int>(anOvrFactors.size()))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot create virtual overviews");
+                return nullptr;
+            }
+            bGenerateOvr = false;
+            bGenerateMskOvr = false;
+        }
+    }
+
     if (dfTotalPixelsToProcess == 0.0)
     {
         dfTotalPixelsToProcess =
@@ -1119,15 +1249,38 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     aosOverviewOptions.SetNameValue("BIGTIFF", "YES");
     aosOverviewOptions.SetNameValue("SPARSE_OK", "YES");
 
+    // Keep the temporary overview files in memory if they are small enough,
+    // to avoid writing them to disk and reading them back.
+    double dfOverviewPixels = 0;
+    for (const auto &oDim : asOverviewDims)
+        dfOverviewPixels += double(oDim.first) * oDim.second;
+    // The reprojected dataset, if any, is still used at that point.
+    double dfBytesInMemory = 0;
+    VSIStatBufL sStat;
+    if (m_poReprojectedDS &&
+        STARTS_WITH(m_poReprojectedDS->GetDescription(), "/vsimem/") &&
+        VSIStatL(m_poReprojectedDS->GetDescription(), &sStat) == 0)
+    {
+        dfBytesInMemory = static_cast<double>(sStat.st_size);
+    }
+    const bool bInMemoryOvrTmp = CanUseInMemoryTmp(
+        (bGenerateMskOvr ? dfOverviewPixels : 0) +
+            (bGenerateOvr ? dfOverviewPixels * nBands *
+                                GDALGetDataTypeSizeBytes(
+                                    poFirstBand->GetRasterDataType())
+                          : 0),
+        dfBytesInMemory);
+    if (bInMemoryOvrTmp && (bGenerateMskOvr || bGenerateOvr))
+    {
+        CPLDebug("COG", "Temporary overview files kept in memory");
+    }
+
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename =
+            GetTmpFilename(pszFilename, "msk.ovr.tmp", bInMemoryOvrTmp);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
-        const char *pszResampling = CSLFetchNameValueDef(
-            papszOptions, "OVERVIEW_RESAMPLING",
-            CSLFetchNameValueDef(papszOptions, "RESAMPLING",
-                                 GetResampling(poSrcDS)));
 
         double dfNextPixels = dfCurPixels + double(nXSize) * nYSize / 3;
         void *pScaledProgress = GDALCreateScaledProgress(
@@ -1138,7 +1291,7 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         CPLErr eErr = GTIFFBuildOverviewsEx(
             m_osTmpMskOverviewFilename, 1, &poSrcMask,
             static_cast<int>(asOverviewDims.size()), nullptr,
-            asOverviewDims.data(), pszResampling, aosOverviewOptions.List(),
+            asOverviewDims.data(), pszOvrResampling, aosOverviewOptions.List(),
             GDALScaledProgress, pScaledProgress);
         CPLDebug("COG", "Generating overviews of the mask: end");
 
@@ -1152,14 +1305,11 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename =
+            GetTmpFilename(pszFilename, "ovr.tmp", bInMemoryOvrTmp);
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
-        const char *pszResampling = CSLFetchNameValueDef(
-            papszOptions, "OVERVIEW_RESAMPLING",
-            CSLFetchNameValueDef(papszOptions, "RESAMPLING",
-                                 GetResampling(poSrcDS)));
 
         double dfNextPixels =
             dfCurPixels + double(nXSize) * nYSize * nBands / 3;
@@ -1180,7 +1330,7 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         CPLErr eErr = GTIFFBuildOverviewsEx(
             m_osTmpOverviewFilename, nBands, &apoSrcBands[0],
             static_cast<int>(asOverviewDims.size()), nullptr,
-            asOverviewDims.data(), pszResampling, aosOverviewOptions.List(),
+            asOverviewDims.data(), pszOvrResampling, aosOverviewOptions.List(),
             GDALScaledProgress, pScaledProgress);
         CPLDebug("COG", "Generating overviews of the imagery: end");
 
@@ -1617,6 +1767,9 @@ void GDALCOGDriver::InitializeCreationOptionList()
         "       <Value>YES</Value>"
         "       <Value>NO</Value>"
         "   </Option>"
+        "   <Option name='STREAMING' type='boolean' description='Whether to "
+        "compute reprojection and overviews on the fly while writing the "
+        "output file, instead of using temporary files' default='NO'/>"
         "</CreationOptionList>";
 
     SetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST, osOptions.c_str());
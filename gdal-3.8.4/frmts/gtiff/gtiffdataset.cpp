@@ -500,6 +500,16 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         if (nErr >= 0)
             return static_cast<CPLErr>(nErr);
     }
+    if (eRWFlag == GF_Read && nBufXSize == nXSize && nBufYSize == nYSize)
+    {
+        // Reading exactly one tile/strip with the right data type and layout:
+        // decode it directly into the user buffer.
+        const int nErr = WholeBlockDecodeIO(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType, nBandCount,
+            panBandMap, nPixelSpace, nLineSpace, nBandSpace);
+        if (nErr >= 0)
+            return static_cast<CPLErr>(nErr);
+    }
 
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     bool bCanUseMultiThreadedRead = false;
@@ -521,6 +531,16 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             bCanUseMultiThreadedRead = true;
         }
     }
+    else if (eRWFlag == GF_Read &&
+             (nBufXSize != nXSize || nBufYSize != nYSize) &&
+             !(eAccess == GA_ReadOnly && HasOptimizedReadMultiRange() &&
+               !VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF))->HasPRead()))
+    {
+        // Resampled requests go through the block cache: decode the
+        // intersecting tiles/strips in parallel beforehand.
+        MultiThreadedPopulateBlockCache(nXOff, nYOff, nXSize, nYSize,
+                                        nBandCount, panBandMap);
+    }
 #endif
 
     void *pBufferedData = nullptr;
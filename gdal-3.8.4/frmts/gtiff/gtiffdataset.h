@@ -395,6 +395,11 @@ class GTiffDataset final : public GDALPamDataset
                      GSpacing nPixelSpace, GSpacing nLineSpace,
                      GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg);
 
+    int WholeBlockDecodeIO(int nXOff, int nYOff, int nXSize, int nYSize,
+                           void *pData, GDALDataType eBufType, int nBandCount,
+                           const int *panBandMap, GSpacing nPixelSpace,
+                           GSpacing nLineSpace, GSpacing nBandSpace);
+
     void SetStructuralMDFromParent(GTiffDataset *poParentDS);
 
     template <class FetchBuffer>
@@ -469,6 +474,9 @@ class GTiffDataset final : public GDALPamDataset
                              void *pData, GDALDataType eBufType, int nBandCount,
                              const int *panBandMap, GSpacing nPixelSpace,
                              GSpacing nLineSpace, GSpacing nBandSpace);
+    void MultiThreadedPopulateBlockCache(int nXOff, int nYOff, int nXSize,
+                                         int nYSize, int nBandCount,
+                                         const int *panBandMap);
 #endif
     virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              int nXSize, int nYSize, void *pData, int nBufXSize,
@@ -377,6 +377,7 @@ struct GTiffDecompressContext
     bool bHasPRead = false;
     bool bCacheAllBands = false;
     bool bSkipBlockCache = false;
+    bool bDirectDecode = false;
     bool bUseBIPOptim = false;
     bool bUseDeinterleaveOptimNoBlockCache = false;
     bool bUseDeinterleaveOptimBlockCache = false;
@@ -483,6 +484,36 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
                    : ((psContext->nYOff + psContext->nYSize) %
                       poDS->m_nBlockYSize))
             : poDS->m_nBlockYSize;
+
+    const int nDTSize = GDALGetDataTypeSizeBytes(psContext->eDT);
+    GByte *pDstPtr = psContext->pabyData +
+                     nYOffsetInData * psContext->nLineSpace +
+                     nXOffsetInData * psContext->nPixelSpace;
+
+    // Request m_nBlockYSize line in the block, except on the bottom-most
+    // tile/strip.
+    const int nBlockReqYSize =
+        (psJob->nYBlock < poDS->m_nBlocksPerColumn - 1)
+            ? poDS->m_nBlockYSize
+        : (poDS->nRasterYSize % poDS->m_nBlockYSize) == 0
+            ? poDS->m_nBlockYSize
+            : poDS->nRasterYSize % poDS->m_nBlockYSize;
+
+    const size_t nReqSize = static_cast<size_t>(poDS->m_nBlockXSize) *
+                            nBlockReqYSize * nBandsPerStrile * nDTSize;
+
+    // If the job covers a whole tile/strip, decode it directly into the
+    // user buffer.
+    GByte *pabyDirectDst = nullptr;
+    if (psContext->bDirectDecode && nXOffsetInBlock == 0 &&
+        nYOffsetInBlock == 0 && nXSize == poDS->m_nBlockXSize &&
+        nYSize == nBlockReqYSize)
+    {
+        pabyDirectDst = poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG
+                            ? pDstPtr
+                            : pDstPtr + psJob->iDstBandIdxSeparate *
+                                            psContext->nBandSpace;
+    }
 #if 0
     CPLDebug("GTiff",
              "nXBlock = %d, nYBlock = %d, "
@@ -500,6 +531,9 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
             if (!psContext->bSuccess)
                 return;
         }
+        // Nothing to cache when only populating the block cache
+        if (psContext->pabyData == nullptr)
+            return;
         const double dfNoDataValue =
             poDS->m_bNoDataSet ? poDS->m_dfNoDataValue : 0;
         for (int y = 0; y < nYSize; ++y)
@@ -612,6 +646,37 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
         return true;
     };
 
+    if (pabyDirectDst && poDS->m_nCompression == COMPRESSION_NONE &&
+        !TIFFIsByteSwapped(poDS->m_hTIFF) && psJob->nSize >= nReqSize)
+    {
+        // Uncompressed strile: read it straight into the user buffer.
+        std::unique_lock<std::mutex> oLock(psContext->oMutex);
+        if (!psContext->bSuccess)
+            return;
+        if (psContext->bHasPRead)
+            oLock.unlock();
+        const bool bOK =
+            psContext->bHasPRead
+                ? psContext->poHandle->PRead(pabyDirectDst, nReqSize,
+                                             psJob->nOffset) == nReqSize
+                : (psContext->poHandle->Seek(psJob->nOffset, SEEK_SET) == 0 &&
+                   psContext->poHandle->Read(pabyDirectDst, nReqSize, 1) == 1);
+        if (oLock.owns_lock())
+            oLock.unlock();
+        if (!bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot read " CPL_FRMT_GUIB
+                     " bytes at offset " CPL_FRMT_GUIB,
+                     static_cast<GUIntBig>(nReqSize),
+                     static_cast<GUIntBig>(psJob->nOffset));
+
+            std::lock_guard<std::mutex> oLockError(psContext->oMutex);
+            psContext->bSuccess = false;
+        }
+        return;
+    }
+
     if (psContext->bHasPRead)
     {
         {
@@ -690,11 +755,6 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
         }
     }
 
-    const int nDTSize = GDALGetDataTypeSizeBytes(psContext->eDT);
-    GByte *pDstPtr = psContext->pabyData +
-                     nYOffsetInData * psContext->nLineSpace +
-                     nXOffsetInData * psContext->nPixelSpace;
-
     if (nAlreadyLoadedBlocks != nBandsToCache)
     {
         // Generate a dummy in-memory TIFF file that has all the needed tags
@@ -762,23 +822,23 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
         poDS->RestoreVolatileParameters(hTIFFTmp);
 
         bool bRet = true;
-        // Request m_nBlockYSize line in the block, except on the bottom-most
-        // tile/strip.
-        const int nBlockReqYSize =
-            (psJob->nYBlock < poDS->m_nBlocksPerColumn - 1)
-                ? poDS->m_nBlockYSize
-            : (poDS->nRasterYSize % poDS->m_nBlockYSize) == 0
-                ? poDS->m_nBlockYSize
-                : poDS->nRasterYSize % poDS->m_nBlockYSize;
-
-        const size_t nReqSize = static_cast<size_t>(poDS->m_nBlockXSize) *
-                                nBlockReqYSize * nBandsPerStrile * nDTSize;
-
         GByte *pabyOutput;
         std::vector<GByte> abyOutput;
-        if (poDS->m_nCompression == COMPRESSION_NONE &&
-            !TIFFIsByteSwapped(poDS->m_hTIFF) && abyInput.size() >= nReqSize &&
-            (psContext->bSkipBlockCache || nBandsPerStrile > 1))
+        if (pabyDirectDst)
+        {
+            pabyOutput = pabyDirectDst;
+            if (!TIFFReadFromUserBuffer(hTIFFTmp, 0, abyInput.data(),
+                                        abyInput.size(), pabyOutput,
+                                        nReqSize) &&
+                !poDS->m_bIgnoreReadErrors)
+            {
+                bRet = false;
+            }
+        }
+        else if (poDS->m_nCompression == COMPRESSION_NONE &&
+                 !TIFFIsByteSwapped(poDS->m_hTIFF) &&
+                 abyInput.size() >= nReqSize &&
+                 (psContext->bSkipBlockCache || nBandsPerStrile > 1))
         {
             pabyOutput = abyInput.data();
         }
@@ -812,6 +872,9 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
             return;
         }
 
+        if (pabyDirectDst)
+            return;
+
         if (!psContext->bSkipBlockCache && nBandsPerStrile > 1)
         {
             // Copy pixel-interleaved all-band buffer to cached blocks
@@ -850,6 +913,10 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
             }
         }
 
+        // Only populating the block cache ?
+        if (psContext->pabyData == nullptr)
+            return;
+
         const GByte *pSrcPtr =
             pabyOutput +
             (static_cast<size_t>(nYOffsetInBlock) * poDS->m_nBlockXSize +
@@ -930,6 +997,9 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
 
     CPLAssert(!psContext->bSkipBlockCache);
 
+    if (psContext->pabyData == nullptr)
+        return;
+
     // Compose cached blocks into final buffer
     for (int i = 0; i < nBandsToWrite; ++i)
     {
@@ -981,6 +1051,9 @@ bool GTiffDataset::IsMultiThreadedReadCompatible() const
 
 /************************************************************************/
 /*                        MultiThreadedRead()                           */
+/*                                                                      */
+/*      If pData is null, the tiles/strips intersecting the window are  */
+/*      just decoded into the block cache.                              */
 /************************************************************************/
 
 CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
@@ -1040,7 +1113,12 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     sContext.nPredictor = PREDICTOR_NONE;
     sContext.nBlocksPerRow = m_nBlocksPerRow;
 
-    if (m_bDirectIO)
+    const bool bPopulateBlockCacheOnly = pData == nullptr;
+    if (bPopulateBlockCacheOnly)
+    {
+        CPLAssert(!m_bDirectIO);
+    }
+    else if (m_bDirectIO)
     {
         sContext.bSkipBlockCache = true;
     }
@@ -1065,7 +1143,46 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
-    if (m_nPlanarConfig == PLANARCONFIG_CONTIG && nBandCount == nBands &&
+    // Check if the user buffer has the same layout as decoded tiles/strips,
+    // in which case they can be decoded directly into it.
+    const int nDTSize = GDALGetDataTypeSizeBytes(sContext.eDT);
+    bool bBufferHasStrileLayout =
+        eBufType == sContext.eDT && m_nBitsPerSample == nDTSize * 8;
+    if (bBufferHasStrileLayout && m_nPlanarConfig == PLANARCONFIG_CONTIG &&
+        nBands > 1)
+    {
+        bBufferHasStrileLayout = nBandCount == nBands &&
+                                 nPixelSpace == nBands * nDTSize &&
+                                 nBandSpace == nDTSize;
+        for (int i = 0; bBufferHasStrileLayout && i < nBands; ++i)
+        {
+            if (panBandMap[i] != i + 1)
+                bBufferHasStrileLayout = false;
+        }
+    }
+    else
+    {
+        bBufferHasStrileLayout =
+            bBufferHasStrileLayout && nPixelSpace == nDTSize;
+    }
+    bBufferHasStrileLayout = bBufferHasStrileLayout &&
+                             nLineSpace == nPixelSpace * m_nBlockXSize;
+
+    // A window made only of whole tiles/strips (typically a single column of
+    // tiles, or full-width lines of strips) can be decoded directly into the
+    // user buffer, without going through the block cache.
+    if (!bPopulateBlockCacheOnly && !sContext.bSkipBlockCache &&
+        bBufferHasStrileLayout && eAccess == GA_ReadOnly &&
+        (nXOff % m_nBlockXSize) == 0 && nXSize == m_nBlockXSize &&
+        (nYOff % m_nBlockYSize) == 0 &&
+        ((nYSize % m_nBlockYSize) == 0 || nYOff + nYSize == nRasterYSize))
+    {
+        sContext.bSkipBlockCache = true;
+    }
+    sContext.bDirectDecode = sContext.bSkipBlockCache && bBufferHasStrileLayout;
+
+    if (!bPopulateBlockCacheOnly && m_nPlanarConfig == PLANARCONFIG_CONTIG &&
+        nBandCount == nBands &&
         nPixelSpace == nBands * static_cast<GSpacing>(sContext.nBufDTSize))
     {
         sContext.bUseBIPOptim = true;
@@ -1196,6 +1313,10 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                 }
             }
         after_loop:
+            if (bUseBaseImplementation && bPopulateBlockCacheOnly)
+            {
+                return CE_None;
+            }
             if (bUseBaseImplementation)
             {
                 ++m_nDisableMultiThreadedRead;
@@ -1382,6 +1503,10 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
+    // Nothing to do if all blocks are already in the block cache
+    if (bPopulateBlockCacheOnly && nAdviseReadRanges == 0)
+        return CE_None;
+
     if (sContext.bSuccess)
     {
         // Potentially start asynchronous fetching of ranges depending on file
@@ -1416,6 +1541,56 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     return sContext.bSuccess ? CE_None : CE_Failure;
 }
 
+/************************************************************************/
+/*                    MultiThreadedPopulateBlockCache()                 */
+/*                                                                      */
+/*      For requests that go through the block cache (typically         */
+/*      resampled ones), decode the tiles/strips of the window in       */
+/*      parallel with the GDAL_NUM_THREADS pool beforehand, so that     */
+/*      the generic block based code finds them in cache.               */
+/************************************************************************/
+
+void GTiffDataset::MultiThreadedPopulateBlockCache(int nXOff, int nYOff,
+                                                   int nXSize, int nYSize,
+                                                   int nBandCount,
+                                                   const int *panBandMap)
+{
+    if (m_nDisableMultiThreadedRead != 0 || m_poThreadPool == nullptr ||
+        m_bDirectIO || !IsMultiThreadedReadCompatible())
+    {
+        return;
+    }
+
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nXBlocks = nBlockX2 - nBlockX1 + 1;
+    const int nYBlocks = nBlockY2 - nBlockY1 + 1;
+    const int nStrilePerBlock =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG ? 1 : nBandCount;
+    if (static_cast<GIntBig>(nXBlocks) * nYBlocks * nStrilePerBlock <= 1)
+        return;
+
+    // Blocks must be able to stay in cache until the generic code reads
+    // them. For pixel interleaved files, decoding a tile/strip caches the
+    // blocks of all bands, whatever the requested ones.
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const int nCachedBands =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG ? nBands : nBandCount;
+    const GIntBig nRequiredMem =
+        static_cast<GIntBig>(nXBlocks) * nYBlocks * m_nBlockXSize *
+        m_nBlockYSize * nCachedBands * GDALGetDataTypeSizeBytes(eDT);
+    if (nRequiredMem > GDALGetCacheMax64() / 2)
+        return;
+
+    // Errors, if any, will be reported by the regular code path.
+    CPLErrorStateBackuper oErrorStateBackuper;
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, nullptr, eDT, nBandCount,
+                      panBandMap, 0, 0, 0);
+}
+
 #endif  // SUPPORTS_GET_OFFSET_BYTECOUNT
 
 /************************************************************************/
@@ -3221,6 +3396,104 @@ bool GTiffDataset::ReadStrile(int nBlockId, void *pOutputBuffer,
     return true;
 }
 
+/************************************************************************/
+/*                         WholeBlockDecodeIO()                         */
+/*                                                                      */
+/*      Decode a single tile/strip straight into the user buffer,       */
+/*      without going through the block cache, when the request         */
+/*      exactly covers it and the buffer has the same layout as the     */
+/*      decoded strile.                                                 */
+/*      Returns -1 if the request is not eligible.                      */
+/************************************************************************/
+
+int GTiffDataset::WholeBlockDecodeIO(int nXOff, int nYOff, int nXSize,
+                                     int nYSize, void *pData,
+                                     GDALDataType eBufType, int nBandCount,
+                                     const int *panBandMap,
+                                     GSpacing nPixelSpace, GSpacing nLineSpace,
+                                     GSpacing nBandSpace)
+{
+    const auto poFirstBand = cpl::down_cast<GTiffRasterBand *>(papoBands[0]);
+    const GDALDataType eDT = poFirstBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+
+    // Restrict to read-only datasets, so that we don't have to care about
+    // dirty blocks or pending compression jobs.
+    if (eAccess != GA_ReadOnly || m_bStreamingIn ||
+        !poFirstBand->IsBaseGTiffClass() || eBufType != eDT ||
+        m_nBitsPerSample != nDTSize * 8 ||
+        !IsWholeBlock(nXOff, nYOff, nXSize, nYSize))
+    {
+        return -1;
+    }
+
+    const bool bContigMultiBand =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG && nBands > 1;
+    const int nBandsPerStrile = bContigMultiBand ? nBands : 1;
+    if (bContigMultiBand)
+    {
+        if (nBandCount != nBands || nBandSpace != nDTSize)
+            return -1;
+        for (int i = 0; i < nBands; ++i)
+        {
+            if (panBandMap[i] != i + 1)
+                return -1;
+        }
+    }
+    if (nPixelSpace != static_cast<GSpacing>(nDTSize) * nBandsPerStrile ||
+        nLineSpace != nPixelSpace * m_nBlockXSize)
+    {
+        return -1;
+    }
+
+    const GPtrDiff_t nBlockBufSize = static_cast<GPtrDiff_t>(
+        TIFFIsTiled(m_hTIFF) ? TIFFTileSize(m_hTIFF) : TIFFStripSize(m_hTIFF));
+    if (nBlockBufSize != static_cast<GPtrDiff_t>(nLineSpace) * m_nBlockYSize)
+        return -1;
+
+    const int nBlockXOff = nXOff / m_nBlockXSize;
+    const int nBlockYOff = nYOff / m_nBlockYSize;
+    const int nIters = bContigMultiBand ? 1 : nBandCount;
+
+    // If the block is already in the block cache, or not present in the
+    // file, let the regular code path deal with it.
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        auto poBand = cpl::down_cast<GTiffRasterBand *>(
+            papoBands[panBandMap[i] - 1]);
+        if (i < nIters && !IsBlockAvailable(poBand->ComputeBlockId(
+                              nBlockXOff, nBlockYOff)))
+        {
+            return -1;
+        }
+        auto poBlock = poBand->TryGetLockedBlockRef(nBlockXOff, nBlockYOff);
+        if (poBlock)
+        {
+            poBlock->DropLock();
+            return -1;
+        }
+    }
+
+    Crystalize();
+
+    // Only the nYSize first lines of the bottom-most strip are requested.
+    const GPtrDiff_t nBlockReqSize =
+        static_cast<GPtrDiff_t>(nLineSpace) * nYSize;
+    for (int i = 0; i < nIters; ++i)
+    {
+        auto poBand = cpl::down_cast<GTiffRasterBand *>(
+            papoBands[panBandMap[i] - 1]);
+        const int nBlockId = poBand->ComputeBlockId(nBlockXOff, nBlockYOff);
+        if (!ReadStrile(nBlockId, static_cast<GByte *>(pData) + i * nBandSpace,
+                        nBlockReqSize))
+        {
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                            LoadBlockBuf()                            */
 /*                                                                      */
@@ -270,6 +270,16 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         if (nErr >= 0)
             return static_cast<CPLErr>(nErr);
     }
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        // Reading exactly one tile/strip with the right data type and layout:
+        // decode it directly into the user buffer.
+        const int nErr = m_poGDS->WholeBlockDecodeIO(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType, 1, &nBand,
+            nPixelSpace, nLineSpace, 0);
+        if (nErr >= 0)
+            return static_cast<CPLErr>(nErr);
+    }
 
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     bool bCanUseMultiThreadedRead = false;
@@ -288,6 +298,18 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             bCanUseMultiThreadedRead = true;
         }
     }
+    else if (eRWFlag == GF_Read &&
+             (nXSize != nBufXSize || nYSize != nBufYSize) &&
+             !(m_poGDS->eAccess == GA_ReadOnly &&
+               m_poGDS->HasOptimizedReadMultiRange() &&
+               !VSI_TIFFGetVSILFile(TIFFClientdata(m_poGDS->m_hTIFF))
+                    ->HasPRead()))
+    {
+        // Resampled requests go through the block cache: decode the
+        // intersecting tiles/strips in parallel beforehand.
+        m_poGDS->MultiThreadedPopulateBlockCache(nXOff, nYOff, nXSize, nYSize,
+                                                 1, &nBand);
+    }
 #endif
 
     void *pBufferedData = nullptr;
@@ -338,6 +338,272 @@ static int PredictorSetupEncode(TIFF *tif)
 /* - when storing into the byte stream, we explicitly mask with 0xff so */
 /*   as to make icc -check=conversions happy (not necessary by the standard) */
 
+/* SSE2 implementations of the horizontal differencing/accumulation and of */
+/* the byte (un)shuffling of the floating point predictor. */
+/* Restricted to 64bit processors, which are guaranteed to have SSE2. */
+#if defined(__x86_64) || defined(_M_X64)
+#define PREDICTOR_USE_SSE2
+#include <emmintrin.h>
+
+/* Broadcast the last nPeriod (1, 2, 4 or 8) bytes of v to the whole vector */
+static inline __m128i predictorBroadcastLast(__m128i v, tmsize_t nPeriod)
+{
+    switch (nPeriod)
+    {
+        case 1:
+            v = _mm_unpackhi_epi8(v, v);
+            /*-fallthrough*/
+        case 2:
+            v = _mm_shufflehi_epi16(v, 0xFF);
+            return _mm_unpackhi_epi64(v, v);
+        case 4:
+            return _mm_shuffle_epi32(v, 0xFF);
+        default:
+            return _mm_unpackhi_epi64(v, v);
+    }
+}
+
+/* Defines a function that does, in place, the accumulation */
+/* cp[i] += cp[i - nPeriod] (in units of the element type) on the */
+/* largest multiple of 16 bytes of the buffer, using a parallel prefix */
+/* sum within each vector. nPeriod is in bytes and must be 1, 2, 4 or 8, */
+/* and not smaller than the element size. */
+/* Returns the number of bytes processed. */
+#define DEFINE_HOR_ACC_SSE2(name, add)                                         \
+    static tmsize_t name(uint8_t *cp, tmsize_t cc, tmsize_t nPeriod)           \
+    {                                                                          \
+        __m128i carry = _mm_setzero_si128();                                   \
+        tmsize_t i = 0;                                                        \
+        for (; i + 16 <= cc; i += 16)                                          \
+        {                                                                      \
+            __m128i v = _mm_loadu_si128((const __m128i *)(cp + i));            \
+            switch (nPeriod)                                                   \
+            {                                                                  \
+                case 1:                                                        \
+                    v = add(v, _mm_slli_si128(v, 1)); /*-fallthrough*/         \
+                case 2:                                                        \
+                    v = add(v, _mm_slli_si128(v, 2)); /*-fallthrough*/         \
+                case 4:                                                        \
+                    v = add(v, _mm_slli_si128(v, 4)); /*-fallthrough*/         \
+                default:                                                       \
+                    v = add(v, _mm_slli_si128(v, 8));                          \
+            }                                                                  \
+            v = add(v, carry);                                                 \
+            _mm_storeu_si128((__m128i *)(cp + i), v);                          \
+            carry = predictorBroadcastLast(v, nPeriod);                        \
+        }                                                                      \
+        return i;                                                              \
+    }
+
+DEFINE_HOR_ACC_SSE2(horAccSSE2_8, _mm_add_epi8)
+DEFINE_HOR_ACC_SSE2(horAccSSE2_16, _mm_add_epi16)
+DEFINE_HOR_ACC_SSE2(horAccSSE2_32, _mm_add_epi32)
+DEFINE_HOR_ACC_SSE2(horAccSSE2_64, _mm_add_epi64)
+
+/* Defines a function that does, in place, the differencing */
+/* cp[i] -= cp[i - nPeriod] (in units of the element type) on the */
+/* [nRemaining, cc) range of the buffer, processed from the end, where */
+/* nRemaining is a multiple of nPeriod (in bytes) not smaller than nPeriod. */
+/* Returns nRemaining, the number of bytes left to be processed. */
+#define DEFINE_HOR_DIFF_SSE2(name, sub)                                        \
+    static tmsize_t name(uint8_t *cp, tmsize_t cc, tmsize_t nPeriod)           \
+    {                                                                          \
+        /* The number of vectors must be a multiple of */                      \
+        /* nPeriod / gcd(nPeriod, 16) so that the remaining part is a */       \
+        /* multiple of nPeriod */                                              \
+        tmsize_t nGCD = 16;                                                    \
+        tmsize_t nMultiple;                                                    \
+        tmsize_t nVectors;                                                     \
+        tmsize_t i;                                                            \
+        while ((nPeriod % nGCD) != 0)                                          \
+            nGCD /= 2;                                                         \
+        nMultiple = nPeriod / nGCD;                                            \
+        if (cc < nPeriod + 16)                                                 \
+            return cc;                                                         \
+        nVectors = ((cc - nPeriod) / 16) / nMultiple * nMultiple;              \
+        for (i = cc - 16; nVectors > 0; i -= 16, --nVectors)                   \
+        {                                                                      \
+            const __m128i cur = _mm_loadu_si128((const __m128i *)(cp + i));    \
+            const __m128i prev =                                               \
+                _mm_loadu_si128((const __m128i *)(cp + i - nPeriod));          \
+            _mm_storeu_si128((__m128i *)(cp + i), sub(cur, prev));             \
+        }                                                                      \
+        return i + 16;                                                         \
+    }
+
+DEFINE_HOR_DIFF_SSE2(horDiffSSE2_8, _mm_sub_epi8)
+DEFINE_HOR_DIFF_SSE2(horDiffSSE2_16, _mm_sub_epi16)
+DEFINE_HOR_DIFF_SSE2(horDiffSSE2_32, _mm_sub_epi32)
+DEFINE_HOR_DIFF_SSE2(horDiffSSE2_64, _mm_sub_epi64)
+
+/* Interleave the bps byte planes of tmp (most significant byte first) into */
+/* little-endian words of cp, for the largest multiple of 16 words. */
+/* Returns the number of words processed. */
+static tmsize_t fpAccUnshuffleSSE2(uint8_t *cp, const uint8_t *tmp,
+                                   tmsize_t wc, uint32_t bps)
+{
+    tmsize_t i = 0;
+    if (bps == 2)
+    {
+        for (; i + 16 <= wc; i += 16)
+        {
+            const __m128i v0 = _mm_loadu_si128((const __m128i *)(tmp + wc + i));
+            const __m128i v1 = _mm_loadu_si128((const __m128i *)(tmp + i));
+            _mm_storeu_si128((__m128i *)(cp + 2 * i),
+                             _mm_unpacklo_epi8(v0, v1));
+            _mm_storeu_si128((__m128i *)(cp + 2 * i + 16),
+                             _mm_unpackhi_epi8(v0, v1));
+        }
+    }
+    else if (bps == 4)
+    {
+        for (; i + 16 <= wc; i += 16)
+        {
+            const __m128i v0 =
+                _mm_loadu_si128((const __m128i *)(tmp + 3 * wc + i));
+            const __m128i v1 =
+                _mm_loadu_si128((const __m128i *)(tmp + 2 * wc + i));
+            const __m128i v2 = _mm_loadu_si128((const __m128i *)(tmp + wc + i));
+            const __m128i v3 = _mm_loadu_si128((const __m128i *)(tmp + i));
+            const __m128i lo01 = _mm_unpacklo_epi8(v0, v1);
+            const __m128i hi01 = _mm_unpackhi_epi8(v0, v1);
+            const __m128i lo23 = _mm_unpacklo_epi8(v2, v3);
+            const __m128i hi23 = _mm_unpackhi_epi8(v2, v3);
+            _mm_storeu_si128((__m128i *)(cp + 4 * i),
+                             _mm_unpacklo_epi16(lo01, lo23));
+            _mm_storeu_si128((__m128i *)(cp + 4 * i + 16),
+                             _mm_unpackhi_epi16(lo01, lo23));
+            _mm_storeu_si128((__m128i *)(cp + 4 * i + 32),
+                             _mm_unpacklo_epi16(hi01, hi23));
+            _mm_storeu_si128((__m128i *)(cp + 4 * i + 48),
+                             _mm_unpackhi_epi16(hi01, hi23));
+        }
+    }
+    else if (bps == 8)
+    {
+        for (; i + 16 <= wc; i += 16)
+        {
+            __m128i a[8];
+            int k;
+            for (k = 0; k < 4; ++k)
+            {
+                const __m128i v0 = _mm_loadu_si128(
+                    (const __m128i *)(tmp + (7 - 2 * k) * wc + i));
+                const __m128i v1 = _mm_loadu_si128(
+                    (const __m128i *)(tmp + (6 - 2 * k) * wc + i));
+                a[k] = _mm_unpacklo_epi8(v0, v1);
+                a[4 + k] = _mm_unpackhi_epi8(v0, v1);
+            }
+            /* a[0..3]: bytes 0-1, 2-3, 4-5, 6-7 of words 0..7 */
+            /* a[4..7]: same for words 8..15 */
+            for (k = 0; k < 2; ++k)
+            {
+                const __m128i *pa = a + 4 * k;
+                const __m128i b0 = _mm_unpacklo_epi16(pa[0], pa[1]);
+                const __m128i b1 = _mm_unpackhi_epi16(pa[0], pa[1]);
+                const __m128i c0 = _mm_unpacklo_epi16(pa[2], pa[3]);
+                const __m128i c1 = _mm_unpackhi_epi16(pa[2], pa[3]);
+                uint8_t *pDst = cp + 8 * (i + 8 * k);
+                _mm_storeu_si128((__m128i *)(pDst), _mm_unpacklo_epi32(b0, c0));
+                _mm_storeu_si128((__m128i *)(pDst + 16),
+                                 _mm_unpackhi_epi32(b0, c0));
+                _mm_storeu_si128((__m128i *)(pDst + 32),
+                                 _mm_unpacklo_epi32(b1, c1));
+                _mm_storeu_si128((__m128i *)(pDst + 48),
+                                 _mm_unpackhi_epi32(b1, c1));
+            }
+        }
+    }
+    return i;
+}
+
+/* Split the little-endian words of tmp into bps byte planes in cp (most */
+/* significant byte first), for the largest multiple of 16 words. */
+/* Returns the number of words processed. */
+static tmsize_t fpDiffShuffleSSE2(uint8_t *cp, const uint8_t *tmp,
+                                  tmsize_t wc, uint32_t bps)
+{
+    tmsize_t i = 0;
+    if (bps == 2)
+    {
+        const __m128i mask = _mm_set1_epi16(0xFF);
+        for (; i + 16 <= wc; i += 16)
+        {
+            const __m128i w0 = _mm_loadu_si128((const __m128i *)(tmp + 2 * i));
+            const __m128i w1 =
+                _mm_loadu_si128((const __m128i *)(tmp + 2 * i + 16));
+            _mm_storeu_si128(
+                (__m128i *)(cp + wc + i),
+                _mm_packus_epi16(_mm_and_si128(w0, mask),
+                                 _mm_and_si128(w1, mask)));
+            _mm_storeu_si128((__m128i *)(cp + i),
+                             _mm_packus_epi16(_mm_srli_epi16(w0, 8),
+                                              _mm_srli_epi16(w1, 8)));
+        }
+    }
+    else if (bps == 4)
+    {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        for (; i + 16 <= wc; i += 16)
+        {
+            __m128i w[4];
+            uint32_t byte;
+            int k;
+            for (k = 0; k < 4; ++k)
+                w[k] = _mm_loadu_si128((const __m128i *)(tmp + 4 * i + 16 * k));
+            for (byte = 0; byte < 4; ++byte)
+            {
+                __m128i t[4];
+                for (k = 0; k < 4; ++k)
+                {
+                    t[k] = _mm_and_si128(w[k], mask);
+                    w[k] = _mm_srli_epi32(w[k], 8);
+                }
+                _mm_storeu_si128(
+                    (__m128i *)(cp + (3 - byte) * wc + i),
+                    _mm_packus_epi16(_mm_packs_epi32(t[0], t[1]),
+                                     _mm_packs_epi32(t[2], t[3])));
+            }
+        }
+    }
+    else if (bps == 8)
+    {
+        const __m128i mask = _mm_set_epi32(0, 0xFF, 0, 0xFF);
+        for (; i + 16 <= wc; i += 16)
+        {
+            __m128i w[8];
+            uint32_t byte;
+            int k;
+            for (k = 0; k < 8; ++k)
+                w[k] = _mm_loadu_si128((const __m128i *)(tmp + 8 * i + 16 * k));
+            for (byte = 0; byte < 8; ++byte)
+            {
+                __m128i t[4];
+                for (k = 0; k < 4; ++k)
+                {
+                    /* Gather the low 32 bits of the 4 words of */
+                    /* w[2 * k] and w[2 * k + 1] */
+                    const __m128i t0 = _mm_shuffle_epi32(
+                        _mm_and_si128(w[2 * k], mask), _MM_SHUFFLE(2, 0, 2, 0));
+                    const __m128i t1 =
+                        _mm_shuffle_epi32(_mm_and_si128(w[2 * k + 1], mask),
+                                          _MM_SHUFFLE(2, 0, 2, 0));
+                    t[k] = _mm_unpacklo_epi64(t0, t1);
+                    w[2 * k] = _mm_srli_epi64(w[2 * k], 8);
+                    w[2 * k + 1] = _mm_srli_epi64(w[2 * k + 1], 8);
+                }
+                _mm_storeu_si128(
+                    (__m128i *)(cp + (7 - byte) * wc + i),
+                    _mm_packus_epi16(_mm_packs_epi32(t[0], t[1]),
+                                     _mm_packs_epi32(t[2], t[3])));
+            }
+        }
+    }
+    return i;
+}
+
+#endif /* PREDICTOR_USE_SSE2 */
+
 TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
 static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 {
@@ -352,6 +618,18 @@ static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (cc > stride)
     {
+        /* Number of bytes already processed */
+        tmsize_t nDone = stride;
+#ifdef PREDICTOR_USE_SSE2
+        if (stride == 1 || stride == 2 || stride == 4 || stride == 8)
+        {
+            const tmsize_t nDoneSSE2 = horAccSSE2_8(cp, cc, stride);
+            if (nDoneSSE2 > nDone)
+                nDone = nDoneSSE2;
+            if (nDone == cc)
+                return 1;
+        }
+#endif
         /*
          * Pipeline the most common cases.
          */
@@ -370,11 +648,11 @@ static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         }
         else if (stride == 4)
         {
-            unsigned int cr = cp[0];
-            unsigned int cg = cp[1];
-            unsigned int cb = cp[2];
-            unsigned int ca = cp[3];
-            tmsize_t i = stride;
+            unsigned int cr = cp[nDone - 4];
+            unsigned int cg = cp[nDone - 3];
+            unsigned int cb = cp[nDone - 2];
+            unsigned int ca = cp[nDone - 1];
+            tmsize_t i = nDone;
             for (; i < cc; i += stride)
             {
                 cp[i + 0] = (unsigned char)((cr += cp[i + 0]) & 0xff);
@@ -385,14 +663,15 @@ static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         }
         else
         {
-            cc -= stride;
-            do
+            cp += nDone - stride;
+            cc -= nDone;
+            while (cc > 0)
             {
                 REPEAT4(stride,
                         cp[stride] = (unsigned char)((cp[stride] + *cp) & 0xff);
                         cp++)
                 cc -= stride;
-            } while (cc > 0);
+            }
         }
     }
     return 1;
@@ -422,15 +701,27 @@ static int horAcc16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
-        wc -= stride;
-        do
+        /* Number of words already processed */
+        tmsize_t nDone = stride;
+#ifdef PREDICTOR_USE_SSE2
+        if (stride == 1 || stride == 2 || stride == 4)
+        {
+            const tmsize_t nDoneSSE2 =
+                horAccSSE2_16(cp0, cc, 2 * stride) / 2;
+            if (nDoneSSE2 > nDone)
+                nDone = nDoneSSE2;
+        }
+#endif
+        wp += nDone - stride;
+        wc -= nDone;
+        while (wc > 0)
         {
             REPEAT4(stride, wp[stride] = (uint16_t)(((unsigned int)wp[stride] +
                                                      (unsigned int)wp[0]) &
                                                     0xffff);
                     wp++)
             wc -= stride;
-        } while (wc > 0);
+        }
     }
     return 1;
 }
@@ -459,12 +750,24 @@ static int horAcc32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
-        wc -= stride;
-        do
+        /* Number of words already processed */
+        tmsize_t nDone = stride;
+#ifdef PREDICTOR_USE_SSE2
+        if (stride == 1 || stride == 2)
+        {
+            const tmsize_t nDoneSSE2 =
+                horAccSSE2_32(cp0, cc, 4 * stride) / 4;
+            if (nDoneSSE2 > nDone)
+                nDone = nDoneSSE2;
+        }
+#endif
+        wp += nDone - stride;
+        wc -= nDone;
+        while (wc > 0)
         {
             REPEAT4(stride, wp[stride] += wp[0]; wp++)
             wc -= stride;
-        } while (wc > 0);
+        }
     }
     return 1;
 }
@@ -493,12 +796,24 @@ static int horAcc64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
-        wc -= stride;
-        do
+        /* Number of words already processed */
+        tmsize_t nDone = stride;
+#ifdef PREDICTOR_USE_SSE2
+        if (stride == 1)
+        {
+            const tmsize_t nDoneSSE2 =
+                horAccSSE2_64(cp0, cc, 8 * stride) / 8;
+            if (nDoneSSE2 > nDone)
+                nDone = nDoneSSE2;
+        }
+#endif
+        wp += nDone - stride;
+        wc -= nDone;
+        while (wc > 0)
         {
             REPEAT4(stride, wp[stride] += wp[0]; wp++)
             wc -= stride;
-        } while (wc > 0);
+        }
     }
     return 1;
 }
@@ -525,6 +840,18 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     if (!tmp)
         return 0;
 
+#ifdef PREDICTOR_USE_SSE2
+    if (count > stride &&
+        (stride == 1 || stride == 2 || stride == 4 || stride == 8))
+    {
+        const tmsize_t nDone = horAccSSE2_8(cp, cc, stride);
+        if (nDone > stride)
+        {
+            cp += nDone - stride;
+            count -= nDone - stride;
+        }
+    }
+#endif
     while (count > stride)
     {
         REPEAT4(stride,
@@ -535,7 +862,12 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     _TIFFmemcpy(tmp, cp0, cc);
     cp = (uint8_t *)cp0;
-    for (count = 0; count < wc; count++)
+#ifdef PREDICTOR_USE_SSE2
+    count = fpAccUnshuffleSSE2(cp, tmp, wc, bps);
+#else
+    count = 0;
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -625,6 +957,12 @@ static int horDiff8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (cc > stride)
     {
+#ifdef PREDICTOR_USE_SSE2
+        /* Process the end of the buffer, and leave the first cc bytes */
+        cc = horDiffSSE2_8(cp, cc, stride);
+        if (cc == stride)
+            return 1;
+#endif
         cc -= stride;
         /*
          * Pipeline the most common cases.
@@ -704,6 +1042,12 @@ static int horDiff16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef PREDICTOR_USE_SSE2
+        /* Process the end of the buffer, and leave the first wc words */
+        wc = horDiffSSE2_16(cp0, cc, 2 * stride) / 2;
+        if (wc == stride)
+            return 1;
+#endif
         wc -= stride;
         wp += wc - 1;
         do
@@ -746,6 +1090,12 @@ static int horDiff32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef PREDICTOR_USE_SSE2
+        /* Process the end of the buffer, and leave the first wc words */
+        wc = horDiffSSE2_32(cp0, cc, 4 * stride) / 4;
+        if (wc == stride)
+            return 1;
+#endif
         wc -= stride;
         wp += wc - 1;
         do
@@ -785,6 +1135,12 @@ static int horDiff64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef PREDICTOR_USE_SSE2
+        /* Process the end of the buffer, and leave the first wc words */
+        wc = horDiffSSE2_64(cp0, cc, 8 * stride) / 8;
+        if (wc == stride)
+            return 1;
+#endif
         wc -= stride;
         wp += wc - 1;
         do
@@ -832,7 +1188,12 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
 
     _TIFFmemcpy(tmp, cp0, cc);
-    for (count = 0; count < wc; count++)
+#ifdef PREDICTOR_USE_SSE2
+    count = fpDiffShuffleSSE2(cp, tmp, wc, bps);
+#else
+    count = 0;
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -847,8 +1208,13 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     _TIFFfreeExt(tif, tmp);
 
     cp = (uint8_t *)cp0;
-    cp += cc - stride - 1;
-    for (count = cc; count > stride; count -= stride)
+#ifdef PREDICTOR_USE_SSE2
+    count = horDiffSSE2_8(cp, cc, stride);
+#else
+    count = cc;
+#endif
+    cp += count - stride - 1;
+    for (; count > stride; count -= stride)
         REPEAT4(stride,
                 cp[stride] = (unsigned char)((cp[stride] - cp[0]) & 0xff);
                 cp--)
@@ -336,6 +336,7 @@ class HDF5Array final : public GDALMDArray
             return nullptr;
         }
         ar->SetSelf(ar);
+        ar->EnableChunkCache();
         return ar;
     }
 
@@ -595,6 +595,7 @@ class netCDFVariable final : public GDALPamMDArray, public netCDFAttributeHolder
         auto var(std::shared_ptr<netCDFVariable>(
             new netCDFVariable(poShared, gid, varid, dims, papszOptions)));
         var->SetSelf(var);
+        var->EnableChunkCache();
         var->m_poParent = poParent;
         if (poParent)
             poParent->RegisterArray(var.get());
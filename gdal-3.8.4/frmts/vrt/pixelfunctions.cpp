@@ -31,7 +31,10 @@
 #include "gdal.h"
 #include "vrtdataset.h"
 
+#include <algorithm>
 #include <limits>
+#include <string>
+#include <vector>
 
 template <typename T>
 inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
@@ -1628,6 +1631,652 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
                                          nPixelSpace, nLineSpace, papszArgs);
 }
 
+/************************************************************************/
+/*                         ExpressionPixelFunc()                        */
+/************************************************************************/
+
+static const char pszExpressionPixelFuncMetadata[] =
+    "<PixelFunctionArgumentsList>"
+    "   <Argument type='builtin' value='NoData' optional='true' />"
+    "   <Argument name='expression' description='Expression of the sources "
+    "B1, B2, ... to evaluate' type='string' />"
+    "</PixelFunctionArgumentsList>";
+
+namespace
+{
+
+enum class ExprOp
+{
+    SOURCE,
+    CONSTANT,
+    NEG,
+    NOT,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    POW,
+    LT,
+    LE,
+    GT,
+    GE,
+    EQ,
+    NE,
+    AND,
+    OR,
+    SELECT,
+    MIN,
+    MAX,
+    ABS,
+    SQRT,
+    EXP,
+    LOG,
+    LOG10,
+    FLOOR,
+    CEIL,
+    SIN,
+    COS,
+    TAN,
+    ISNAN,
+};
+
+struct ExprInstr
+{
+    ExprOp eOp;
+    int iSource;
+    double dfValue;
+};
+
+/************************************************************************/
+/*                            ExprCompiler                              */
+/************************************************************************/
+
+// Recursive descent compiler turning an expression into a postfix program
+// for a stack machine whose slots are arrays of values.
+//
+// Grammar, by increasing precedence:
+//   expr    := or [ '?' expr ':' expr ]
+//   or      := and { '||' and }
+//   and     := eq { '&&' eq }
+//   eq      := rel { ('==' | '!=') rel }
+//   rel     := add { ('<' | '<=' | '>' | '>=') add }
+//   add     := mul { ('+' | '-') mul }
+//   mul     := unary { ('*' | '/') unary }
+//   unary   := ('-' | '+' | '!') unary | power
+//   power   := primary [ '^' unary ]
+//   primary := number | 'B'<n> | 'NoData' | function '(' args ')'
+//              | '(' expr ')'
+
+class ExprCompiler
+{
+    const char *const m_pszExpression = nullptr;
+    const char *m_pszCur = nullptr;
+    const int m_nSources = 0;
+    const bool m_bHasNoData = false;
+    const double m_dfNoData = 0;
+    std::vector<ExprInstr> m_aoProgram{};
+    int m_nDepth = 0;
+    int m_nMaxDepth = 0;
+    int m_nNesting = 0;
+
+    static constexpr int MAX_NESTING = 64;
+
+    CPL_DISALLOW_COPY_ASSIGN(ExprCompiler)
+
+    void Emit(ExprOp eOp, int iSource = 0, double dfValue = 0)
+    {
+        m_aoProgram.push_back(ExprInstr{eOp, iSource, dfValue});
+        switch (eOp)
+        {
+            case ExprOp::SOURCE:
+            case ExprOp::CONSTANT:
+                ++m_nDepth;
+                break;
+            case ExprOp::NEG:
+            case ExprOp::NOT:
+            case ExprOp::ABS:
+            case ExprOp::SQRT:
+            case ExprOp::EXP:
+            case ExprOp::LOG:
+            case ExprOp::LOG10:
+            case ExprOp::FLOOR:
+            case ExprOp::CEIL:
+            case ExprOp::SIN:
+            case ExprOp::COS:
+            case ExprOp::TAN:
+            case ExprOp::ISNAN:
+                break;
+            case ExprOp::SELECT:
+                m_nDepth -= 2;
+                break;
+            default:
+                --m_nDepth;
+                break;
+        }
+        m_nMaxDepth = std::max(m_nMaxDepth, m_nDepth);
+    }
+
+    bool Error(const char *pszMsg)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression: %s at offset %d of '%s'", pszMsg,
+                 static_cast<int>(m_pszCur - m_pszExpression),
+                 m_pszExpression);
+        return false;
+    }
+
+    void SkipSpaces()
+    {
+        while (isspace(static_cast<unsigned char>(*m_pszCur)))
+            ++m_pszCur;
+    }
+
+    bool Accept(const char *pszToken)
+    {
+        SkipSpaces();
+        const size_t nLen = strlen(pszToken);
+        if (strncmp(m_pszCur, pszToken, nLen) != 0)
+            return false;
+        // Do not take '<' for '<=', '!' for '!=', etc.
+        if (nLen == 1 && strchr("<>!=", pszToken[0]) && m_pszCur[1] == '=')
+            return false;
+        m_pszCur += nLen;
+        return true;
+    }
+
+    bool ParseExpr()
+    {
+        if (++m_nNesting > MAX_NESTING)
+            return Error("too deeply nested expression");
+        bool bRet = ParseBinary(0);
+        if (bRet && Accept("?"))
+        {
+            bRet = ParseExpr();
+            if (bRet && !Accept(":"))
+                bRet = Error("':' expected");
+            if (bRet)
+                bRet = ParseExpr();
+            if (bRet)
+                Emit(ExprOp::SELECT);
+        }
+        --m_nNesting;
+        return bRet;
+    }
+
+    bool ParseBinary(int nLevel)
+    {
+        struct BinaryOp
+        {
+            int nLevel;
+            const char *pszToken;
+            ExprOp eOp;
+        };
+        static const BinaryOp asOps[] = {
+            {0, "||", ExprOp::OR},  {1, "&&", ExprOp::AND},
+            {2, "==", ExprOp::EQ},  {2, "!=", ExprOp::NE},
+            {3, "<=", ExprOp::LE},  {3, ">=", ExprOp::GE},
+            {3, "<", ExprOp::LT},   {3, ">", ExprOp::GT},
+            {4, "+", ExprOp::ADD},  {4, "-", ExprOp::SUB},
+            {5, "*", ExprOp::MUL},  {5, "/", ExprOp::DIV},
+        };
+        constexpr int MAX_LEVEL = 5;
+
+        if (nLevel > MAX_LEVEL)
+            return ParseUnary();
+        if (!ParseBinary(nLevel + 1))
+            return false;
+        while (true)
+        {
+            const BinaryOp *psOp = nullptr;
+            for (const auto &sOp : asOps)
+            {
+                if (sOp.nLevel == nLevel && Accept(sOp.pszToken))
+                {
+                    psOp = &sOp;
+                    break;
+                }
+            }
+            if (psOp == nullptr)
+                return true;
+            if (!ParseBinary(nLevel + 1))
+                return false;
+            Emit(psOp->eOp);
+        }
+    }
+
+    bool ParseUnary()
+    {
+        if (++m_nNesting > MAX_NESTING)
+            return Error("too deeply nested expression");
+        bool bRet;
+        if (Accept("-"))
+        {
+            bRet = ParseUnary();
+            if (bRet)
+                Emit(ExprOp::NEG);
+        }
+        else if (Accept("+"))
+        {
+            bRet = ParseUnary();
+        }
+        else if (Accept("!"))
+        {
+            bRet = ParseUnary();
+            if (bRet)
+                Emit(ExprOp::NOT);
+        }
+        else
+        {
+            bRet = ParsePrimary();
+            if (bRet && Accept("^"))
+            {
+                // Right associative, and binds tighter than a unary minus
+                // on its left: -2^2 == -4
+                bRet = ParseUnary();
+                if (bRet)
+                    Emit(ExprOp::POW);
+            }
+        }
+        --m_nNesting;
+        return bRet;
+    }
+
+    bool ParseFunction(const std::string &osName)
+    {
+        struct Function
+        {
+            const char *pszName;
+            ExprOp eOp;
+            int nArgs;  // -1 for 2 or more
+        };
+        static const Function asFunctions[] = {
+            {"abs", ExprOp::ABS, 1},     {"sqrt", ExprOp::SQRT, 1},
+            {"exp", ExprOp::EXP, 1},     {"log", ExprOp::LOG, 1},
+            {"log10", ExprOp::LOG10, 1}, {"floor", ExprOp::FLOOR, 1},
+            {"ceil", ExprOp::CEIL, 1},   {"sin", ExprOp::SIN, 1},
+            {"cos", ExprOp::COS, 1},     {"tan", ExprOp::TAN, 1},
+            {"isnan", ExprOp::ISNAN, 1}, {"pow", ExprOp::POW, 2},
+            {"min", ExprOp::MIN, -1},    {"max", ExprOp::MAX, -1},
+        };
+
+        const Function *psFunction = nullptr;
+        for (const auto &sFunction : asFunctions)
+        {
+            if (EQUAL(osName.c_str(), sFunction.pszName))
+            {
+                psFunction = &sFunction;
+                break;
+            }
+        }
+        if (psFunction == nullptr)
+            return Error(CPLSPrintf("unknown function '%s'", osName.c_str()));
+
+        int nArgs = 0;
+        if (!Accept(")"))
+        {
+            do
+            {
+                if (!ParseExpr())
+                    return false;
+                ++nArgs;
+                // Variadic min() and max() are folded pairwise
+                if (psFunction->nArgs < 0 && nArgs > 1)
+                    Emit(psFunction->eOp);
+            } while (Accept(","));
+            if (!Accept(")"))
+                return Error("')' expected");
+        }
+        if (psFunction->nArgs < 0 ? nArgs < 2 : nArgs != psFunction->nArgs)
+        {
+            return Error(CPLSPrintf("wrong number of arguments for '%s'",
+                                    psFunction->pszName));
+        }
+        if (psFunction->nArgs >= 0)
+            Emit(psFunction->eOp);
+        return true;
+    }
+
+    bool ParsePrimary()
+    {
+        SkipSpaces();
+        if (Accept("("))
+        {
+            if (!ParseExpr())
+                return false;
+            if (!Accept(")"))
+                return Error("')' expected");
+            return true;
+        }
+        if (isdigit(static_cast<unsigned char>(*m_pszCur)) ||
+            *m_pszCur == '.')
+        {
+            char *pszEnd = nullptr;
+            const double dfValue = CPLStrtod(m_pszCur, &pszEnd);
+            if (pszEnd == m_pszCur)
+                return Error("invalid number");
+            m_pszCur = pszEnd;
+            Emit(ExprOp::CONSTANT, 0, dfValue);
+            return true;
+        }
+        if (isalpha(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '_')
+        {
+            const char *pszStart = m_pszCur;
+            while (isalnum(static_cast<unsigned char>(*m_pszCur)) ||
+                   *m_pszCur == '_')
+            {
+                ++m_pszCur;
+            }
+            const std::string osName(pszStart, m_pszCur - pszStart);
+            if (Accept("("))
+                return ParseFunction(osName);
+            if ((osName[0] == 'B' || osName[0] == 'b') && osName.size() > 1 &&
+                osName.size() <= 10 &&
+                osName.find_first_not_of("0123456789", 1) == std::string::npos)
+            {
+                const int nBand = atoi(osName.c_str() + 1);
+                if (nBand < 1 || nBand > m_nSources)
+                {
+                    return Error(CPLSPrintf(
+                        "%s does not match any of the %d sources",
+                        osName.c_str(), m_nSources));
+                }
+                Emit(ExprOp::SOURCE, nBand - 1);
+                return true;
+            }
+            if (EQUAL(osName.c_str(), "NoData"))
+            {
+                if (!m_bHasNoData)
+                    return Error("band has no NoData value");
+                Emit(ExprOp::CONSTANT, 0, m_dfNoData);
+                return true;
+            }
+            m_pszCur = pszStart;
+            return Error(CPLSPrintf("unknown variable '%s'", osName.c_str()));
+        }
+        return Error("operand expected");
+    }
+
+  public:
+    ExprCompiler(const char *pszExpression, int nSources, bool bHasNoData,
+                 double dfNoData)
+        : m_pszExpression(pszExpression), m_pszCur(pszExpression),
+          m_nSources(nSources), m_bHasNoData(bHasNoData), m_dfNoData(dfNoData)
+    {
+    }
+
+    bool Compile()
+    {
+        if (!ParseExpr())
+            return false;
+        SkipSpaces();
+        if (*m_pszCur != '\0')
+            return Error("unexpected character");
+        return true;
+    }
+
+    const std::vector<ExprInstr> &GetProgram() const
+    {
+        return m_aoProgram;
+    }
+
+    int GetMaxDepth() const
+    {
+        return m_nMaxDepth;
+    }
+};
+
+}  // namespace
+
+// Number of values of a line evaluated at once. Each stack slot holds that
+// many values, so that the program runs as a sequence of tight loops over
+// contiguous arrays that the compiler can vectorize.
+constexpr int EXPR_CHUNK_SIZE = 1024;
+
+template <class F>
+static inline void ExprApplyUnary(double *padfA, int nValues, F f)
+{
+    for (int i = 0; i < nValues; ++i)
+        padfA[i] = f(padfA[i]);
+}
+
+// Applies f to the two topmost slots of the stack, and returns the new top.
+template <class F>
+static inline double *ExprApplyBinary(double *padfTop, int nValues, F f)
+{
+    double *const padfA = padfTop - EXPR_CHUNK_SIZE;
+    const double *const padfB = padfTop;
+    for (int i = 0; i < nValues; ++i)
+        padfA[i] = f(padfA[i], padfB[i]);
+    return padfA;
+}
+
+static void ExprEvaluate(const std::vector<ExprInstr> &aoProgram,
+                         void **papoSources, GDALDataType eSrcType,
+                         size_t nSrcOffset, int nValues, double *padfStack)
+{
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+    // Slot of the top of the stack, nullptr while it is empty
+    double *padfTop = nullptr;
+    for (const auto &oInstr : aoProgram)
+    {
+        switch (oInstr.eOp)
+        {
+            case ExprOp::SOURCE:
+                padfTop = padfTop ? padfTop + EXPR_CHUNK_SIZE : padfStack;
+                GDALCopyWords(static_cast<const GByte *>(
+                                  papoSources[oInstr.iSource]) +
+                                  nSrcOffset * nSrcTypeSize,
+                              eSrcType, nSrcTypeSize, padfTop, GDT_Float64,
+                              sizeof(double), nValues);
+                break;
+            case ExprOp::CONSTANT:
+                padfTop = padfTop ? padfTop + EXPR_CHUNK_SIZE : padfStack;
+                std::fill(padfTop, padfTop + nValues, oInstr.dfValue);
+                break;
+            case ExprOp::NEG:
+                ExprApplyUnary(padfTop, nValues, [](double a) { return -a; });
+                break;
+            case ExprOp::NOT:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return a == 0 ? 1.0 : 0.0; });
+                break;
+            case ExprOp::ABS:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::fabs(a); });
+                break;
+            case ExprOp::SQRT:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::sqrt(a); });
+                break;
+            case ExprOp::EXP:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::exp(a); });
+                break;
+            case ExprOp::LOG:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::log(a); });
+                break;
+            case ExprOp::LOG10:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::log10(a); });
+                break;
+            case ExprOp::FLOOR:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::floor(a); });
+                break;
+            case ExprOp::CEIL:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::ceil(a); });
+                break;
+            case ExprOp::SIN:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::sin(a); });
+                break;
+            case ExprOp::COS:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::cos(a); });
+                break;
+            case ExprOp::TAN:
+                ExprApplyUnary(padfTop, nValues,
+                               [](double a) { return std::tan(a); });
+                break;
+            case ExprOp::ISNAN:
+                ExprApplyUnary(padfTop, nValues, [](double a)
+                               { return std::isnan(a) ? 1.0 : 0.0; });
+                break;
+            case ExprOp::ADD:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a + b; });
+                break;
+            case ExprOp::SUB:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a - b; });
+                break;
+            case ExprOp::MUL:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a * b; });
+                break;
+            case ExprOp::DIV:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a / b; });
+                break;
+            case ExprOp::POW:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return std::pow(a, b); });
+                break;
+            case ExprOp::LT:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a < b ? 1.0 : 0.0; });
+                break;
+            case ExprOp::LE:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a <= b ? 1.0 : 0.0; });
+                break;
+            case ExprOp::GT:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a > b ? 1.0 : 0.0; });
+                break;
+            case ExprOp::GE:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a >= b ? 1.0 : 0.0; });
+                break;
+            case ExprOp::EQ:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a == b ? 1.0 : 0.0; });
+                break;
+            case ExprOp::NE:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return a != b ? 1.0 : 0.0; });
+                break;
+            case ExprOp::AND:
+                padfTop = ExprApplyBinary(
+                    padfTop, nValues, [](double a, double b)
+                    { return a != 0 && b != 0 ? 1.0 : 0.0; });
+                break;
+            case ExprOp::OR:
+                padfTop = ExprApplyBinary(
+                    padfTop, nValues, [](double a, double b)
+                    { return a != 0 || b != 0 ? 1.0 : 0.0; });
+                break;
+            case ExprOp::MIN:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return b < a ? b : a; });
+                break;
+            case ExprOp::MAX:
+                padfTop = ExprApplyBinary(padfTop, nValues,
+                                          [](double a, double b)
+                                          { return b > a ? b : a; });
+                break;
+            case ExprOp::SELECT:
+            {
+                double *const padfCond = padfTop - 2 * EXPR_CHUNK_SIZE;
+                const double *const padfA = padfTop - EXPR_CHUNK_SIZE;
+                const double *const padfB = padfTop;
+                for (int i = 0; i < nValues; ++i)
+                    padfCond[i] = padfCond[i] != 0 ? padfA[i] : padfB[i];
+                padfTop = padfCond;
+                break;
+            }
+        }
+    }
+}
+
+static CPLErr ExpressionPixelFunc(void **papoSources, int nSources,
+                                  void *pData, int nXSize, int nYSize,
+                                  GDALDataType eSrcType, GDALDataType eBufType,
+                                  int nPixelSpace, int nLineSpace,
+                                  CSLConstList papszArgs)
+{
+    /* ---- Init ---- */
+    if (GDALDataTypeIsComplex(eSrcType))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression cannot be applied to complex data types");
+        return CE_Failure;
+    }
+
+    const char *pszExpression = CSLFetchNameValue(papszArgs, "expression");
+    if (pszExpression == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Missing pixel function argument: expression");
+        return CE_Failure;
+    }
+
+    const char *pszNoData = CSLFetchNameValue(papszArgs, "NoData");
+    ExprCompiler oCompiler(pszExpression, nSources, pszNoData != nullptr,
+                           pszNoData ? CPLAtof(pszNoData) : 0.0);
+    if (!oCompiler.Compile())
+        return CE_Failure;
+    const auto &aoProgram = oCompiler.GetProgram();
+
+    std::vector<double> adfStack;
+    try
+    {
+        adfStack.resize(static_cast<size_t>(oCompiler.GetMaxDepth()) *
+                        EXPR_CHUNK_SIZE);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in ExpressionPixelFunc()");
+        return CE_Failure;
+    }
+
+    /* ---- Set pixels ---- */
+    for (int iLine = 0; iLine < nYSize; ++iLine)
+    {
+        for (int iCol = 0; iCol < nXSize; iCol += EXPR_CHUNK_SIZE)
+        {
+            const int nValues = std::min(EXPR_CHUNK_SIZE, nXSize - iCol);
+            ExprEvaluate(aoProgram, papoSources, eSrcType,
+                         static_cast<size_t>(iLine) * nXSize + iCol, nValues,
+                         adfStack.data());
+
+            GDALCopyWords(adfStack.data(), GDT_Float64, sizeof(double),
+                          static_cast<GByte *>(pData) +
+                              static_cast<GSpacing>(nLineSpace) * iLine +
+                              static_cast<GSpacing>(iCol) * nPixelSpace,
+                          eBufType, nPixelSpace, nValues);
+        }
+    }
+
+    /* ---- Return success ---- */
+    return CE_None;
+}  // ExpressionPixelFunc
+
 /************************************************************************/
 /*                     GDALRegisterDefaultPixelFunc()                   */
 /************************************************************************/
@@ -1696,6 +2345,10 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
  *                      exponential interpolation
  * - "scale": Apply the RasterBand metadata values of "offset" and "scale"
  * - "nan": Convert incoming NoData values to IEEE 754 nan
+ * - "expression": evaluate the arithmetic and conditional expression given
+ *                 in the "expression" argument, where B1, B2, ... refer to
+ *                 the sources, e.g. ``(B2 - B1) / (B2 + B1)`` or
+ *                 ``B1 > 0 ? log10(B1) : NoData``
  *
  * @see GDALAddDerivedBandPixelFunc
  *
@@ -1749,5 +2402,20 @@ CPLErr GDALRegisterDefaultPixelFunc()
                                         pszMinMaxFuncMetadataNodata);
     GDALAddDerivedBandPixelFuncWithArgs("max", MaxPixelFunc,
                                         pszMinMaxFuncMetadataNodata);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", ExpressionPixelFunc,
+                                        pszExpressionPixelFuncMetadata);
+
+    // The above functions have no state and only write to the lines of
+    // the output buffer they are passed.
+    for (const char *pszFuncName :
+         {"real", "imag", "complex", "polar", "mod", "phase", "conj", "sum",
+          "diff", "mul", "div", "cmul", "inv", "intensity", "sqrt", "log10",
+          "dB", "exp", "dB2amp", "dB2pow", "pow", "interpolate_linear",
+          "interpolate_exp", "replace_nodata", "scale", "norm_diff", "min",
+          "max", "expression"})
+    {
+        VRTDerivedRasterBand::SetPixelFunctionThreadSafe(pszFuncName);
+    }
+
     return CE_None;
 }
@@ -1430,12 +1430,18 @@ GDALDataset *VRTDataset::OpenXML(const char *pszXML, const char *pszVRTPath,
 {
     /* -------------------------------------------------------------------- */
     /*      Parse the XML.                                                  */
+    /*                                                                      */
+    /*      VRTDataset::XMLInit() and the bands and sources it creates      */
+    /*      only read the tree, which can thus be parsed into an arena,     */
+    /*      saving lots of allocations for VRTs with many sources.          */
+    /*      Subclasses, such as VRTWarpedDataset, may modify their tree     */
+    /*      and get a regular copy of it.                                   */
     /* -------------------------------------------------------------------- */
-    CPLXMLTreeCloser psTree(CPLParseXMLString(pszXML));
-    if (psTree == nullptr)
+    CPLXMLArenaTree oArenaTree;
+    if (oArenaTree.Parse(pszXML) == nullptr)
         return nullptr;
 
-    CPLXMLNode *psRoot = CPLGetXMLNode(psTree.get(), "=VRTDataset");
+    CPLXMLNode *psRoot = CPLGetXMLNode(oArenaTree.get(), "=VRTDataset");
     if (psRoot == nullptr)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Missing VRTDataset element.");
@@ -1444,6 +1450,14 @@ GDALDataset *VRTDataset::OpenXML(const char *pszXML, const char *pszVRTPath,
 
     const char *pszSubClass = CPLGetXMLValue(psRoot, "subClass", "");
 
+    CPLXMLTreeCloser psTree(nullptr);
+    if (pszSubClass[0] != '\0')
+    {
+        psTree.reset(CPLCloneXMLTree(oArenaTree.get()));
+        psRoot = CPLGetXMLNode(psTree.get(), "=VRTDataset");
+        pszSubClass = CPLGetXMLValue(psRoot, "subClass", "");
+    }
+
     const bool bIsPansharpened =
         strcmp(pszSubClass, "VRTPansharpenedDataset") == 0;
 
@@ -2191,17 +2205,28 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand *poBand =
             static_cast<VRTSourcedRasterBand *>(papoBands[nBands - 1]);
-        for (int iSource = 0; eErr == CE_None && iSource < poBand->nSources;
-             iSource++)
+        std::vector<int> anSources;
+        if (psExtraArg->bFloatingPointWindowValidity)
+        {
+            poBand->GetSourcesIntersectingWindow(
+                psExtraArg->dfXOff, psExtraArg->dfYOff, psExtraArg->dfXSize,
+                psExtraArg->dfYSize, anSources);
+        }
+        else
+        {
+            poBand->GetSourcesIntersectingWindow(nXOff, nYOff, nXSize, nYSize,
+                                                 anSources);
+        }
+        const int nCandidateSources = static_cast<int>(anSources.size());
+        for (int i = 0; eErr == CE_None && i < nCandidateSources; i++)
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData = GDALCreateScaledProgress(
-                1.0 * iSource / poBand->nSources,
-                1.0 * (iSource + 1) / poBand->nSources, pfnProgressGlobal,
-                pProgressDataGlobal);
+                1.0 * i / nCandidateSources, 1.0 * (i + 1) / nCandidateSources,
+                pfnProgressGlobal, pProgressDataGlobal);
 
-            VRTSimpleSource *poSource =
-                static_cast<VRTSimpleSource *>(poBand->papoSources[iSource]);
+            VRTSimpleSource *poSource = static_cast<VRTSimpleSource *>(
+                poBand->papoSources[anSources[i]]);
 
             eErr = poSource->DatasetRasterIO(
                 poBand->GetRasterDataType(), nXOff, nYOff, nXSize, nYSize,
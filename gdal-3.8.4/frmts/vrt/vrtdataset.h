@@ -35,6 +35,8 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -640,10 +642,27 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
         bool bAllowMaxValAdjustment) const;
 
+    // Spatial index of the destination windows of the sources, lazily built
+    // by GetSourcesIntersectingWindow() for mosaics with many sources.
+    CPLQuadTree *m_hSourcesQuadTree = nullptr;
+    int m_nSourcesInQuadTree = 0;
+    std::vector<int> m_anSourcesNotInQuadTree{};
+    void InvalidateSourcesQuadTree();
+
+    bool IRasterIOSourcesInParallel(int nXOff, int nYOff, int nXSize,
+                                    int nYSize, void *pData, int nBufXSize,
+                                    int nBufYSize, GDALDataType eBufType,
+                                    GSpacing nPixelSpace, GSpacing nLineSpace,
+                                    GDALRasterIOExtraArg *psExtraArg,
+                                    const std::vector<int> &anSources,
+                                    CPLErr &eErr);
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   protected:
     bool SkipBufferInitialization();
+    std::unique_ptr<CPLJobQueue> GetIRasterIOJobQueue(int nMaxThreads,
+                                                      int &nThreads);
 
   public:
     int nSources = 0;
@@ -747,6 +766,10 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
 
     void RemoveCoveredSources(CSLConstList papszOptions = nullptr);
 
+    void GetSourcesIntersectingWindow(double dfXOff, double dfYOff,
+                                      double dfXSize, double dfYSize,
+                                      std::vector<int> &anSources);
+
     bool CanIRasterIOBeForwardedToEachSource(
         GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
         int nBufXSize, int nBufYSize, GDALRasterIOExtraArg *psExtraArg) const;
@@ -872,6 +895,8 @@ class CPL_DLL VRTDerivedRasterBand CPL_NON_FINAL : public VRTSourcedRasterBand
 
     static std::pair<PixelFunc, CPLString> *
     GetPixelFunction(const char *pszFuncNameIn);
+    static void SetPixelFunctionThreadSafe(const char *pszFuncNameIn);
+    static bool IsPixelFunctionThreadSafe(const char *pszFuncNameIn);
 
     void SetPixelFunctionName(const char *pszFuncNameIn);
     void SetSourceTransferType(GDALDataType eDataType);
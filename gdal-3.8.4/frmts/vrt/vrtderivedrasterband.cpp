@@ -28,6 +28,7 @@
  * DEALINGS IN THE SOFTWARE.
  *****************************************************************************/
 
+#include "cpl_error_internal.h"
 #include "cpl_minixml.h"
 #include "cpl_string.h"
 #include "vrtdataset.h"
@@ -36,6 +37,7 @@
 
 #include <algorithm>
 #include <map>
+#include <set>
 #include <vector>
 #include <utility>
 
@@ -54,6 +56,10 @@ static std::map<CPLString,
                 std::pair<VRTDerivedRasterBand::PixelFunc, CPLString>>
     osMapPixelFunction;
 
+// Names of the pixel functions that can be evaluated on several ranges of
+// lines of the same request in parallel.
+static std::set<CPLString> osSetThreadSafePixelFunction;
+
 /* Flags for getting buffers */
 #define PyBUF_WRITABLE 0x0001
 #define PyBUF_FORMAT 0x0004
@@ -251,6 +257,7 @@ CPLErr CPL_STDCALL GDALAddDerivedBandPixelFunc(
         return CE_None;
     }
 
+    osSetThreadSafePixelFunction.erase(pszName);
     osMapPixelFunction[pszName] = {
         [pfnNewFunction](void **papoSources, int nSources, void *pData,
                          int nBufXSize, int nBufYSize, GDALDataType eSrcType,
@@ -294,6 +301,7 @@ CPLErr CPL_STDCALL GDALAddDerivedBandPixelFuncWithArgs(
         return CE_None;
     }
 
+    osSetThreadSafePixelFunction.erase(pszName);
     osMapPixelFunction[pszName] = {pfnNewFunction,
                                    pszMetadata != nullptr ? pszMetadata : ""};
 
@@ -359,6 +367,45 @@ VRTDerivedRasterBand::GetPixelFunction(const char *pszFuncNameIn)
     return &(oIter->second);
 }
 
+/************************************************************************/
+/*                      SetPixelFunctionThreadSafe()                    */
+/************************************************************************/
+
+/**
+ * Declare that a registered pixel function can be called concurrently on
+ * different ranges of lines of the same request, so that IRasterIO() may
+ * evaluate it from several threads.
+ *
+ * This is reset when a pixel function is registered again with the same
+ * name.
+ *
+ * @param pszFuncNameIn The name associated with the pixel function.
+ */
+void VRTDerivedRasterBand::SetPixelFunctionThreadSafe(
+    const char *pszFuncNameIn)
+{
+    if (osMapPixelFunction.find(pszFuncNameIn) != osMapPixelFunction.end())
+        osSetThreadSafePixelFunction.insert(pszFuncNameIn);
+}
+
+/************************************************************************/
+/*                      IsPixelFunctionThreadSafe()                     */
+/************************************************************************/
+
+/**
+ * Returns whether a pixel function has been declared with
+ * SetPixelFunctionThreadSafe().
+ *
+ * @param pszFuncNameIn The name associated with the pixel function.
+ */
+bool VRTDerivedRasterBand::IsPixelFunctionThreadSafe(
+    const char *pszFuncNameIn)
+{
+    return pszFuncNameIn != nullptr &&
+           osSetThreadSafePixelFunction.find(pszFuncNameIn) !=
+               osSetThreadSafePixelFunction.end();
+}
+
 /************************************************************************/
 /*                         SetPixelFunctionName()                       */
 /************************************************************************/
@@ -1358,10 +1405,116 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
             papszArgs = CSLSetNameValue(papszArgs, pszKey, pszValue);
         }
 
-        eErr = (poPixelFunc->first)(
-            static_cast<void **>(pBuffers), nBufferCount, pData, nBufXSize,
-            nBufYSize, eSrcType, eBufType, static_cast<int>(nPixelSpace),
-            static_cast<int>(nLineSpace), papszArgs);
+        // Split the evaluation of the pixel function into ranges of lines
+        // processed in parallel. This is only done for functions known to
+        // support it, as third-party functions may not be reentrant. With a
+        // buffer radius, the function may need the lines of its neighbours,
+        // so the window is evaluated at once.
+        constexpr int MIN_PIXELS_PER_JOB = 65536;
+        std::unique_ptr<CPLJobQueue> poQueue;
+        int nThreads = 1;
+        if (nBufferRadius == 0 && nBufYSize > 1 &&
+            IsPixelFunctionThreadSafe(pszFuncName))
+        {
+            poQueue = GetIRasterIOJobQueue(
+                static_cast<int>(
+                    std::min(static_cast<GIntBig>(nBufYSize),
+                             static_cast<GIntBig>(nBufXSize) * nBufYSize /
+                                 MIN_PIXELS_PER_JOB)),
+                nThreads);
+        }
+
+        if (poQueue)
+        {
+            struct Job
+            {
+                const PixelFunc *pfnPixelFunc = nullptr;
+                std::vector<void *> apSourceBuffers{};
+                void *pData = nullptr;
+                int nBufXSize = 0;
+                int nBufYSize = 0;
+                GDALDataType eSrcType = GDT_Unknown;
+                GDALDataType eBufType = GDT_Unknown;
+                int nPixelSpace = 0;
+                int nLineSpace = 0;
+                CSLConstList papszArgs = nullptr;
+                CPLErr eErr = CE_None;
+                std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+            };
+
+            const auto JobRunner = [](void *pDataIn)
+            {
+                auto psJob = static_cast<Job *>(pDataIn);
+                CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+                psJob->eErr = (*psJob->pfnPixelFunc)(
+                    psJob->apSourceBuffers.data(),
+                    static_cast<int>(psJob->apSourceBuffers.size()),
+                    psJob->pData, psJob->nBufXSize, psJob->nBufYSize,
+                    psJob->eSrcType, psJob->eBufType, psJob->nPixelSpace,
+                    psJob->nLineSpace, psJob->papszArgs);
+                CPLUninstallErrorHandlerAccumulator();
+            };
+
+            const int nJobs = std::min(nThreads, nBufYSize);
+            std::vector<Job> asJobs(nJobs);
+            for (int iJob = 0; iJob < nJobs; ++iJob)
+            {
+                const int nYStart = static_cast<int>(
+                    static_cast<GIntBig>(nBufYSize) * iJob / nJobs);
+                const int nYEnd = static_cast<int>(
+                    static_cast<GIntBig>(nBufYSize) * (iJob + 1) / nJobs);
+                auto &sJob = asJobs[iJob];
+                sJob.pfnPixelFunc = &(poPixelFunc->first);
+                for (int iBuffer = 0; iBuffer < nBufferCount; ++iBuffer)
+                {
+                    sJob.apSourceBuffers.push_back(
+                        static_cast<GByte *>(pBuffers[iBuffer]) +
+                        static_cast<size_t>(nYStart) * nBufXSize *
+                            nSrcTypeSize);
+                }
+                sJob.pData =
+                    static_cast<GByte *>(pData) + nYStart * nLineSpace;
+                sJob.nBufXSize = nBufXSize;
+                sJob.nBufYSize = nYEnd - nYStart;
+                sJob.eSrcType = eSrcType;
+                sJob.eBufType = eBufType;
+                sJob.nPixelSpace = static_cast<int>(nPixelSpace);
+                sJob.nLineSpace = static_cast<int>(nLineSpace);
+                sJob.papszArgs = papszArgs;
+                if (!poQueue->SubmitJob(JobRunner, &sJob))
+                {
+                    sJob.eErr = CE_Failure;
+                }
+            }
+            poQueue->WaitCompletion();
+
+            // All ranges of lines typically raise the same errors, so only
+            // re-emit those of the first job that raised any.
+            for (const auto &sJob : asJobs)
+            {
+                if (sJob.eErr != CE_None)
+                    eErr = CE_Failure;
+            }
+            for (const auto &sJob : asJobs)
+            {
+                if (!sJob.aoErrors.empty())
+                {
+                    for (const auto &oError : sJob.aoErrors)
+                    {
+                        CPLError(oError.type, oError.no, "%s",
+                                 oError.msg.c_str());
+                    }
+                    break;
+                }
+            }
+        }
+        else
+        {
+            eErr = (poPixelFunc->first)(
+                static_cast<void **>(pBuffers), nBufferCount, pData, nBufXSize,
+                nBufYSize, eSrcType, eBufType, static_cast<int>(nPixelSpace),
+                static_cast<int>(nLineSpace), papszArgs);
+        }
 
         CSLDestroy(papszArgs);
     }
@@ -45,6 +45,7 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
 #include "cpl_progress.h"
@@ -239,6 +240,281 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
     return true;
 }
 
+/************************************************************************/
+/*                        GetIRasterIOJobQueue()                        */
+/************************************************************************/
+
+// Set while a worker thread of IRasterIOSourcesInParallel() reads a source,
+// so that nested VRTs read their own sources sequentially instead of
+// spawning more threads.
+static thread_local bool bThreadLocalInVRTSourcesWorker = false;
+
+// Returns a queue of the global thread pool to use to split the work of
+// IRasterIO() in at most nMaxThreads jobs, or nullptr if GDAL_NUM_THREADS
+// does not allow more than one thread. nThreads receives the number of
+// threads that may be used.
+
+std::unique_ptr<CPLJobQueue>
+VRTSourcedRasterBand::GetIRasterIOJobQueue(int nMaxThreads, int &nThreads)
+{
+    nThreads = 1;
+    if (nMaxThreads <= 1 || bThreadLocalInVRTSourcesWorker)
+        return nullptr;
+
+    const int nRequestedThreads =
+        GDALGetNumThreads(nullptr, nullptr, nMaxThreads);
+    if (nRequestedThreads <= 1)
+        return nullptr;
+    CPLWorkerThreadPool *poThreadPool =
+        GDALGetGlobalThreadPool(nRequestedThreads);
+    if (poThreadPool == nullptr)
+        return nullptr;
+    nThreads = nRequestedThreads;
+    return poThreadPool->CreateJobQueue();
+}
+
+/************************************************************************/
+/*                     IRasterIOSourcesInParallel()                     */
+/************************************************************************/
+
+// Returns false if the sources cannot be read in parallel, in which case the
+// caller must overlay them sequentially. Otherwise eErr receives the result.
+//
+// Sources are assigned to successive passes: a source goes after every
+// earlier source whose output window overlaps its own, and never in the same
+// pass as another source of the same dataset. The sources of a pass thus
+// write disjoint parts of pData and can be read concurrently, and running the
+// passes in order keeps the painter's algorithm semantics of the sequential
+// code path, whatever the source type (nodata, masks, scaling, ...).
+
+bool VRTSourcedRasterBand::IRasterIOSourcesInParallel(
+    int nXOff, int nYOff, int nXSize, int nYSize, void *pData, int nBufXSize,
+    int nBufYSize, GDALDataType eBufType, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg,
+    const std::vector<int> &anSources, CPLErr &eErr)
+{
+    if (anSources.size() < 2 || bThreadLocalInVRTSourcesWorker)
+        return false;
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+    struct Context
+    {
+        GDALDataType eVRTDataType = GDT_Unknown;
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        int nYSize = 0;
+        void *pData = nullptr;
+        int nBufXSize = 0;
+        int nBufYSize = 0;
+        GDALDataType eBufType = GDT_Unknown;
+        GSpacing nPixelSpace = 0;
+        GSpacing nLineSpace = 0;
+        GDALRasterIOExtraArg sExtraArg{};
+    };
+
+    struct Job
+    {
+        Context *psContext = nullptr;
+        VRTSource *poSource = nullptr;
+        int nOutXOff = 0;
+        int nOutYOff = 0;
+        int nOutXSize = 0;
+        int nOutYSize = 0;
+        int nPass = 0;
+        CPLErr eErr = CE_None;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    // Collect contributing sources and assign them to passes.
+    // If the datasets belong to the MEM driver, compare GDALDataset*
+    // pointer values. Otherwise use dataset name.
+    std::vector<Job> asJobs;
+    std::vector<std::set<std::string>> aoSetDatasetNamesPerPass;
+    std::vector<std::set<GDALDataset *>> aoSetDatasetPointersPerPass;
+    for (const int iSource : anSources)
+    {
+        if (!papoSources[iSource]->IsSimpleSource())
+            return false;
+        VRTSimpleSource *const poSource =
+            static_cast<VRTSimpleSource *>(papoSources[iSource]);
+
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        Job sJob;
+        bool bError = false;
+        if (!poSource->GetSrcDstWindow(
+                dfXOff, dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize,
+                &dfReqXOff, &dfReqYOff, &dfReqXSize, &dfReqYSize, &nReqXOff,
+                &nReqYOff, &nReqXSize, &nReqYSize, &sJob.nOutXOff,
+                &sJob.nOutYOff, &sJob.nOutXSize, &sJob.nOutYSize, bError))
+        {
+            if (bError)
+                return false;
+            continue;
+        }
+
+        // Opening the source touches state shared by the VRT dataset, so
+        // this must be done here and not from the worker threads.
+        auto poSourceBand = poSource->GetRasterBand();
+        if (poSourceBand == nullptr)
+            return false;
+        auto poSourceDataset = poSourceBand->GetDataset();
+        if (poSourceDataset == nullptr)
+            return false;
+        auto poDriver = poSourceDataset->GetDriver();
+        const bool bIsMEM =
+            poDriver && EQUAL(poDriver->GetDescription(), "MEM");
+
+        for (const auto &sOtherJob : asJobs)
+        {
+            if (sOtherJob.nPass >= sJob.nPass &&
+                sOtherJob.nOutXOff < sJob.nOutXOff + sJob.nOutXSize &&
+                sJob.nOutXOff < sOtherJob.nOutXOff + sOtherJob.nOutXSize &&
+                sOtherJob.nOutYOff < sJob.nOutYOff + sJob.nOutYSize &&
+                sJob.nOutYOff < sOtherJob.nOutYOff + sOtherJob.nOutYSize)
+            {
+                sJob.nPass = sOtherJob.nPass + 1;
+            }
+        }
+        for (;; ++sJob.nPass)
+        {
+            if (static_cast<size_t>(sJob.nPass) ==
+                aoSetDatasetNamesPerPass.size())
+            {
+                aoSetDatasetNamesPerPass.resize(sJob.nPass + 1);
+                aoSetDatasetPointersPerPass.resize(sJob.nPass + 1);
+            }
+            if (bIsMEM)
+            {
+                if (aoSetDatasetPointersPerPass[sJob.nPass]
+                        .insert(poSourceDataset)
+                        .second)
+                    break;
+            }
+            else
+            {
+                if (aoSetDatasetNamesPerPass[sJob.nPass]
+                        .insert(poSourceDataset->GetDescription())
+                        .second)
+                    break;
+            }
+        }
+
+        sJob.poSource = poSource;
+        asJobs.emplace_back(std::move(sJob));
+    }
+
+    const int nPasses = static_cast<int>(aoSetDatasetNamesPerPass.size());
+    if (asJobs.size() < 2 || static_cast<size_t>(nPasses) == asJobs.size())
+        return false;
+
+    int nThreads = 1;
+    auto poQueue =
+        GetIRasterIOJobQueue(static_cast<int>(asJobs.size()), nThreads);
+    if (poQueue == nullptr)
+        return false;
+
+    CPLDebugOnly("VRT",
+                 "IRasterIO(): reading %d sources in %d passes with "
+                 "%d threads",
+                 static_cast<int>(asJobs.size()), nPasses, nThreads);
+
+    Context sContext;
+    sContext.eVRTDataType = eDataType;
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.pData = pData;
+    sContext.nBufXSize = nBufXSize;
+    sContext.nBufYSize = nBufYSize;
+    sContext.eBufType = eBufType;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.sExtraArg = *psExtraArg;
+    sContext.sExtraArg.pfnProgress = nullptr;
+    sContext.sExtraArg.pProgressData = nullptr;
+
+    const auto JobRunner = [](void *pDataIn)
+    {
+        auto psJob = static_cast<Job *>(pDataIn);
+        auto psContext = psJob->psContext;
+        GDALRasterIOExtraArg sExtraArg = psContext->sExtraArg;
+
+        bThreadLocalInVRTSourcesWorker = true;
+        CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+        psJob->eErr = psJob->poSource->RasterIO(
+            psContext->eVRTDataType, psContext->nXOff, psContext->nYOff,
+            psContext->nXSize, psContext->nYSize, psContext->pData,
+            psContext->nBufXSize, psContext->nBufYSize, psContext->eBufType,
+            psContext->nPixelSpace, psContext->nLineSpace, &sExtraArg);
+        CPLUninstallErrorHandlerAccumulator();
+        bThreadLocalInVRTSourcesWorker = false;
+    };
+
+    size_t nJobsDone = 0;
+    eErr = CE_None;
+    for (int iPass = 0; eErr == CE_None && iPass < nPasses; ++iPass)
+    {
+        for (auto &sJob : asJobs)
+        {
+            if (sJob.nPass != iPass)
+                continue;
+            sJob.psContext = &sContext;
+            // The global pool may have more threads than requested
+            poQueue->WaitCompletion(nThreads - 1);
+            if (!poQueue->SubmitJob(JobRunner, &sJob))
+            {
+                sJob.eErr = CE_Failure;
+            }
+        }
+        poQueue->WaitCompletion();
+
+        // Re-emit errors in source order from the calling thread.
+        for (const auto &sJob : asJobs)
+        {
+            if (sJob.nPass != iPass)
+                continue;
+            for (const auto &oError : sJob.aoErrors)
+            {
+                CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            }
+            if (sJob.eErr != CE_None)
+                eErr = CE_Failure;
+            ++nJobsDone;
+        }
+
+        if (eErr == CE_None && psExtraArg->pfnProgress &&
+            !psExtraArg->pfnProgress(static_cast<double>(nJobsDone) /
+                                         asJobs.size(),
+                                     "", psExtraArg->pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -357,17 +633,37 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
     /* -------------------------------------------------------------------- */
     /*      Overlay each source in turn over top this.                      */
     /* -------------------------------------------------------------------- */
+    std::vector<int> anSources;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        GetSourcesIntersectingWindow(psExtraArg->dfXOff, psExtraArg->dfYOff,
+                                     psExtraArg->dfXSize, psExtraArg->dfYSize,
+                                     anSources);
+    }
+    else
+    {
+        GetSourcesIntersectingWindow(nXOff, nYOff, nXSize, nYSize, anSources);
+    }
+    const int nCandidateSources = static_cast<int>(anSources.size());
+
     CPLErr eErr = CE_None;
-    for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+    if (IRasterIOSourcesInParallel(nXOff, nYOff, nXSize, nYSize, pData,
+                                   nBufXSize, nBufYSize, eBufType, nPixelSpace,
+                                   nLineSpace, psExtraArg, anSources, eErr))
+    {
+        return eErr;
+    }
+
+    for (int i = 0; eErr == CE_None && i < nCandidateSources; i++)
     {
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData = GDALCreateScaledProgress(
-            1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+            1.0 * i / nCandidateSources, 1.0 * (i + 1) / nCandidateSources,
             pfnProgressGlobal, pProgressDataGlobal);
         if (psExtraArg->pProgressData == nullptr)
             psExtraArg->pfnProgress = nullptr;
 
-        eErr = papoSources[iSource]->RasterIO(
+        eErr = papoSources[anSources[i]]->RasterIO(
             eDataType, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
             nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
 
@@ -414,7 +710,9 @@ int VRTSourcedRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff,
     poLR->addPoint(nXOff, nYOff);
     poPolyNonCoveredBySources->addRingDirectly(poLR);
 
-    for (int iSource = 0; iSource < nSources; iSource++)
+    std::vector<int> anSources;
+    GetSourcesIntersectingWindow(nXOff, nYOff, nXSize, nYSize, anSources);
+    for (const int iSource : anSources)
     {
         if (!papoSources[iSource]->IsSimpleSource())
         {
@@ -1766,6 +2064,7 @@ CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
     papoSources = static_cast<VRTSource **>(
         CPLRealloc(papoSources, sizeof(void *) * nSources));
     papoSources[nSources - 1] = poNewSource;
+    InvalidateSourcesQuadTree();
 
     static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 
@@ -2551,6 +2850,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem(const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourcesQuadTree();
             static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
             return CE_None;
         }
@@ -2582,6 +2882,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
             CPLFree(papoSources);
             papoSources = nullptr;
             nSources = 0;
+            InvalidateSourcesQuadTree();
         }
 
         for (int i = 0; i < CSLCount(papszNewMD); i++)
@@ -2642,6 +2943,8 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
 {
     int ret = VRTRasterBand::CloseDependentDatasets();
 
+    InvalidateSourcesQuadTree();
+
     if (nSources == 0)
         return ret;
 
@@ -2845,9 +3148,117 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
             papoSources[iDst++] = papoSources[iSrc];
     }
     nSources = iDst;
+    InvalidateSourcesQuadTree();
 
     CPLQuadTreeDestroy(hTree);
 #endif
 }
 
+/************************************************************************/
+/*                     InvalidateSourcesQuadTree()                      */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourcesQuadTree()
+{
+    if (m_hSourcesQuadTree)
+    {
+        CPLQuadTreeDestroy(m_hSourcesQuadTree);
+        m_hSourcesQuadTree = nullptr;
+    }
+    m_nSourcesInQuadTree = 0;
+    m_anSourcesNotInQuadTree.clear();
+}
+
+/************************************************************************/
+/*                   GetSourcesIntersectingWindow()                     */
+/************************************************************************/
+
+/** Return, in increasing order, the indices of the sources that may write
+ * into the (dfXOff, dfYOff, dfXSize, dfYSize) window of the band.
+ *
+ * For mosaics with many sources, a spatial index of the destination windows
+ * of the sources is built on the first call, so that requests only visit the
+ * sources around them. Sources that are not simple sources, or have no
+ * destination window, are always returned.
+ */
+void VRTSourcedRasterBand::GetSourcesIntersectingWindow(
+    double dfXOff, double dfYOff, double dfXSize, double dfYSize,
+    std::vector<int> &anSources)
+{
+    anSources.clear();
+
+    constexpr int MIN_SOURCES_FOR_QUAD_TREE = 64;
+    if (nSources < MIN_SOURCES_FOR_QUAD_TREE)
+    {
+        for (int i = 0; i < nSources; ++i)
+            anSources.push_back(i);
+        return;
+    }
+
+    // Sources are normally added through AddSource(), but some code
+    // directly manipulates nSources.
+    if (m_hSourcesQuadTree && m_nSourcesInQuadTree != nSources)
+        InvalidateSourcesQuadTree();
+
+    if (m_hSourcesQuadTree == nullptr)
+    {
+        CPLRectObj sGlobalBounds;
+        sGlobalBounds.minx = 0;
+        sGlobalBounds.miny = 0;
+        sGlobalBounds.maxx = nRasterXSize;
+        sGlobalBounds.maxy = nRasterYSize;
+        m_hSourcesQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+        m_nSourcesInQuadTree = nSources;
+
+        for (int i = 0; i < nSources; ++i)
+        {
+            if (!papoSources[i]->IsSimpleSource())
+            {
+                m_anSourcesNotInQuadTree.push_back(i);
+                continue;
+            }
+            const VRTSimpleSource *poSS =
+                cpl::down_cast<VRTSimpleSource *>(papoSources[i]);
+            const bool bDstWinSet =
+                poSS->m_dfDstXOff != -1 || poSS->m_dfDstXSize != -1 ||
+                poSS->m_dfDstYOff != -1 || poSS->m_dfDstYSize != -1;
+            if (!bDstWinSet || !(poSS->m_dfDstXSize > 0) ||
+                !(poSS->m_dfDstYSize > 0))
+            {
+                m_anSourcesNotInQuadTree.push_back(i);
+                continue;
+            }
+
+            CPLRectObj sRect;
+            sRect.minx = poSS->m_dfDstXOff;
+            sRect.miny = poSS->m_dfDstYOff;
+            sRect.maxx = poSS->m_dfDstXOff + poSS->m_dfDstXSize;
+            sRect.maxy = poSS->m_dfDstYOff + poSS->m_dfDstYSize;
+            CPLQuadTreeInsertWithBounds(
+                m_hSourcesQuadTree,
+                reinterpret_cast<void *>(static_cast<uintptr_t>(i)), &sRect);
+        }
+    }
+
+    // The quad tree returns rectangles that merely touch the window, which
+    // the sources themselves discard in GetSrcDstWindow().
+    CPLRectObj sRect;
+    sRect.minx = dfXOff;
+    sRect.miny = dfYOff;
+    sRect.maxx = dfXOff + dfXSize;
+    sRect.maxy = dfYOff + dfYSize;
+    int nFeatureCount = 0;
+    void **pahFeatures =
+        CPLQuadTreeSearch(m_hSourcesQuadTree, &sRect, &nFeatureCount);
+    anSources = m_anSourcesNotInQuadTree;
+    anSources.reserve(anSources.size() + nFeatureCount);
+    for (int i = 0; i < nFeatureCount; ++i)
+    {
+        anSources.push_back(
+            static_cast<int>(reinterpret_cast<uintptr_t>(pahFeatures[i])));
+    }
+    CPLFree(pahFeatures);
+    std::sort(anSources.begin(), anSources.end());
+}
+
 /*! @endcond */
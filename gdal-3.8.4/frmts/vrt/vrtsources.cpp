@@ -551,7 +551,15 @@ VRTSimpleSource::XMLInit(CPLXMLNode *psSrc, const char *pszVRTPath,
         m_nExplicitSharedStatus = CPLTestBool(pszShared);
     }
 
-    if (pszVRTPath != nullptr && m_bRelativeToVRTOri)
+    if (pszVRTPath != nullptr && m_bRelativeToVRTOri &&
+        strchr(pszFilename, ':') == nullptr)
+    {
+        // Fast path for plain filenames, as used by mosaics with many
+        // sources: neither subdataset nor special syntaxes can apply,
+        // and probing every driver for each source is costly.
+        m_osSrcDSName = CPLProjectRelativeFilename(pszVRTPath, pszFilename);
+    }
+    else if (pszVRTPath != nullptr && m_bRelativeToVRTOri)
     {
         // Try subdatasetinfo API first
         // Note: this will become the only branch when subdatasetinfo will become
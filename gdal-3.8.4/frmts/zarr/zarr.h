@@ -30,12 +30,18 @@
 #define ZARR_H
 
 #include "cpl_compressor.h"
+#include "cpl_error_internal.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
 
 #include <array>
+#include <condition_variable>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -769,6 +775,20 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     };
     mutable std::map<uint64_t, CachedTile> m_oMapTileIndexToCachedTile{};
 
+    // Asynchronous encoding and writing of dirty tiles. See
+    // GetTileWriteJobQueue()
+    mutable bool m_bTileWriteJobQueueInitDone = false;
+    mutable int m_nMaxPendingTileWrites = 0;
+    mutable std::mutex m_oTileWriteMutex{};
+    mutable std::condition_variable m_oTileWriteCV{};
+    mutable std::set<std::string> m_oSetPendingTileWrites{};
+    mutable bool m_bTileWriteError = false;
+    mutable std::vector<CPLErrorHandlerAccumulatorStruct>
+        m_aoTileWriteErrors{};
+    // Must be declared after the above members, so that it is destroyed,
+    // and thus waits for its jobs, before them.
+    mutable std::unique_ptr<CPLJobQueue> m_poTileWriteJobQueue{};
+
     static uint64_t
     ComputeTileCount(const std::string &osName,
                      const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -800,6 +820,20 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
 
     virtual bool FlushDirtyTile() const = 0;
 
+    CPLJobQueue *GetTileWriteJobQueue(size_t nJobSize) const;
+
+    bool SubmitTileWrite(
+        const std::string &osFilename,
+        std::function<bool(const std::string &, ZarrByteVectorQuickResize &)>
+            &&fnEncodeAndWrite) const;
+
+    bool SubmitWrite(const std::string &osFilename,
+                     std::function<bool(const std::string &)> &&fnWrite) const;
+
+    void WaitTileWrite(const std::string &osFilename) const;
+
+    bool EmitTileWriteErrors() const;
+
     std::shared_ptr<GDALMDArray> OpenTilePresenceCache(bool bCanCreate) const;
 
     void NotifyChildrenOfRenaming() override;
@@ -844,6 +878,8 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
   public:
     ~ZarrArray() override;
 
+    bool WaitTileWrites() const;
+
     static bool ParseChunkSize(const CPLJSONArray &oChunks,
                                const GDALExtendedDataType &oType,
                                std::vector<GUInt64> &anBlockSize);
@@ -1103,6 +1139,10 @@ class ZarrV2Array final : public ZarrArray
 
     bool FlushDirtyTile() const override;
 
+    bool EncodeAndWriteTile(const std::string &osFilename,
+                            ZarrByteVectorQuickResize &abyRawTileData,
+                            ZarrByteVectorQuickResize &abyTmpRawTileData) const;
+
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
 
     bool AllocateWorkingBuffers() const override;
@@ -1122,6 +1162,9 @@ struct ZarrArrayMetadata
 {
     DtypeElt oElt{};
     std::vector<size_t> anBlockSizes{};
+    // Fill value of an element, in its native representation, or empty if
+    // it is made of zero bytes
+    std::vector<GByte> abyFillValue{};
 
     size_t GetEltCount() const
     {
@@ -1378,13 +1421,50 @@ class ZarrV3CodecTranspose final : public ZarrV3Codec
                 ZarrByteVectorQuickResize &abyDst) const override;
 };
 
+/************************************************************************/
+/*                          ZarrV3CodecCRC32C                           */
+/************************************************************************/
+
+// Implements https://zarr-specs.readthedocs.io/en/latest/v3/codecs/crc32c/v1.0.html
+class ZarrV3CodecCRC32C final : public ZarrV3Codec
+{
+  public:
+    static constexpr const char *NAME = "crc32c";
+
+    ZarrV3CodecCRC32C();
+    ~ZarrV3CodecCRC32C() override;
+
+    IOType GetInputType() const override
+    {
+        return IOType::BYTES;
+    }
+    IOType GetOutputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    bool
+    InitFromConfiguration(const CPLJSONObject &configuration,
+                          const ZarrArrayMetadata &oInputArrayMetadata,
+                          ZarrArrayMetadata &oOutputArrayMetadata) override;
+
+    std::unique_ptr<ZarrV3Codec> Clone() const override;
+
+    bool Encode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+    bool Decode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+};
+
 /************************************************************************/
 /*                          ZarrV3CodecSequence                         */
 /************************************************************************/
 
+class ZarrV3CodecShardingIndexed;
+
 class ZarrV3CodecSequence
 {
-    const ZarrArrayMetadata m_oInputArrayMetadata;
+    ZarrArrayMetadata m_oInputArrayMetadata;
     std::vector<std::unique_ptr<ZarrV3Codec>> m_apoCodecs{};
     CPLJSONObject m_oCodecArray{};
     ZarrByteVectorQuickResize m_abyTmp{};
@@ -1402,6 +1482,8 @@ class ZarrV3CodecSequence
 
     bool InitFromJson(const CPLJSONObject &oCodecs);
 
+    bool SetFillValue(const std::vector<GByte> &abyFillValue);
+
     const CPLJSONObject &GetJSon() const
     {
         return m_oCodecArray;
@@ -1409,6 +1491,93 @@ class ZarrV3CodecSequence
 
     bool Encode(ZarrByteVectorQuickResize &abyBuffer);
     bool Decode(ZarrByteVectorQuickResize &abyBuffer);
+
+    ZarrV3CodecShardingIndexed *GetShardingCodec() const;
+};
+
+/************************************************************************/
+/*                      ZarrV3CodecShardingIndexed                      */
+/************************************************************************/
+
+// Implements https://zarr-specs.readthedocs.io/en/latest/v3/codecs/sharding-indexed/v1.0.html
+class ZarrV3CodecShardingIndexed final : public ZarrV3Codec
+{
+    // Shape of the inner chunks
+    std::vector<size_t> m_anInnerBlockSize{};
+    // Number of inner chunks along each dimension of the shard
+    std::vector<size_t> m_anInnerBlockCount{};
+    std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
+    std::unique_ptr<ZarrV3CodecSequence> m_poIndexCodecs{};
+    size_t m_nIndexSize = 0;
+    bool m_bIndexLocationAtEnd = true;
+
+    void CopyInnerChunk(size_t nInnerChunkIdx, const GByte *pabySrc,
+                        GByte *pabyDst, bool bFromShard) const;
+
+  public:
+    static constexpr const char *NAME = "sharding_indexed";
+
+    // Value of the offset and size of a missing inner chunk in the index
+    static constexpr uint64_t MISSING_CHUNK =
+        std::numeric_limits<uint64_t>::max();
+
+    ZarrV3CodecShardingIndexed();
+    ~ZarrV3CodecShardingIndexed() override;
+
+    IOType GetInputType() const override
+    {
+        return IOType::ARRAY;
+    }
+    IOType GetOutputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    static CPLJSONObject
+    GetConfiguration(const std::vector<GUInt64> &anInnerBlockSize,
+                     const CPLJSONArray &oCodecs);
+
+    bool
+    InitFromConfiguration(const CPLJSONObject &configuration,
+                          const ZarrArrayMetadata &oInputArrayMetadata,
+                          ZarrArrayMetadata &oOutputArrayMetadata) override;
+
+    std::unique_ptr<ZarrV3Codec> Clone() const override;
+
+    bool Encode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+    bool Decode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+
+    const std::vector<size_t> &GetInnerBlockSize() const
+    {
+        return m_anInnerBlockSize;
+    }
+
+    size_t GetInnerChunkCount() const;
+
+    // Codecs applied to each inner chunk
+    ZarrV3CodecSequence *GetInnerCodecs() const
+    {
+        return m_poCodecs.get();
+    }
+
+    // Size in bytes of the encoded index
+    size_t GetIndexSize() const
+    {
+        return m_nIndexSize;
+    }
+
+    bool IsIndexLocationAtEnd() const
+    {
+        return m_bIndexLocationAtEnd;
+    }
+
+    // The index is made of (offset, size) pairs, one per inner chunk
+    bool DecodeIndex(ZarrByteVectorQuickResize &abyIndex,
+                     std::vector<uint64_t> &anIndex) const;
+    bool EncodeIndex(const std::vector<uint64_t> &anIndex,
+                     ZarrByteVectorQuickResize &abyIndex) const;
 };
 
 /************************************************************************/
@@ -1420,6 +1589,32 @@ class ZarrV3Array final : public ZarrArray
     bool m_bV2ChunkKeyEncoding = false;
     std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
 
+    // Shape of the shards, when the codecs are made of a single
+    // sharding_indexed codec. m_anBlockSize is then the shape of the inner
+    // chunks, which are read and written individually.
+    std::vector<GUInt64> m_anShardBlockSize{};
+
+    // Decoded indices of shards, keyed by shard filename. An empty index
+    // means that the shard does not exist.
+    mutable lru11::Cache<std::string,
+                         std::shared_ptr<const std::vector<uint64_t>>,
+                         std::mutex>
+        m_oCacheShardIndex{};
+
+    // Inner chunks written, but not yet their shard
+    struct PendingShard
+    {
+        // Raw content of inner chunks, indexed by their position in the
+        // shard. An empty vector is an inner chunk with only the fill value.
+        std::map<size_t, std::vector<GByte>> oMapInnerChunks{};
+        // To find the least recently created pending shard
+        uint64_t nCounter = 0;
+    };
+    mutable std::map<std::vector<uint64_t>, PendingShard>
+        m_oMapPendingShards{};
+    mutable size_t m_nPendingShardsSize = 0;
+    mutable uint64_t m_nPendingShardsCounter = 0;
+
     ZarrV3Array(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
                 const std::string &osParentName, const std::string &osName,
                 const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -1441,6 +1636,38 @@ class ZarrV3Array final : public ZarrArray
                       ZarrByteVectorQuickResize &abyDecodedTileData,
                       bool &bMissingTileOut) const;
 
+    bool IsSharded() const
+    {
+        return !m_anShardBlockSize.empty();
+    }
+
+    std::vector<GByte> GetNativeFillValue() const;
+
+    std::string BuildChunkFilename(const uint64_t *chunkIndices) const;
+
+    std::vector<uint64_t> GetShardIndices(const uint64_t *tileIndices,
+                                          size_t &nInnerChunkIdx) const;
+
+    size_t GetInnerChunkCountInShard(const uint64_t *tileIndices) const;
+
+    bool LoadInnerChunkData(const uint64_t *tileIndices, bool bUseMutex,
+                            ZarrV3CodecSequence *poCodecs,
+                            ZarrByteVectorQuickResize &abyRawTileData,
+                            bool &bMissingTileOut) const;
+
+    void DecodeSourceElts(const ZarrByteVectorQuickResize &abyRawTileData,
+                          ZarrByteVectorQuickResize &abyDecodedTileData) const;
+
+    bool AddPendingInnerChunk(bool bEmpty) const;
+
+    bool FlushPendingShard(const std::vector<uint64_t> &anShardIndices) const;
+
+    bool FlushPendingShards() const;
+
+    bool WriteShard(const std::string &osFilename,
+                    const std::map<size_t, std::vector<GByte>> &oMapInnerChunks,
+                    ZarrV3CodecSequence *poCodecs) const;
+
   public:
     ~ZarrV3Array() override;
 
@@ -1457,9 +1684,13 @@ class ZarrV3Array final : public ZarrArray
         m_bV2ChunkKeyEncoding = b;
     }
 
-    void SetCodecs(std::unique_ptr<ZarrV3CodecSequence> &&poCodecs)
+    void SetCodecs(std::unique_ptr<ZarrV3CodecSequence> &&poCodecs);
+
+    bool SetRawNoDataValue(const void *pRawNoData) override;
+
+    void SetShardBlockSize(const std::vector<GUInt64> &anShardBlockSize)
     {
-        m_poCodecs = std::move(poCodecs);
+        m_anShardBlockSize = anShardBlockSize;
     }
 
     void Flush() override;
@@ -1474,6 +1705,10 @@ class ZarrV3Array final : public ZarrArray
 
     bool FlushDirtyTile() const override;
 
+    bool EncodeAndWriteTile(const std::string &osFilename,
+                            ZarrByteVectorQuickResize &abyRawTileData,
+                            ZarrV3CodecSequence *poCodecs) const;
+
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
 
     bool LoadTileData(const uint64_t *tileIndices,
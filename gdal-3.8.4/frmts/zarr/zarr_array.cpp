@@ -30,6 +30,7 @@
 #include "ucs4_utf8.hpp"
 
 #include "cpl_float.h"
+#include "gdal_thread_pool.h"
 
 #include "netcdf_cf_constants.h"  // for CF_UNITS, etc
 
@@ -967,6 +968,11 @@ bool ZarrArray::IAdviseReadCommon(const GUInt64 *arrayStartIdx,
     CPLDebug(ZARR_DEBUG_KEY, "IAdviseRead(): Using up to %d threads",
              nThreadsMax);
 
+    // Tiles being written in the background must be on disk before the
+    // jobs of IAdviseRead() read them
+    if (!WaitTileWrites())
+        return false;
+
     m_oMapTileIndexToCachedTile.clear();
 
     // Overflow checked above
@@ -1185,6 +1191,9 @@ lbl_next_depth:
                 if (!FlushDirtyTile())
                     return false;
 
+                if (m_poTileWriteJobQueue)
+                    WaitTileWrite(BuildTileFilename(tileIndices.data()));
+
                 m_anCachedTiledIndices = tileIndices;
                 m_bCachedTiledValid =
                     LoadTileData(tileIndices.data(), bEmptyTile);
@@ -1693,6 +1702,8 @@ lbl_next_depth:
             {
                 // If we don't write the whole tile, we need to fetch a
                 // potentially existing one.
+                if (m_poTileWriteJobQueue)
+                    WaitTileWrite(BuildTileFilename(tileIndices.data()));
                 bool bEmptyTile = false;
                 m_bCachedTiledValid =
                     LoadTileData(tileIndices.data(), bEmptyTile);
@@ -2038,6 +2049,213 @@ bool ZarrArray::IsEmptyTile(const ZarrByteVectorQuickResize &abyTile) const
     return false;
 }
 
+/************************************************************************/
+/*                  ZarrArray::GetTileWriteJobQueue()                   */
+/************************************************************************/
+
+// Returns the queue in which FlushDirtyTile() submits the encoding and
+// writing of dirty tiles to the global thread pool, or nullptr if tiles must
+// be written synchronously, which is the default unless GDAL_NUM_THREADS is
+// set to a value greater than one.
+// The number of jobs in flight is bounded by twice the number of threads,
+// and by the GDAL_ZARR_WRITE_CACHE_SIZE budget (in bytes of uncompressed tile
+// data), which defaults to a quarter of the block cache size. nJobSize is the
+// number of uncompressed bytes a job holds, and is only taken into account at
+// the first call.
+
+CPLJobQueue *ZarrArray::GetTileWriteJobQueue(size_t nJobSize) const
+{
+    if (m_bTileWriteJobQueueInitDone)
+        return m_poTileWriteJobQueue.get();
+    m_bTileWriteJobQueueInitDone = true;
+
+    const int nThreads = GDALGetNumThreads();
+    if (nThreads <= 1)
+        return nullptr;
+
+    CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreads);
+    if (wtp == nullptr)
+        return nullptr;
+
+    const GIntBig nBudget = std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption(
+               "GDAL_ZARR_WRITE_CACHE_SIZE",
+               CPLSPrintf(CPL_FRMT_GIB, GDALGetCacheMax64() / 4))));
+    const GIntBig nJobSizeBig =
+        std::max<GIntBig>(1, static_cast<GIntBig>(nJobSize));
+    m_nMaxPendingTileWrites = static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(2 * nThreads, nBudget / nJobSizeBig)));
+    CPLDebug(ZARR_DEBUG_KEY,
+             "Writing tiles of %s with up to %d threads and %d jobs in "
+             "flight",
+             GetFullName().c_str(), nThreads, m_nMaxPendingTileWrites);
+
+    m_poTileWriteJobQueue = wtp->CreateJobQueue();
+    return m_poTileWriteJobQueue.get();
+}
+
+/************************************************************************/
+/*                     ZarrArray::SubmitTileWrite()                     */
+/************************************************************************/
+
+// Submits a job that calls fnEncodeAndWrite(osFilename, abyRawTileData) on a
+// copy of m_abyRawTileData. See SubmitWrite().
+
+bool ZarrArray::SubmitTileWrite(
+    const std::string &osFilename,
+    std::function<bool(const std::string &, ZarrByteVectorQuickResize &)>
+        &&fnEncodeAndWrite) const
+{
+    auto poRawTileData = std::make_shared<ZarrByteVectorQuickResize>();
+    try
+    {
+        poRawTileData->resize(m_abyRawTileData.size());
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    memcpy(poRawTileData->data(), m_abyRawTileData.data(),
+           m_abyRawTileData.size());
+
+    const std::function<bool(const std::string &, ZarrByteVectorQuickResize &)>
+        fnEncodeAndWriteCopy(std::move(fnEncodeAndWrite));
+    return SubmitWrite(osFilename,
+                       [poRawTileData, fnEncodeAndWriteCopy](
+                           const std::string &osFilenameIn) {
+                           return fnEncodeAndWriteCopy(osFilenameIn,
+                                                       *poRawTileData);
+                       });
+}
+
+/************************************************************************/
+/*                       ZarrArray::SubmitWrite()                       */
+/************************************************************************/
+
+// Submits a job that calls fnWrite(osFilename), once the number of jobs in
+// flight is below the limit. fnWrite() must not modify any ZarrArray member,
+// as it runs concurrently with the calling thread and with other jobs.
+// Returns false if a previously submitted job has failed.
+
+bool ZarrArray::SubmitWrite(
+    const std::string &osFilename,
+    std::function<bool(const std::string &)> &&fnWrite) const
+{
+    CPLAssert(m_poTileWriteJobQueue);
+
+    struct JobStruct
+    {
+        const ZarrArray *poArray = nullptr;
+        std::string osFilename{};
+        std::function<bool(const std::string &)> fnWrite{};
+    };
+
+    // Back-pressure: wait for a slot to be available
+    m_poTileWriteJobQueue->WaitCompletion(m_nMaxPendingTileWrites - 1);
+    // and for a previous version of that file to be written
+    WaitTileWrite(osFilename);
+    if (!EmitTileWriteErrors())
+        return false;
+
+    auto psJob = cpl::make_unique<JobStruct>();
+    psJob->poArray = this;
+    psJob->osFilename = osFilename;
+    psJob->fnWrite = std::move(fnWrite);
+
+    const auto JobFunc = [](void *pThreadData)
+    {
+        std::unique_ptr<JobStruct> psJobIn(
+            static_cast<JobStruct *>(pThreadData));
+        const auto poArray = psJobIn->poArray;
+
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+        CPLInstallErrorHandlerAccumulator(aoErrors);
+        const bool bRet = psJobIn->fnWrite(psJobIn->osFilename);
+        CPLUninstallErrorHandlerAccumulator();
+        const std::string osFilenameIn = std::move(psJobIn->osFilename);
+        // Release the data buffers before making room for another job
+        psJobIn.reset();
+
+        std::lock_guard<std::mutex> oLock(poArray->m_oTileWriteMutex);
+        if (!bRet)
+            poArray->m_bTileWriteError = true;
+        for (auto &oError : aoErrors)
+            poArray->m_aoTileWriteErrors.emplace_back(std::move(oError));
+        poArray->m_oSetPendingTileWrites.erase(osFilenameIn);
+        poArray->m_oTileWriteCV.notify_all();
+    };
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+        m_oSetPendingTileWrites.insert(osFilename);
+    }
+    if (!m_poTileWriteJobQueue->SubmitJob(JobFunc, psJob.get()))
+    {
+        std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+        m_oSetPendingTileWrites.erase(osFilename);
+        return false;
+    }
+    psJob.release();
+    return true;
+}
+
+/************************************************************************/
+/*                      ZarrArray::WaitTileWrite()                      */
+/************************************************************************/
+
+// Waits for a pending write of tile osFilename to be finished, so that it
+// can be read or written again.
+
+void ZarrArray::WaitTileWrite(const std::string &osFilename) const
+{
+    if (!m_poTileWriteJobQueue)
+        return;
+    std::unique_lock<std::mutex> oLock(m_oTileWriteMutex);
+    while (m_oSetPendingTileWrites.find(osFilename) !=
+           m_oSetPendingTileWrites.end())
+    {
+        m_oTileWriteCV.wait(oLock);
+    }
+}
+
+/************************************************************************/
+/*                     ZarrArray::WaitTileWrites()                      */
+/************************************************************************/
+
+// Waits for all pending tile writes to be finished. Returns false if any
+// of them failed.
+
+bool ZarrArray::WaitTileWrites() const
+{
+    if (!m_poTileWriteJobQueue)
+        return true;
+    m_poTileWriteJobQueue->WaitCompletion();
+    return EmitTileWriteErrors();
+}
+
+/************************************************************************/
+/*                   ZarrArray::EmitTileWriteErrors()                   */
+/************************************************************************/
+
+// Re-emits in the calling thread the errors and warnings raised by tile
+// write jobs since the last call. Returns false if any of them failed.
+
+bool ZarrArray::EmitTileWriteErrors() const
+{
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    bool bError;
+    {
+        std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+        std::swap(aoErrors, m_aoTileWriteErrors);
+        bError = m_bTileWriteError;
+        m_bTileWriteError = false;
+    }
+    for (const auto &oError : aoErrors)
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    return !bError;
+}
+
 /************************************************************************/
 /*                  ZarrArray::OpenTilePresenceCache()                  */
 /************************************************************************/
@@ -2684,6 +2902,9 @@ bool ZarrArray::Rename(const std::string &osNewName)
     const std::string osNewDirectoryName = CPLFormFilename(
         osRootDirectoryName.c_str(), osNewName.c_str(), nullptr);
 
+    if (!WaitTileWrites())
+        return false;
+
     if (VSIRename(osOldDirectoryName.c_str(), osNewDirectoryName.c_str()) != 0)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Renaming of %s to %s failed",
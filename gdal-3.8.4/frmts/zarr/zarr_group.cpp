@@ -267,6 +267,14 @@ bool ZarrGroupBase::DeleteMDArray(const std::string &osName,
         return false;
     }
 
+    auto oIter = m_oMapMDArrays.find(osName);
+    if (oIter != m_oMapMDArrays.end())
+    {
+        // Do not let tiles being written in the background re-create
+        // the directory
+        oIter->second->WaitTileWrites();
+    }
+
     const std::string osSubDirName =
         CPLFormFilename(m_osDirectoryName.c_str(), osName.c_str(), nullptr);
     if (VSIRmdirRecursive(osSubDirName.c_str()) != 0)
@@ -280,7 +288,6 @@ bool ZarrGroupBase::DeleteMDArray(const std::string &osName,
 
     m_aosArrays.erase(oIterNames);
 
-    auto oIter = m_oMapMDArrays.find(osName);
     if (oIter != m_oMapMDArrays.end())
     {
         oIter->second->Deleted();
@@ -75,6 +75,7 @@ ZarrV2Array::Create(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
     if (arr->m_nTotalTileCount == 0)
         return nullptr;
     arr->SetSelf(arr);
+    arr->EnableChunkCache();
 
     return arr;
 }
@@ -86,6 +87,9 @@ ZarrV2Array::Create(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
 ZarrV2Array::~ZarrV2Array()
 {
     ZarrV2Array::Flush();
+    // Flush() does nothing on a deleted array, but jobs of the tile write
+    // queue must not outlive it
+    WaitTileWrites();
 }
 
 /************************************************************************/
@@ -98,6 +102,7 @@ void ZarrV2Array::Flush()
         return;
 
     ZarrV2Array::FlushDirtyTile();
+    WaitTileWrites();
 
     if (m_bDefinitionModified)
     {
@@ -826,6 +831,7 @@ bool ZarrV2Array::FlushDirtyTile() const
     {
         m_bCachedTiledEmpty = true;
 
+        WaitTileWrite(osFilename);
         VSIStatBufL sStat;
         if (VSIStatL(osFilename.c_str(), &sStat) == 0)
         {
@@ -850,13 +856,58 @@ bool ZarrV2Array::FlushDirtyTile() const
         }
     }
 
+    if (GetTileWriteJobQueue(m_abyRawTileData.size()))
+    {
+        return SubmitTileWrite(
+            osFilename,
+            [this](const std::string &osFilenameIn,
+                   ZarrByteVectorQuickResize &abyRawTileData)
+            {
+                ZarrByteVectorQuickResize abyTmpRawTileData;
+                if (m_bFortranOrder || m_oFiltersArray.Size() != 0)
+                {
+                    try
+                    {
+                        abyTmpRawTileData.resize(m_nTileSize);
+                    }
+                    catch (const std::bad_alloc &e)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+                        return false;
+                    }
+                }
+                return EncodeAndWriteTile(osFilenameIn, abyRawTileData,
+                                          abyTmpRawTileData);
+            });
+    }
+
+    return EncodeAndWriteTile(osFilename, m_abyRawTileData,
+                              m_abyTmpRawTileData);
+}
+
+/************************************************************************/
+/*                  ZarrV2Array::EncodeAndWriteTile()                   */
+/************************************************************************/
+
+bool ZarrV2Array::EncodeAndWriteTile(
+    const std::string &osFilename, ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyTmpRawTileData) const
+{
+    // This method should NOT modify any ZarrArray member, as it may be
+    // called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyTmpRawTileData cannot_use_here
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+
     if (m_bFortranOrder && !m_aoDims.empty())
     {
-        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        BlockTranspose(abyRawTileData, abyTmpRawTileData, false);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
-    size_t nRawDataSize = m_abyRawTileData.size();
+    size_t nRawDataSize = abyRawTileData.size();
     for (const auto &oFilter : m_oFiltersArray)
     {
         const auto osFilterId = oFilter["id"].ToString();
@@ -869,10 +920,10 @@ bool ZarrV2Array::FlushDirtyTile() const
             aosOptions.SetNameValue(obj.GetName().c_str(),
                                     obj.ToString().c_str());
         }
-        void *out_buffer = &m_abyTmpRawTileData[0];
-        size_t nOutSize = m_abyTmpRawTileData.size();
+        void *out_buffer = &abyTmpRawTileData[0];
+        size_t nOutSize = abyTmpRawTileData.size();
         if (!psFilterCompressor->pfnFunc(
-                m_abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
+                abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
                 aosOptions.List(), psFilterCompressor->user_data))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -882,12 +933,14 @@ bool ZarrV2Array::FlushDirtyTile() const
         }
 
         nRawDataSize = nOutSize;
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
     if (m_osDimSeparator == "/")
     {
         std::string osDir = CPLGetDirname(osFilename.c_str());
+        // Serialize against concurrent creation of the same directory
+        std::lock_guard<std::mutex> oLock(m_oMutex);
         VSIStatBufL sStat;
         if (VSIStatL(osDir.c_str(), &sStat) != 0)
         {
@@ -911,7 +964,7 @@ bool ZarrV2Array::FlushDirtyTile() const
     bool bRet = true;
     if (m_psCompressor == nullptr)
     {
-        if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
             nRawDataSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -957,7 +1010,7 @@ bool ZarrV2Array::FlushDirtyTile() const
             }
 
             if (!m_psCompressor->pfnFunc(
-                    m_abyRawTileData.data(), nRawDataSize, &out_buffer,
+                    abyRawTileData.data(), nRawDataSize, &out_buffer,
                     &out_size, aosOptions.List(), m_psCompressor->user_data))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
@@ -979,6 +1032,10 @@ bool ZarrV2Array::FlushDirtyTile() const
     VSIFCloseL(fp);
 
     return bRet;
+
+#undef m_abyTmpRawTileData
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
 }
 
 /************************************************************************/
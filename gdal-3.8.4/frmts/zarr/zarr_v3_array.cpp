@@ -71,6 +71,7 @@ ZarrV3Array::Create(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
     if (arr->m_nTotalTileCount == 0)
         return nullptr;
     arr->SetSelf(arr);
+    arr->EnableChunkCache();
 
     return arr;
 }
@@ -82,6 +83,9 @@ ZarrV3Array::Create(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
 ZarrV3Array::~ZarrV3Array()
 {
     ZarrV3Array::Flush();
+    // Flush() does nothing on a deleted array, but jobs of the tile write
+    // queue must not outlive it
+    WaitTileWrites();
 }
 
 /************************************************************************/
@@ -94,6 +98,8 @@ void ZarrV3Array::Flush()
         return;
 
     ZarrV3Array::FlushDirtyTile();
+    FlushPendingShards();
+    WaitTileWrites();
 
     if (!m_aoDims.empty())
     {
@@ -131,6 +137,57 @@ void ZarrV3Array::Flush()
     }
 }
 
+/************************************************************************/
+/*                   ZarrV3Array::GetNativeFillValue()                  */
+/************************************************************************/
+
+// Returns the fill value in the native representation of the elements, as
+// output by the codecs, or an empty vector if it is made of zero bytes.
+
+std::vector<GByte> ZarrV3Array::GetNativeFillValue() const
+{
+    std::vector<GByte> abyFillValue;
+    if (m_pabyNoData == nullptr)
+        return abyFillValue;
+    const auto &oElt = m_aoDtypeElts.back();
+    abyFillValue.resize(oElt.nativeOffset + oElt.nativeSize);
+    EncodeElt(m_aoDtypeElts, m_pabyNoData, abyFillValue.data());
+    if (std::all_of(abyFillValue.begin(), abyFillValue.end(),
+                    [](GByte b) { return b == 0; }))
+    {
+        abyFillValue.clear();
+    }
+    return abyFillValue;
+}
+
+/************************************************************************/
+/*                       ZarrV3Array::SetCodecs()                       */
+/************************************************************************/
+
+void ZarrV3Array::SetCodecs(std::unique_ptr<ZarrV3CodecSequence> &&poCodecs)
+{
+    m_poCodecs = std::move(poCodecs);
+    if (m_poCodecs)
+        m_poCodecs->SetFillValue(GetNativeFillValue());
+}
+
+/************************************************************************/
+/*                   ZarrV3Array::SetRawNoDataValue()                   */
+/************************************************************************/
+
+bool ZarrV3Array::SetRawNoDataValue(const void *pRawNoData)
+{
+    if (!ZarrArray::SetRawNoDataValue(pRawNoData))
+        return false;
+    // Missing inner chunks of shards are read as the fill value
+    if (m_poCodecs && !m_poCodecs->SetFillValue(GetNativeFillValue()))
+    {
+        m_bValid = false;
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                    ZarrV3Array::Serialize()                          */
 /************************************************************************/
@@ -159,7 +216,8 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         CPLJSONObject oConfiguration;
         oChunkGrid.Add("configuration", oConfiguration);
         CPLJSONArray oChunks;
-        for (const auto nBlockSize : m_anBlockSize)
+        for (const auto nBlockSize :
+             IsSharded() ? m_anShardBlockSize : m_anBlockSize)
         {
             oChunks.Add(static_cast<GInt64>(nBlockSize));
         }
@@ -394,6 +452,18 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 
     bMissingTileOut = false;
 
+    if (IsSharded())
+    {
+        if (!LoadInnerChunkData(tileIndices, bUseMutex, poCodecs,
+                                abyRawTileData, bMissingTileOut))
+        {
+            return false;
+        }
+        if (!bMissingTileOut)
+            DecodeSourceElts(abyRawTileData, abyDecodedTileData);
+        return true;
+    }
+
     std::string osFilename = BuildTileFilename(tileIndices);
 
     // For network file systems, get the streaming version of the filename,
@@ -534,6 +604,23 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
         return false;
     }
 
+    DecodeSourceElts(abyRawTileData, abyDecodedTileData);
+
+    return true;
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::DecodeSourceElts()                   */
+/************************************************************************/
+
+void ZarrV3Array::DecodeSourceElts(
+    const ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData) const
+{
     if (!abyDecodedTileData.empty())
     {
         const size_t nSourceSize =
@@ -549,6 +636,204 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
             DecodeSourceElt(m_aoDtypeElts, pSrc, pDst);
         }
     }
+}
+
+/************************************************************************/
+/*                   ZarrV3Array::LoadInnerChunkData()                  */
+/************************************************************************/
+
+// Reads and decodes a single inner chunk of a shard, using the shard index
+// to issue a range read, rather than reading the whole shard.
+
+bool ZarrV3Array::LoadInnerChunkData(const uint64_t *tileIndices,
+                                     bool bUseMutex,
+                                     ZarrV3CodecSequence *poCodecs,
+                                     ZarrByteVectorQuickResize &abyRawTileData,
+                                     bool &bMissingTileOut) const
+{
+    // This method should NOT modify any ZarrArray member, as it is going to
+    // be called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+#define m_poCodecs cannot_use_here
+
+    size_t nInnerChunkIdx = 0;
+    const auto anShardIndices = GetShardIndices(tileIndices, nInnerChunkIdx);
+
+    // Inner chunks that have been written but not their shard yet. Only
+    // the main thread may access them, and IAdviseRead() flushes them
+    // before starting its jobs.
+    if (!bUseMutex)
+    {
+        const auto oIterShard = m_oMapPendingShards.find(anShardIndices);
+        if (oIterShard != m_oMapPendingShards.end())
+        {
+            const auto &oMapInnerChunks = oIterShard->second.oMapInnerChunks;
+            const auto oIter = oMapInnerChunks.find(nInnerChunkIdx);
+            if (oIter != oMapInnerChunks.end())
+            {
+                if (oIter->second.empty())
+                {
+                    bMissingTileOut = true;
+                    return true;
+                }
+                CPLAssert(oIter->second.size() == m_nTileSize);
+                // should not fail
+                abyRawTileData.resize(m_nTileSize);
+                memcpy(abyRawTileData.data(), oIter->second.data(),
+                       m_nTileSize);
+                return true;
+            }
+        }
+    }
+
+    const std::string osFilename = BuildChunkFilename(anShardIndices.data());
+    const auto poShardingCodec = poCodecs->GetShardingCodec();
+    CPLAssert(poShardingCodec);
+
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    VSILFILE *fp = nullptr;
+    std::shared_ptr<const std::vector<uint64_t>> panIndex;
+    if (!m_oCacheShardIndex.tryGet(osFilename, panIndex))
+    {
+        auto panNewIndex = std::make_shared<std::vector<uint64_t>>();
+        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+        if (fp)
+        {
+            const size_t nIndexSize = poShardingCodec->GetIndexSize();
+            VSIFSeekL(fp, 0, SEEK_END);
+            const auto nFileSize = VSIFTellL(fp);
+            ZarrByteVectorQuickResize abyIndex;
+            bool bOK = nFileSize >= nIndexSize;
+            if (bOK)
+            {
+                try
+                {
+                    abyIndex.resize(nIndexSize);
+                }
+                catch (const std::exception &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate memory for index of shard %s",
+                             osFilename.c_str());
+                    VSIFCloseL(fp);
+                    return false;
+                }
+                bOK = VSIFSeekL(fp,
+                                poShardingCodec->IsIndexLocationAtEnd()
+                                    ? nFileSize - nIndexSize
+                                    : 0,
+                                SEEK_SET) == 0 &&
+                      VSIFReadL(abyIndex.data(), 1, nIndexSize, fp) ==
+                          nIndexSize;
+            }
+            if (!bOK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Could not read index of shard %s",
+                         osFilename.c_str());
+                VSIFCloseL(fp);
+                return false;
+            }
+            if (!poShardingCodec->DecodeIndex(abyIndex, *panNewIndex))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Decoding of index of shard %s failed",
+                         osFilename.c_str());
+                VSIFCloseL(fp);
+                return false;
+            }
+        }
+        panIndex = panNewIndex;
+        m_oCacheShardIndex.insert(osFilename, panIndex);
+    }
+
+    const uint64_t nOffset =
+        panIndex->empty() ? 0 : (*panIndex)[2 * nInnerChunkIdx];
+    const uint64_t nSize =
+        panIndex->empty() ? 0 : (*panIndex)[2 * nInnerChunkIdx + 1];
+    if (panIndex->empty() ||
+        (nOffset == ZarrV3CodecShardingIndexed::MISSING_CHUNK &&
+         nSize == ZarrV3CodecShardingIndexed::MISSING_CHUNK))
+    {
+        // Missing shards or inner chunks are OK and indicate nodata_value
+        CPLDebugOnly(ZARR_DEBUG_KEY,
+                     "Inner chunk %u of shard %s missing (=nodata)",
+                     static_cast<unsigned>(nInnerChunkIdx),
+                     osFilename.c_str());
+        if (fp)
+            VSIFCloseL(fp);
+        bMissingTileOut = true;
+        return true;
+    }
+
+    if (nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Too large inner chunk %u in shard %s",
+                 static_cast<unsigned>(nInnerChunkIdx), osFilename.c_str());
+        if (fp)
+            VSIFCloseL(fp);
+        return false;
+    }
+
+    if (!fp)
+        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+    if (!fp)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot open shard %s",
+                 osFilename.c_str());
+        return false;
+    }
+
+    bool bRet = true;
+    try
+    {
+        abyRawTileData.resize(static_cast<size_t>(nSize));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for inner chunk %u of shard %s",
+                 static_cast<unsigned>(nInnerChunkIdx), osFilename.c_str());
+        bRet = false;
+    }
+    if (bRet && (abyRawTileData.empty() ||
+                 VSIFSeekL(fp, static_cast<vsi_l_offset>(nOffset), SEEK_SET) !=
+                     0 ||
+                 VSIFReadL(&abyRawTileData[0], 1, abyRawTileData.size(), fp) !=
+                     abyRawTileData.size()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read inner chunk %u of shard %s correctly",
+                 static_cast<unsigned>(nInnerChunkIdx), osFilename.c_str());
+        bRet = false;
+    }
+    VSIFCloseL(fp);
+    if (!bRet)
+        return false;
+
+    if (!poShardingCodec->GetInnerCodecs()->Decode(abyRawTileData))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompression of inner chunk %u of shard %s failed",
+                 static_cast<unsigned>(nInnerChunkIdx), osFilename.c_str());
+        return false;
+    }
+
+    if (abyRawTileData.size() != m_nTileSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompressed inner chunk %u of shard %s has not expected "
+                 "size. Got %u instead of %u",
+                 static_cast<unsigned>(nInnerChunkIdx), osFilename.c_str(),
+                 static_cast<unsigned>(abyRawTileData.size()),
+                 static_cast<unsigned>(m_nTileSize));
+        return false;
+    }
 
     return true;
 
@@ -564,6 +849,10 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                               CSLConstList papszOptions) const
 {
+    // Jobs cannot access inner chunks not yet written in their shard
+    if (!FlushPendingShards())
+        return false;
+
     std::vector<uint64_t> anIndicesCur;
     int nThreadsMax = 0;
     std::vector<uint64_t> anReqTilesIndices;
@@ -746,6 +1035,10 @@ bool ZarrV3Array::FlushDirtyTile() const
     {
         m_bCachedTiledEmpty = true;
 
+        if (IsSharded())
+            return AddPendingInnerChunk(true);
+
+        WaitTileWrite(osFilename);
         VSIStatBufL sStat;
         if (VSIStatL(osFilename.c_str(), &sStat) == 0)
         {
@@ -770,19 +1063,368 @@ bool ZarrV3Array::FlushDirtyTile() const
         }
     }
 
+    if (IsSharded())
+        return AddPendingInnerChunk(false);
+
+    if (GetTileWriteJobQueue(m_abyRawTileData.size()))
+    {
+        // Codecs have working buffers, so each job needs its own ones
+        std::shared_ptr<ZarrV3CodecSequence> poCodecs(
+            m_poCodecs ? m_poCodecs->Clone() : nullptr);
+        return SubmitTileWrite(
+            osFilename,
+            [this, poCodecs](const std::string &osFilenameIn,
+                             ZarrByteVectorQuickResize &abyRawTileData)
+            {
+                return EncodeAndWriteTile(osFilenameIn, abyRawTileData,
+                                          poCodecs.get());
+            });
+    }
+
     const size_t nSizeBefore = m_abyRawTileData.size();
-    if (m_poCodecs)
+    const bool bRet =
+        EncodeAndWriteTile(osFilename, m_abyRawTileData, m_poCodecs.get());
+    m_abyRawTileData.resize(nSizeBefore);
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::AddPendingInnerChunk()                 */
+/************************************************************************/
+
+// Keeps the raw content of the dirty inner chunk (or nothing if bEmpty) until
+// its shard is written, which happens once all its inner chunks have been
+// written, when the memory used by pending shards exceeds
+// GDAL_ZARR_WRITE_CACHE_SIZE, or at Flush() time.
+
+bool ZarrV3Array::AddPendingInnerChunk(bool bEmpty) const
+{
+    size_t nInnerChunkIdx = 0;
+    const auto anShardIndices =
+        GetShardIndices(m_anCachedTiledIndices.data(), nInnerChunkIdx);
+
+    auto &oShard = m_oMapPendingShards[anShardIndices];
+    if (oShard.oMapInnerChunks.empty())
+        oShard.nCounter = ++m_nPendingShardsCounter;
+    auto &abyInnerChunk = oShard.oMapInnerChunks[nInnerChunkIdx];
+    m_nPendingShardsSize -= abyInnerChunk.size();
+    if (bEmpty)
+    {
+        std::vector<GByte>().swap(abyInnerChunk);
+    }
+    else
     {
-        if (!m_poCodecs->Encode(m_abyRawTileData))
+        CPLAssert(m_abyRawTileData.size() == m_nTileSize);
+        try
+        {
+            abyInnerChunk.assign(m_abyRawTileData.data(),
+                                 m_abyRawTileData.data() + m_nTileSize);
+        }
+        catch (const std::bad_alloc &e)
         {
-            m_abyRawTileData.resize(nSizeBefore);
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
             return false;
         }
     }
+    m_nPendingShardsSize += abyInnerChunk.size();
+
+    if (oShard.oMapInnerChunks.size() ==
+        GetInnerChunkCountInShard(m_anCachedTiledIndices.data()))
+    {
+        return FlushPendingShard(anShardIndices);
+    }
+
+    const GIntBig nMaxSize = std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption(
+               "GDAL_ZARR_WRITE_CACHE_SIZE",
+               CPLSPrintf(CPL_FRMT_GIB, GDALGetCacheMax64() / 4))));
+    bool bRet = true;
+    while (bRet && static_cast<GIntBig>(m_nPendingShardsSize) > nMaxSize &&
+           !m_oMapPendingShards.empty())
+    {
+        auto oIterOldest = m_oMapPendingShards.begin();
+        for (auto oIter = m_oMapPendingShards.begin();
+             oIter != m_oMapPendingShards.end(); ++oIter)
+        {
+            if (oIter->second.nCounter < oIterOldest->second.nCounter)
+                oIterOldest = oIter;
+        }
+        bRet = FlushPendingShard(oIterOldest->first);
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                   ZarrV3Array::FlushPendingShard()                   */
+/************************************************************************/
+
+bool ZarrV3Array::FlushPendingShard(
+    const std::vector<uint64_t> &anShardIndices) const
+{
+    const auto oIter = m_oMapPendingShards.find(anShardIndices);
+    if (oIter == m_oMapPendingShards.end())
+        return true;
+    auto poMapInnerChunks =
+        std::make_shared<std::map<size_t, std::vector<GByte>>>(
+            std::move(oIter->second.oMapInnerChunks));
+    m_oMapPendingShards.erase(oIter);
+    for (const auto &oIterChunk : *poMapInnerChunks)
+        m_nPendingShardsSize -= oIterChunk.second.size();
+
+    const std::string osFilename = BuildChunkFilename(anShardIndices.data());
+    m_oCacheShardIndex.remove(osFilename);
+
+    const size_t nShardSize =
+        m_nTileSize * m_poCodecs->GetShardingCodec()->GetInnerChunkCount();
+    if (GetTileWriteJobQueue(nShardSize))
+    {
+        // Codecs have working buffers, so each job needs its own ones
+        std::shared_ptr<ZarrV3CodecSequence> poCodecs(m_poCodecs->Clone());
+        return SubmitWrite(osFilename,
+                           [this, poCodecs, poMapInnerChunks](
+                               const std::string &osFilenameIn) {
+                               return WriteShard(osFilenameIn,
+                                                 *poMapInnerChunks,
+                                                 poCodecs.get());
+                           });
+    }
+
+    return WriteShard(osFilename, *poMapInnerChunks, m_poCodecs.get());
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::FlushPendingShards()                   */
+/************************************************************************/
+
+bool ZarrV3Array::FlushPendingShards() const
+{
+    bool bRet = true;
+    while (!m_oMapPendingShards.empty())
+    {
+        const auto anShardIndices = m_oMapPendingShards.begin()->first;
+        if (!FlushPendingShard(anShardIndices))
+            bRet = false;
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                       ZarrV3Array::WriteShard()                      */
+/************************************************************************/
+
+// Writes a shard made of the inner chunks of oMapInnerChunks, and of the
+// inner chunks of the existing shard that are not in it. Deletes the shard
+// if all its inner chunks are empty.
+
+bool ZarrV3Array::WriteShard(
+    const std::string &osFilename,
+    const std::map<size_t, std::vector<GByte>> &oMapInnerChunks,
+    ZarrV3CodecSequence *poCodecs) const
+{
+    // This method should NOT modify any ZarrArray member, as it may be
+    // called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+#define m_poCodecs cannot_use_here
+
+    const auto poShardingCodec = poCodecs->GetShardingCodec();
+    CPLAssert(poShardingCodec);
+    const size_t nInnerChunkCount = poShardingCodec->GetInnerChunkCount();
+    const size_t nIndexSize = poShardingCodec->GetIndexSize();
+    const bool bIndexLocationAtEnd = poShardingCodec->IsIndexLocationAtEnd();
+
+    // Fetch the existing shard, if some of its inner chunks are kept
+    ZarrByteVectorQuickResize abyOldShard;
+    std::vector<uint64_t> anOldIndex;
+    if (oMapInnerChunks.size() < nInnerChunkCount)
+    {
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+        if (fp)
+        {
+            VSIFSeekL(fp, 0, SEEK_END);
+            const auto nFileSize = VSIFTellL(fp);
+            VSIFSeekL(fp, 0, SEEK_SET);
+            bool bOK = nFileSize >= nIndexSize &&
+                       nFileSize <= std::numeric_limits<size_t>::max();
+            if (bOK)
+            {
+                try
+                {
+                    abyOldShard.resize(static_cast<size_t>(nFileSize));
+                }
+                catch (const std::exception &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate memory for shard %s",
+                             osFilename.c_str());
+                    VSIFCloseL(fp);
+                    return false;
+                }
+                bOK = VSIFReadL(abyOldShard.data(), 1, abyOldShard.size(),
+                                fp) == abyOldShard.size();
+            }
+            VSIFCloseL(fp);
+
+            ZarrByteVectorQuickResize abyIndex;
+            if (bOK)
+            {
+                abyIndex.resize(nIndexSize);
+                memcpy(abyIndex.data(),
+                       abyOldShard.data() + (bIndexLocationAtEnd
+                                                 ? abyOldShard.size() -
+                                                       nIndexSize
+                                                 : 0),
+                       nIndexSize);
+            }
+            if (!bOK || !poShardingCodec->DecodeIndex(abyIndex, anOldIndex))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Could not read existing shard %s correctly",
+                         osFilename.c_str());
+                return false;
+            }
+        }
+    }
+
+    std::vector<uint64_t> anIndex;
+    ZarrByteVectorQuickResize abyShard;
+    ZarrByteVectorQuickResize abyInnerChunk;
+    bool bHasInnerChunk = false;
+    try
+    {
+        anIndex.resize(2 * nInnerChunkCount,
+                       ZarrV3CodecShardingIndexed::MISSING_CHUNK);
+        abyShard.resize(bIndexLocationAtEnd ? 0 : nIndexSize);
+        for (size_t i = 0; i < nInnerChunkCount; ++i)
+        {
+            const GByte *pabyData = nullptr;
+            size_t nSize = 0;
+            const auto oIter = oMapInnerChunks.find(i);
+            if (oIter != oMapInnerChunks.end())
+            {
+                if (oIter->second.empty())
+                    continue;
+                abyInnerChunk.resize(oIter->second.size());
+                memcpy(abyInnerChunk.data(), oIter->second.data(),
+                       oIter->second.size());
+                if (!poShardingCodec->GetInnerCodecs()->Encode(abyInnerChunk))
+                    return false;
+                pabyData = abyInnerChunk.data();
+                nSize = abyInnerChunk.size();
+            }
+            else if (!anOldIndex.empty() &&
+                     !(anOldIndex[2 * i] ==
+                           ZarrV3CodecShardingIndexed::MISSING_CHUNK &&
+                       anOldIndex[2 * i + 1] ==
+                           ZarrV3CodecShardingIndexed::MISSING_CHUNK))
+            {
+                const uint64_t nOldOffset = anOldIndex[2 * i];
+                const uint64_t nOldSize = anOldIndex[2 * i + 1];
+                if (nOldOffset > abyOldShard.size() ||
+                    nOldSize > abyOldShard.size() - nOldOffset)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Inner chunk %u of shard %s is out of shard",
+                             static_cast<unsigned>(i), osFilename.c_str());
+                    return false;
+                }
+                pabyData = abyOldShard.data() + static_cast<size_t>(nOldOffset);
+                nSize = static_cast<size_t>(nOldSize);
+            }
+            else
+            {
+                continue;
+            }
+
+            bHasInnerChunk = true;
+            const size_t nOffset = abyShard.size();
+            anIndex[2 * i] = nOffset;
+            anIndex[2 * i + 1] = nSize;
+            abyShard.resize(nOffset + nSize);
+            if (nSize)
+                memcpy(abyShard.data() + nOffset, pabyData, nSize);
+        }
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+
+    if (!bHasInnerChunk)
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        {
+            CPLDebugOnly(ZARR_DEBUG_KEY,
+                         "Deleting shard %s that has now empty content",
+                         osFilename.c_str());
+            return VSIUnlink(osFilename.c_str()) == 0;
+        }
+        return true;
+    }
+
+    ZarrByteVectorQuickResize abyIndex;
+    if (!poShardingCodec->EncodeIndex(anIndex, abyIndex))
+        return false;
+    try
+    {
+        if (bIndexLocationAtEnd)
+        {
+            const size_t nOffset = abyShard.size();
+            abyShard.resize(nOffset + abyIndex.size());
+            memcpy(abyShard.data() + nOffset, abyIndex.data(),
+                   abyIndex.size());
+        }
+        else
+        {
+            memcpy(abyShard.data(), abyIndex.data(), abyIndex.size());
+        }
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+
+    // The shard is already encoded
+    return EncodeAndWriteTile(osFilename, abyShard, nullptr);
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::EncodeAndWriteTile()                   */
+/************************************************************************/
+
+bool ZarrV3Array::EncodeAndWriteTile(const std::string &osFilename,
+                                     ZarrByteVectorQuickResize &abyRawTileData,
+                                     ZarrV3CodecSequence *poCodecs) const
+{
+    // This method should NOT modify any ZarrArray member, as it may be
+    // called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+#define m_poCodecs cannot_use_here
+
+    if (poCodecs)
+    {
+        if (!poCodecs->Encode(abyRawTileData))
+            return false;
+    }
 
     if (m_osDimSeparator == "/")
     {
         std::string osDir = CPLGetDirname(osFilename.c_str());
+        // Serialize against concurrent creation of the same directory
+        std::lock_guard<std::mutex> oLock(m_oMutex);
         VSIStatBufL sStat;
         if (VSIStatL(osDir.c_str(), &sStat) != 0)
         {
@@ -790,7 +1432,6 @@ bool ZarrV3Array::FlushDirtyTile() const
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
-                m_abyRawTileData.resize(nSizeBefore);
                 return false;
             }
         }
@@ -801,14 +1442,12 @@ bool ZarrV3Array::FlushDirtyTile() const
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Cannot create tile %s",
                  osFilename.c_str());
-        m_abyRawTileData.resize(nSizeBefore);
         return false;
     }
 
     bool bRet = true;
-    const size_t nRawDataSize = m_abyRawTileData.size();
-    if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
-        nRawDataSize)
+    const size_t nRawDataSize = abyRawTileData.size();
+    if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) != nRawDataSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Could not write tile %s correctly", osFilename.c_str());
@@ -816,9 +1455,11 @@ bool ZarrV3Array::FlushDirtyTile() const
     }
     VSIFCloseL(fp);
 
-    m_abyRawTileData.resize(nSizeBefore);
-
     return bRet;
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
 }
 
 /************************************************************************/
@@ -826,6 +1467,22 @@ bool ZarrV3Array::FlushDirtyTile() const
 /************************************************************************/
 
 std::string ZarrV3Array::BuildTileFilename(const uint64_t *tileIndices) const
+{
+    if (IsSharded())
+    {
+        // Filename of the shard that contains the inner chunk
+        size_t nInnerChunkIdx = 0;
+        return BuildChunkFilename(
+            GetShardIndices(tileIndices, nInnerChunkIdx).data());
+    }
+    return BuildChunkFilename(tileIndices);
+}
+
+/************************************************************************/
+/*                          BuildChunkFilename()                        */
+/************************************************************************/
+
+std::string ZarrV3Array::BuildChunkFilename(const uint64_t *chunkIndices) const
 {
     if (m_aoDims.empty())
     {
@@ -844,12 +1501,61 @@ std::string ZarrV3Array::BuildTileFilename(const uint64_t *tileIndices) const
         {
             if (i > 0 || !m_bV2ChunkKeyEncoding)
                 osFilename += m_osDimSeparator;
-            osFilename += std::to_string(tileIndices[i]);
+            osFilename += std::to_string(chunkIndices[i]);
         }
         return osFilename;
     }
 }
 
+/************************************************************************/
+/*                           GetShardIndices()                          */
+/************************************************************************/
+
+// Returns the indices of the shard that contains the inner chunk of indices
+// tileIndices, and the position of the inner chunk in the shard, in C order.
+
+std::vector<uint64_t>
+ZarrV3Array::GetShardIndices(const uint64_t *tileIndices,
+                             size_t &nInnerChunkIdx) const
+{
+    std::vector<uint64_t> anShardIndices(m_aoDims.size());
+    nInnerChunkIdx = 0;
+    for (size_t i = 0; i < m_aoDims.size(); ++i)
+    {
+        const uint64_t nInnerChunksPerShard =
+            m_anShardBlockSize[i] / m_anBlockSize[i];
+        anShardIndices[i] = tileIndices[i] / nInnerChunksPerShard;
+        nInnerChunkIdx =
+            nInnerChunkIdx * static_cast<size_t>(nInnerChunksPerShard) +
+            static_cast<size_t>(tileIndices[i] % nInnerChunksPerShard);
+    }
+    return anShardIndices;
+}
+
+/************************************************************************/
+/*                      GetInnerChunkCountInShard()                     */
+/************************************************************************/
+
+// Returns the number of inner chunks of the shard that contains the inner
+// chunk of indices tileIndices, not counting the ones beyond the array edges.
+
+size_t ZarrV3Array::GetInnerChunkCountInShard(const uint64_t *tileIndices) const
+{
+    size_t nCount = 1;
+    for (size_t i = 0; i < m_aoDims.size(); ++i)
+    {
+        const uint64_t nInnerChunksPerShard =
+            m_anShardBlockSize[i] / m_anBlockSize[i];
+        const uint64_t nFirstInnerChunk =
+            tileIndices[i] / nInnerChunksPerShard * nInnerChunksPerShard;
+        const uint64_t nInnerChunks =
+            DIV_ROUND_UP(m_aoDims[i]->GetSize(), m_anBlockSize[i]);
+        nCount *= static_cast<size_t>(std::min(
+            nInnerChunksPerShard, nInnerChunks - nFirstInnerChunk));
+    }
+    return nCount;
+}
+
 /************************************************************************/
 /*                          GetDataDirectory()                          */
 /************************************************************************/
@@ -866,6 +1572,9 @@ std::string ZarrV3Array::GetDataDirectory() const
 CPLStringList
 ZarrV3Array::GetTileIndicesFromFilename(const char *pszFilename) const
 {
+    // Files are shards, not inner chunks
+    if (IsSharded())
+        return CPLStringList();
     if (!m_bV2ChunkKeyEncoding)
     {
         if (pszFilename[0] != 'c')
@@ -1586,6 +2295,7 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
 
     const auto oCodecs = oRoot["codecs"].ToArray();
     std::unique_ptr<ZarrV3CodecSequence> poCodecs;
+    std::vector<GUInt64> anShardBlockSize;
     if (oCodecs.Size() > 0)
     {
         // Byte swapping will be done by the codec chain
@@ -1599,6 +2309,16 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
         poCodecs = cpl::make_unique<ZarrV3CodecSequence>(oInputArrayMetadata);
         if (!poCodecs->InitFromJson(oCodecs))
             return nullptr;
+
+        // If sharding is the only codec, expose inner chunks as blocks, so
+        // that they can be read individually
+        if (const auto poShardingCodec = poCodecs->GetShardingCodec())
+        {
+            anShardBlockSize = anBlockSize;
+            const auto &anInnerBlockSize = poShardingCodec->GetInnerBlockSize();
+            anBlockSize.assign(anInnerBlockSize.begin(),
+                               anInnerBlockSize.end());
+        }
     }
 
     auto poArray =
@@ -1619,6 +2339,8 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     poArray->SetDtype(oDtype);
     if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
+    if (!anShardBlockSize.empty())
+        poArray->SetShardBlockSize(anShardBlockSize);
     RegisterArray(poArray);
 
     // If this is an indexing variable, attach it to the dimension.
@@ -1634,7 +2356,16 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     if (CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
             "CACHE_TILE_PRESENCE", "NO")))
     {
-        poArray->CacheTilePresence();
+        if (!anShardBlockSize.empty())
+        {
+            CPLDebug(ZARR_DEBUG_KEY,
+                     "CACHE_TILE_PRESENCE ignored on sharded array %s",
+                     osArrayName.c_str());
+        }
+        else
+        {
+            poArray->CacheTilePresence();
+        }
     }
 
     return poArray;
@@ -30,6 +30,8 @@
 
 #include "cpl_compressor.h"
 
+#include <array>
+
 /************************************************************************/
 /*                          ZarrV3Codec()                               */
 /************************************************************************/
@@ -916,6 +918,157 @@ bool ZarrV3CodecTranspose::Decode(const ZarrByteVectorQuickResize &abySrc,
     return Transpose(abySrc, abyDst, false);
 }
 
+/************************************************************************/
+/*                        ZarrV3CodecCRC32C()                           */
+/************************************************************************/
+
+ZarrV3CodecCRC32C::ZarrV3CodecCRC32C() : ZarrV3Codec(NAME)
+{
+}
+
+/************************************************************************/
+/*                       ~ZarrV3CodecCRC32C()                           */
+/************************************************************************/
+
+ZarrV3CodecCRC32C::~ZarrV3CodecCRC32C() = default;
+
+/************************************************************************/
+/*                               CRC32C()                               */
+/************************************************************************/
+
+// CRC-32 with the Castagnoli polynomial (0x1EDC6F41), as used by iSCSI.
+static uint32_t CRC32C(const GByte *pabyData, size_t nSize)
+{
+    static const std::array<uint32_t, 256> anTable = []()
+    {
+        std::array<uint32_t, 256> anRet{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nCRC = i;
+            for (int j = 0; j < 8; ++j)
+                nCRC = (nCRC >> 1) ^ ((nCRC & 1) ? 0x82F63B78U : 0);
+            anRet[i] = nCRC;
+        }
+        return anRet;
+    }();
+
+    uint32_t nCRC = 0xFFFFFFFFU;
+    for (size_t i = 0; i < nSize; ++i)
+        nCRC = anTable[(nCRC ^ pabyData[i]) & 0xFF] ^ (nCRC >> 8);
+    return nCRC ^ 0xFFFFFFFFU;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecCRC32C::InitFromConfiguration()           */
+/************************************************************************/
+
+bool ZarrV3CodecCRC32C::InitFromConfiguration(
+    const CPLJSONObject &configuration,
+    const ZarrArrayMetadata &oInputArrayMetadata,
+    ZarrArrayMetadata &oOutputArrayMetadata)
+{
+    m_oConfiguration = configuration.Clone();
+    m_oInputArrayMetadata = oInputArrayMetadata;
+    // byte->byte codec
+    oOutputArrayMetadata = oInputArrayMetadata;
+
+    if (configuration.IsValid())
+    {
+        if (configuration.GetType() != CPLJSONObject::Type::Object)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec crc32c: configuration is not an object");
+            return false;
+        }
+
+        for (const auto &oChild : configuration.GetChildren())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec crc32c: configuration contains a unhandled "
+                     "member: %s",
+                     oChild.GetName().c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                     ZarrV3CodecCRC32C::Clone()                       */
+/************************************************************************/
+
+std::unique_ptr<ZarrV3Codec> ZarrV3CodecCRC32C::Clone() const
+{
+    auto psClone = cpl::make_unique<ZarrV3CodecCRC32C>();
+    ZarrArrayMetadata oOutputArrayMetadata;
+    psClone->InitFromConfiguration(m_oConfiguration, m_oInputArrayMetadata,
+                                   oOutputArrayMetadata);
+    return psClone;
+}
+
+/************************************************************************/
+/*                      ZarrV3CodecCRC32C::Encode()                     */
+/************************************************************************/
+
+bool ZarrV3CodecCRC32C::Encode(const ZarrByteVectorQuickResize &abySrc,
+                               ZarrByteVectorQuickResize &abyDst) const
+{
+    const size_t nSize = abySrc.size();
+    try
+    {
+        abyDst.resize(nSize + sizeof(uint32_t));
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    if (nSize)
+        memcpy(abyDst.data(), abySrc.data(), nSize);
+    uint32_t nCRC = CRC32C(abySrc.data(), nSize);
+    CPL_LSBPTR32(&nCRC);
+    memcpy(abyDst.data() + nSize, &nCRC, sizeof(nCRC));
+    return true;
+}
+
+/************************************************************************/
+/*                      ZarrV3CodecCRC32C::Decode()                     */
+/************************************************************************/
+
+bool ZarrV3CodecCRC32C::Decode(const ZarrByteVectorQuickResize &abySrc,
+                               ZarrByteVectorQuickResize &abyDst) const
+{
+    if (abySrc.size() < sizeof(uint32_t))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ZarrV3CodecCRC32C::Decode(): input buffer too small");
+        return false;
+    }
+    const size_t nSize = abySrc.size() - sizeof(uint32_t);
+    uint32_t nExpectedCRC;
+    memcpy(&nExpectedCRC, abySrc.data() + nSize, sizeof(nExpectedCRC));
+    CPL_LSBPTR32(&nExpectedCRC);
+    if (CRC32C(abySrc.data(), nSize) != nExpectedCRC)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ZarrV3CodecCRC32C::Decode(): checksum mismatch");
+        return false;
+    }
+    try
+    {
+        abyDst.resize(nSize);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    if (nSize)
+        memcpy(abyDst.data(), abySrc.data(), nSize);
+    return true;
+}
+
 /************************************************************************/
 /*                    ZarrV3CodecSequence::Clone()                      */
 /************************************************************************/
@@ -980,10 +1133,16 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
             poCodec = cpl::make_unique<ZarrV3CodecGZip>();
         else if (osName == "blosc")
             poCodec = cpl::make_unique<ZarrV3CodecBlosc>();
-        else if (osName == "endian")
+        // "bytes" is the name of the "endian" codec in the final
+        // specification
+        else if (osName == "endian" || osName == "bytes")
             poCodec = cpl::make_unique<ZarrV3CodecEndian>();
         else if (osName == "transpose")
             poCodec = cpl::make_unique<ZarrV3CodecTranspose>();
+        else if (osName == "crc32c")
+            poCodec = cpl::make_unique<ZarrV3CodecCRC32C>();
+        else if (osName == "sharding_indexed")
+            poCodec = cpl::make_unique<ZarrV3CodecShardingIndexed>();
         else
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unsupported codec: %s",
@@ -1031,6 +1190,23 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
     return true;
 }
 
+/************************************************************************/
+/*                  ZarrV3CodecSequence::SetFillValue()                 */
+/************************************************************************/
+
+// Sets the fill value of the array, in the native representation of its
+// elements, used by codecs that must materialize missing data.
+
+bool ZarrV3CodecSequence::SetFillValue(const std::vector<GByte> &abyFillValue)
+{
+    if (m_oInputArrayMetadata.abyFillValue == abyFillValue)
+        return true;
+    m_oInputArrayMetadata.abyFillValue = abyFillValue;
+    const CPLJSONObject oCodecs = m_oCodecArray.Clone();
+    m_apoCodecs.clear();
+    return InitFromJson(oCodecs);
+}
+
 /************************************************************************/
 /*                  ZarrV3CodecEndian::AllocateBuffer()                 */
 /************************************************************************/
@@ -1107,3 +1283,491 @@ bool ZarrV3CodecSequence::Decode(ZarrByteVectorQuickResize &abyBuffer)
     }
     return true;
 }
+
+/************************************************************************/
+/*                ZarrV3CodecSequence::GetShardingCodec()               */
+/************************************************************************/
+
+// Returns the sharding codec if it is the only codec of the sequence, in
+// which case inner chunks can be accessed individually.
+
+ZarrV3CodecShardingIndexed *ZarrV3CodecSequence::GetShardingCodec() const
+{
+    if (m_apoCodecs.size() != 1)
+        return nullptr;
+    return dynamic_cast<ZarrV3CodecShardingIndexed *>(m_apoCodecs[0].get());
+}
+
+/************************************************************************/
+/*                    ZarrV3CodecShardingIndexed()                      */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::ZarrV3CodecShardingIndexed() : ZarrV3Codec(NAME)
+{
+}
+
+/************************************************************************/
+/*                   ~ZarrV3CodecShardingIndexed()                      */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::~ZarrV3CodecShardingIndexed() = default;
+
+/************************************************************************/
+/*                           GetConfiguration()                         */
+/************************************************************************/
+
+/* static */ CPLJSONObject ZarrV3CodecShardingIndexed::GetConfiguration(
+    const std::vector<GUInt64> &anInnerBlockSize, const CPLJSONArray &oCodecs)
+{
+    CPLJSONObject oConfig;
+    CPLJSONArray oChunkShape;
+    for (const auto nVal : anInnerBlockSize)
+        oChunkShape.Add(static_cast<GInt64>(nVal));
+    oConfig.Add("chunk_shape", oChunkShape);
+    oConfig.Add("codecs", oCodecs);
+
+    CPLJSONArray oIndexCodecs;
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", "bytes");
+        oCodec.Add("configuration", ZarrV3CodecEndian::GetConfiguration(true));
+        oIndexCodecs.Add(oCodec);
+    }
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", ZarrV3CodecCRC32C::NAME);
+        oIndexCodecs.Add(oCodec);
+    }
+    oConfig.Add("index_codecs", oIndexCodecs);
+    oConfig.Add("index_location", "end");
+    return oConfig;
+}
+
+/************************************************************************/
+/*            ZarrV3CodecShardingIndexed::InitFromConfiguration()       */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::InitFromConfiguration(
+    const CPLJSONObject &configuration,
+    const ZarrArrayMetadata &oInputArrayMetadata,
+    ZarrArrayMetadata &oOutputArrayMetadata)
+{
+    m_oConfiguration = configuration.Clone();
+    m_oInputArrayMetadata = oInputArrayMetadata;
+    // array->bytes codec
+    oOutputArrayMetadata = oInputArrayMetadata;
+
+    if (!configuration.IsValid() ||
+        configuration.GetType() != CPLJSONObject::Type::Object)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: configuration missing or not an "
+                 "object");
+        return false;
+    }
+
+    for (const auto &oChild : configuration.GetChildren())
+    {
+        const auto osName = oChild.GetName();
+        if (osName != "chunk_shape" && osName != "codecs" &&
+            osName != "index_codecs" && osName != "index_location")
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: configuration contains a "
+                     "unhandled member: %s",
+                     osName.c_str());
+            return false;
+        }
+    }
+
+    const size_t nDims = oInputArrayMetadata.anBlockSizes.size();
+    const auto oChunkShape = configuration.GetArray("chunk_shape");
+    if (!oChunkShape.IsValid() ||
+        static_cast<size_t>(oChunkShape.Size()) != nDims)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: chunk_shape missing or not an array "
+                 "with one value per dimension");
+        return false;
+    }
+    m_anInnerBlockSize.clear();
+    m_anInnerBlockCount.clear();
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const GInt64 nVal = oChunkShape[static_cast<int>(i)].ToLong();
+        const size_t nShardSize = oInputArrayMetadata.anBlockSizes[i];
+        if (nVal <= 0 || static_cast<uint64_t>(nVal) > nShardSize ||
+            (nShardSize % static_cast<size_t>(nVal)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: chunk_shape[%d] is not a "
+                     "divisor of the shard shape",
+                     static_cast<int>(i));
+            return false;
+        }
+        m_anInnerBlockSize.push_back(static_cast<size_t>(nVal));
+        m_anInnerBlockCount.push_back(nShardSize / static_cast<size_t>(nVal));
+    }
+
+    const auto oIndexLocation = configuration.GetObj("index_location");
+    if (oIndexLocation.IsValid())
+    {
+        const auto osIndexLocation = oIndexLocation.ToString();
+        if (osIndexLocation == "end")
+            m_bIndexLocationAtEnd = true;
+        else if (osIndexLocation == "start")
+            m_bIndexLocationAtEnd = false;
+        else
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: invalid value for "
+                     "index_location");
+            return false;
+        }
+    }
+
+    ZarrArrayMetadata oInnerArrayMetadata;
+    oInnerArrayMetadata.oElt = oInputArrayMetadata.oElt;
+    oInnerArrayMetadata.anBlockSizes = m_anInnerBlockSize;
+    oInnerArrayMetadata.abyFillValue = oInputArrayMetadata.abyFillValue;
+    m_poCodecs = cpl::make_unique<ZarrV3CodecSequence>(oInnerArrayMetadata);
+    if (!m_poCodecs->InitFromJson(configuration["codecs"]))
+        return false;
+
+    // The index is an array of shape [inner chunk counts..., 2] of uint64
+    ZarrArrayMetadata oIndexArrayMetadata;
+    oIndexArrayMetadata.oElt.nativeType = DtypeElt::NativeType::UNSIGNED_INT;
+    oIndexArrayMetadata.oElt.nativeSize = sizeof(uint64_t);
+    oIndexArrayMetadata.oElt.gdalType =
+        GDALExtendedDataType::Create(GDT_UInt64);
+    oIndexArrayMetadata.oElt.gdalSize = sizeof(uint64_t);
+    oIndexArrayMetadata.anBlockSizes = m_anInnerBlockCount;
+    oIndexArrayMetadata.anBlockSizes.push_back(2);
+    m_nIndexSize = GetInnerChunkCount() * 2 * sizeof(uint64_t);
+
+    // Only fixed size index codecs can be supported, as the index must be
+    // located without knowing its size
+    auto oIndexCodecs = configuration["index_codecs"];
+    if (!oIndexCodecs.IsValid())
+        oIndexCodecs = CPLJSONArray();
+    if (oIndexCodecs.GetType() == CPLJSONObject::Type::Array)
+    {
+        for (const auto &oCodec : oIndexCodecs.ToArray())
+        {
+            const auto osName = oCodec["name"].ToString();
+            if (osName == ZarrV3CodecCRC32C::NAME)
+            {
+                m_nIndexSize += sizeof(uint32_t);
+            }
+            else if (osName != "bytes" && osName != ZarrV3CodecEndian::NAME)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Codec sharding_indexed: unsupported index codec %s",
+                         osName.c_str());
+                return false;
+            }
+        }
+    }
+    m_poIndexCodecs =
+        cpl::make_unique<ZarrV3CodecSequence>(oIndexArrayMetadata);
+    if (!m_poIndexCodecs->InitFromJson(oIndexCodecs))
+        return false;
+
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Clone()                  */
+/************************************************************************/
+
+std::unique_ptr<ZarrV3Codec> ZarrV3CodecShardingIndexed::Clone() const
+{
+    auto psClone = cpl::make_unique<ZarrV3CodecShardingIndexed>();
+    ZarrArrayMetadata oOutputArrayMetadata;
+    psClone->InitFromConfiguration(m_oConfiguration, m_oInputArrayMetadata,
+                                   oOutputArrayMetadata);
+    return psClone;
+}
+
+/************************************************************************/
+/*           ZarrV3CodecShardingIndexed::GetInnerChunkCount()           */
+/************************************************************************/
+
+size_t ZarrV3CodecShardingIndexed::GetInnerChunkCount() const
+{
+    size_t nCount = 1;
+    for (const auto nVal : m_anInnerBlockCount)
+        nCount *= nVal;
+    return nCount;
+}
+
+/************************************************************************/
+/*              ZarrV3CodecShardingIndexed::CopyInnerChunk()            */
+/************************************************************************/
+
+// Copies inner chunk nInnerChunkIdx (in C order) from a shard buffer to an
+// inner chunk buffer if bFromShard, or the reverse otherwise.
+
+void ZarrV3CodecShardingIndexed::CopyInnerChunk(size_t nInnerChunkIdx,
+                                                const GByte *pabySrc,
+                                                GByte *pabyDst,
+                                                bool bFromShard) const
+{
+    const size_t nDims = m_anInnerBlockSize.size();
+    const size_t nEltSize = m_oInputArrayMetadata.oElt.nativeSize;
+    if (nDims == 0)
+    {
+        memcpy(pabyDst, pabySrc, nEltSize);
+        return;
+    }
+    const auto &anShardSize = m_oInputArrayMetadata.anBlockSizes;
+
+    // Position in the shard of the first element of the inner chunk
+    std::vector<size_t> anStart(nDims);
+    for (size_t i = nDims; i > 0;)
+    {
+        --i;
+        anStart[i] = (nInnerChunkIdx % m_anInnerBlockCount[i]) *
+                     m_anInnerBlockSize[i];
+        nInnerChunkIdx /= m_anInnerBlockCount[i];
+    }
+
+    const size_t nRowSize = m_anInnerBlockSize[nDims - 1] * nEltSize;
+    std::vector<size_t> anIdx(nDims);
+    size_t nInnerOffset = 0;
+    while (true)
+    {
+        size_t nShardOffset = 0;
+        for (size_t i = 0; i < nDims; ++i)
+            nShardOffset =
+                nShardOffset * anShardSize[i] + anStart[i] + anIdx[i];
+        nShardOffset *= nEltSize;
+        if (bFromShard)
+            memcpy(pabyDst + nInnerOffset, pabySrc + nShardOffset, nRowSize);
+        else
+            memcpy(pabyDst + nShardOffset, pabySrc + nInnerOffset, nRowSize);
+        nInnerOffset += nRowSize;
+
+        // Advance to the next row, in C order
+        size_t iDim = nDims - 1;
+        while (true)
+        {
+            if (iDim == 0)
+                return;
+            --iDim;
+            if (++anIdx[iDim] < m_anInnerBlockSize[iDim])
+                break;
+            anIdx[iDim] = 0;
+        }
+    }
+}
+
+/************************************************************************/
+/*               ZarrV3CodecShardingIndexed::DecodeIndex()              */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::DecodeIndex(
+    ZarrByteVectorQuickResize &abyIndex, std::vector<uint64_t> &anIndex) const
+{
+    const size_t nValues = 2 * GetInnerChunkCount();
+    if (abyIndex.size() != m_nIndexSize ||
+        !m_poIndexCodecs->Decode(abyIndex) ||
+        abyIndex.size() != nValues * sizeof(uint64_t))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid shard index");
+        return false;
+    }
+    try
+    {
+        anIndex.resize(nValues);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    memcpy(anIndex.data(), abyIndex.data(), abyIndex.size());
+    return true;
+}
+
+/************************************************************************/
+/*               ZarrV3CodecShardingIndexed::EncodeIndex()              */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::EncodeIndex(
+    const std::vector<uint64_t> &anIndex,
+    ZarrByteVectorQuickResize &abyIndex) const
+{
+    CPLAssert(anIndex.size() == 2 * GetInnerChunkCount());
+    try
+    {
+        abyIndex.resize(anIndex.size() * sizeof(uint64_t));
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    memcpy(abyIndex.data(), anIndex.data(), abyIndex.size());
+    if (!m_poIndexCodecs->Encode(abyIndex))
+        return false;
+    CPLAssert(abyIndex.size() == m_nIndexSize);
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Encode()                 */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Encode(const ZarrByteVectorQuickResize &abySrc,
+                                        ZarrByteVectorQuickResize &abyDst) const
+{
+    const size_t nShardSize = m_oInputArrayMetadata.GetEltCount() *
+                              m_oInputArrayMetadata.oElt.nativeSize;
+    if (abySrc.size() < nShardSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ZarrV3CodecShardingIndexed::Encode(): input buffer too "
+                 "small");
+        return false;
+    }
+
+    const size_t nInnerChunkCount = GetInnerChunkCount();
+    const size_t nInnerSize = nShardSize / nInnerChunkCount;
+    std::vector<uint64_t> anIndex;
+    ZarrByteVectorQuickResize abyChunk;
+    ZarrByteVectorQuickResize abyIndex;
+    try
+    {
+        anIndex.resize(2 * nInnerChunkCount);
+        abyDst.resize(m_bIndexLocationAtEnd ? 0 : m_nIndexSize);
+        for (size_t i = 0; i < nInnerChunkCount; ++i)
+        {
+            abyChunk.resize(nInnerSize);
+            CopyInnerChunk(i, abySrc.data(), abyChunk.data(), true);
+            if (!m_poCodecs->Encode(abyChunk))
+                return false;
+            const size_t nOffset = abyDst.size();
+            anIndex[2 * i] = nOffset;
+            anIndex[2 * i + 1] = abyChunk.size();
+            abyDst.resize(nOffset + abyChunk.size());
+            memcpy(abyDst.data() + nOffset, abyChunk.data(), abyChunk.size());
+        }
+
+        if (!EncodeIndex(anIndex, abyIndex))
+            return false;
+        if (m_bIndexLocationAtEnd)
+        {
+            const size_t nOffset = abyDst.size();
+            abyDst.resize(nOffset + abyIndex.size());
+            memcpy(abyDst.data() + nOffset, abyIndex.data(), abyIndex.size());
+        }
+        else
+        {
+            memcpy(abyDst.data(), abyIndex.data(), abyIndex.size());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Decode()                 */
+/************************************************************************/
+
+// Inner chunks missing from the shard are filled with the fill value of the
+// array. ZarrV3Array bypasses this method when the sharding codec is the only
+// codec, to read inner chunks individually.
+
+bool ZarrV3CodecShardingIndexed::Decode(const ZarrByteVectorQuickResize &abySrc,
+                                        ZarrByteVectorQuickResize &abyDst) const
+{
+    if (abySrc.size() < m_nIndexSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ZarrV3CodecShardingIndexed::Decode(): shard too small");
+        return false;
+    }
+
+    const size_t nShardSize = m_oInputArrayMetadata.GetEltCount() *
+                              m_oInputArrayMetadata.oElt.nativeSize;
+    const size_t nInnerChunkCount = GetInnerChunkCount();
+    const size_t nInnerSize = nShardSize / nInnerChunkCount;
+    std::vector<uint64_t> anIndex;
+    ZarrByteVectorQuickResize abyChunk;
+    ZarrByteVectorQuickResize abyIndex;
+    try
+    {
+        abyIndex.resize(m_nIndexSize);
+        memcpy(abyIndex.data(),
+               abySrc.data() +
+                   (m_bIndexLocationAtEnd ? abySrc.size() - m_nIndexSize : 0),
+               m_nIndexSize);
+        if (!DecodeIndex(abyIndex, anIndex))
+            return false;
+
+        abyDst.resize(nShardSize);
+        for (size_t i = 0; i < nInnerChunkCount; ++i)
+        {
+            const uint64_t nOffset = anIndex[2 * i];
+            const uint64_t nSize = anIndex[2 * i + 1];
+            if (nOffset == MISSING_CHUNK && nSize == MISSING_CHUNK)
+            {
+                abyChunk.resize(nInnerSize);
+                const auto &abyFillValue = m_oInputArrayMetadata.abyFillValue;
+                if (abyFillValue.empty())
+                {
+                    memset(abyChunk.data(), 0, nInnerSize);
+                }
+                else
+                {
+                    for (size_t j = 0; j + abyFillValue.size() <= nInnerSize;
+                         j += abyFillValue.size())
+                    {
+                        memcpy(abyChunk.data() + j, abyFillValue.data(),
+                               abyFillValue.size());
+                    }
+                }
+            }
+            else
+            {
+                if (nOffset > abySrc.size() || nSize > abySrc.size() - nOffset)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "ZarrV3CodecShardingIndexed::Decode(): inner "
+                             "chunk %u out of shard",
+                             static_cast<unsigned>(i));
+                    return false;
+                }
+                abyChunk.resize(static_cast<size_t>(nSize));
+                if (nSize)
+                {
+                    memcpy(abyChunk.data(),
+                           abySrc.data() + static_cast<size_t>(nOffset),
+                           static_cast<size_t>(nSize));
+                }
+                if (!m_poCodecs->Decode(abyChunk))
+                    return false;
+                if (abyChunk.size() != nInnerSize)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "ZarrV3CodecShardingIndexed::Decode(): inner "
+                             "chunk %u has not expected size",
+                             static_cast<unsigned>(i));
+                    return false;
+                }
+            }
+            CopyInnerChunk(i, abyChunk.data(), abyDst.data(), false);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    return true;
+}
@@ -551,6 +551,38 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
                                   papszOptions))
         return nullptr;
 
+    // Shards are made of several chunks (then called inner chunks), stored
+    // in a single file, with an index to access each of them
+    std::vector<GUInt64> anShardBlockSize;
+    const char *pszShardSize = CSLFetchNameValue(papszOptions, "SHARD_SIZE");
+    if (pszShardSize)
+    {
+        const CPLStringList aosTokens(
+            CSLTokenizeString2(pszShardSize, ",", 0));
+        if (aoDimensions.empty() ||
+            static_cast<size_t>(aosTokens.size()) != aoDimensions.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid number of values in SHARD_SIZE");
+            return nullptr;
+        }
+        for (size_t i = 0; i < aoDimensions.size(); ++i)
+        {
+            const GUInt64 nShardSize =
+                static_cast<GUInt64>(CPLAtoGIntBig(aosTokens[i]));
+            if (nShardSize == 0 || (nShardSize % anBlockSize[i]) != 0 ||
+                nShardSize / anBlockSize[i] >
+                    std::numeric_limits<int>::max())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Values in SHARD_SIZE should be multiples of the "
+                         "block size");
+                return nullptr;
+            }
+            anShardBlockSize.push_back(nShardSize);
+        }
+    }
+
     const char *pszDimSeparator =
         CSLFetchNameValueDef(papszOptions, "DIM_SEPARATOR", "/");
 
@@ -596,6 +628,14 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
                                         EQUAL(pszEndian, "little")));
         oCodecs.Add(oCodec);
     }
+    else if (!anShardBlockSize.empty())
+    {
+        // Codecs of inner chunks must contain an array to bytes codec
+        CPLJSONObject oCodec;
+        oCodec.Add("name", "bytes");
+        oCodec.Add("configuration", ZarrV3CodecEndian::GetConfiguration(true));
+        oCodecs.Add(oCodec);
+    }
 
     const char *pszCompressor =
         CSLFetchNameValueDef(papszOptions, "COMPRESS", "NONE");
@@ -668,13 +708,25 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
         return nullptr;
     }
 
+    if (!anShardBlockSize.empty())
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", ZarrV3CodecShardingIndexed::NAME);
+        oCodec.Add("configuration",
+                   ZarrV3CodecShardingIndexed::GetConfiguration(anBlockSize,
+                                                                oCodecs));
+        oCodecs = CPLJSONArray();
+        oCodecs.Add(oCodec);
+    }
+
     if (oCodecs.Size() > 0)
     {
         // Byte swapping will be done by the codec chain
         aoDtypeElts.back().needByteSwapping = false;
 
         ZarrArrayMetadata oInputArrayMetadata;
-        for (auto &nSize : anBlockSize)
+        for (auto &nSize :
+             anShardBlockSize.empty() ? anBlockSize : anShardBlockSize)
             oInputArrayMetadata.anBlockSizes.push_back(
                 static_cast<size_t>(nSize));
         oInputArrayMetadata.oElt = aoDtypeElts.back();
@@ -697,6 +749,8 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
     poArray->SetDtype(dtype);
     if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
+    if (!anShardBlockSize.empty())
+        poArray->SetShardBlockSize(anShardBlockSize);
     poArray->SetUpdatable(true);
     poArray->SetDefinitionModified(true);
     poArray->Flush();
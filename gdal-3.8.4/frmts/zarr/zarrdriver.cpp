@@ -776,6 +776,15 @@ void ZarrDriver::InitMetadata()
             psBlockSizeNode, "description",
             "Comma separated list of chunk size along each dimension");
 
+        auto psShardSizeNode =
+            CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psShardSizeNode, "name", "SHARD_SIZE");
+        CPLAddXMLAttributeAndValue(psShardSizeNode, "type", "string");
+        CPLAddXMLAttributeAndValue(
+            psShardSizeNode, "description",
+            "Comma separated list of shard size along each dimension, as "
+            "multiples of the chunk size (only for ZARR_V3)");
+
         auto psChunkMemoryLayout =
             CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
         CPLAddXMLAttributeAndValue(psChunkMemoryLayout, "name",
@@ -2867,6 +2867,13 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
     mutable bool m_bHasTriedCachedArray = false;
     mutable std::shared_ptr<GDALMDArray> m_poCachedArray{};
 
+    bool m_bChunkCacheEnabled = false;
+    bool ReadUsingChunkCache(const GUInt64 *arrayStartIdx, const size_t *count,
+                             const GInt64 *arrayStep,
+                             const GPtrDiff_t *bufferStride,
+                             const GDALExtendedDataType &bufferDataType,
+                             void *pDstBuffer, bool &bUsedOut) const;
+
   protected:
     //! @cond Doxygen_Suppress
     GDALMDArray(const std::string &osParentName, const std::string &osName,
@@ -2880,6 +2887,8 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
         return true;
     }
 
+    void EnableChunkCache();
+
     virtual bool SetStatistics(bool bApproxStats, double dfMin, double dfMax,
                                double dfMean, double dfStdDev,
                                GUInt64 nValidCount, CSLConstList papszOptions);
@@ -3131,6 +3140,8 @@ bool GDALMDRasterIOFromBand(GDALRasterBand *poBand, GDALRWFlag eRWFlag,
                             const GPtrDiff_t *bufferStride,
                             const GDALExtendedDataType &bufferDataType,
                             void *pBuffer);
+
+void GDALMDArrayChunkCacheInvalidateFile(const char *pszFilename);
 //! @endcond
 
 /************************************************************************/
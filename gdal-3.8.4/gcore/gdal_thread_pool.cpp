@@ -28,33 +28,46 @@
 
 #include "gdal_thread_pool.h"
 
-#include <mutex>
-
-static std::mutex gMutexThreadPool;
-static CPLWorkerThreadPool *gpoCompressThreadPool = nullptr;
+/************************************************************************/
+/*                      GDALGetGlobalThreadPool()                       */
+/************************************************************************/
 
+/** Return the global thread pool, with at least nThreads threads.
+ *
+ * It is the pool of CPLGetGlobalThreadPool(), which CPL also uses.
+ */
 CPLWorkerThreadPool *GDALGetGlobalThreadPool(int nThreads)
 {
-    std::lock_guard<std::mutex> oGuard(gMutexThreadPool);
-    if (gpoCompressThreadPool == nullptr)
-    {
-        gpoCompressThreadPool = new CPLWorkerThreadPool();
-        if (!gpoCompressThreadPool->Setup(nThreads, nullptr, nullptr, false))
-        {
-            delete gpoCompressThreadPool;
-            gpoCompressThreadPool = nullptr;
-        }
-    }
-    else if (nThreads > gpoCompressThreadPool->GetThreadCount())
-    {
-        // Increase size of thread pool
-        gpoCompressThreadPool->Setup(nThreads, nullptr, nullptr, false);
-    }
-    return gpoCompressThreadPool;
+    return CPLGetGlobalThreadPool(nThreads);
 }
 
+/************************************************************************/
+/*                    GDALDestroyGlobalThreadPool()                     */
+/************************************************************************/
+
 void GDALDestroyGlobalThreadPool()
 {
-    delete gpoCompressThreadPool;
-    gpoCompressThreadPool = nullptr;
+    CPLDestroyGlobalThreadPool();
+}
+
+/************************************************************************/
+/*                         GDALGetNumThreads()                          */
+/************************************************************************/
+
+/** Returns the number of threads to use.
+ *
+ * The value is taken from the pszItem option of papszOptions if it is set,
+ * or from the GDAL_NUM_THREADS configuration option otherwise. It can be an
+ * integer or ALL_CPUS. When neither is set, 1 is returned, so that
+ * multi-threading is only enabled on request.
+ *
+ * @param papszOptions Options, or nullptr.
+ * @param pszItem Name of the option in papszOptions, or nullptr.
+ * @param nMaxThreads Maximum value returned.
+ * @return a number of threads in [1, nMaxThreads].
+ */
+int GDALGetNumThreads(CSLConstList papszOptions, const char *pszItem,
+                      int nMaxThreads)
+{
+    return CPLGetNumThreads(papszOptions, pszItem, nMaxThreads);
 }
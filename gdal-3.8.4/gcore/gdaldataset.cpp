@@ -299,6 +299,9 @@ GDALDataset::~GDALDataset()
             CPLDebug("GDAL", "GDALClose(%s, this=%p)", GetDescription(), this);
     }
 
+    // Release the decoded chunks of its multidimensional arrays
+    GDALMDArrayChunkCacheInvalidateFile(GetDescription());
+
     if (bSuppressOnClose)
     {
         if (poDriver == nullptr ||
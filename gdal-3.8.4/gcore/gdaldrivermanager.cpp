@@ -235,8 +235,6 @@ GDALDriverManager::~GDALDriverManager()
 
     CleanupPythonDrivers();
 
-    GDALDestroyGlobalThreadPool();
-
     /* -------------------------------------------------------------------- */
     /*      Cleanup local memory.                                           */
     /* -------------------------------------------------------------------- */
@@ -276,6 +274,12 @@ GDALDriverManager::~GDALDriverManager()
     VSICleanupFileManager();
     CPLDestroyCompressorRegistry();
 
+    /* -------------------------------------------------------------------- */
+    /*      Destroy the global thread pool, once nothing that may still     */
+    /*      use it is left, including virtual file handlers.                */
+    /* -------------------------------------------------------------------- */
+    GDALDestroyGlobalThreadPool();
+
     /* -------------------------------------------------------------------- */
     /*      Cleanup thread local storage ... I hope the program is all      */
     /*      done with GDAL/OGR!                                             */
@@ -30,7 +30,11 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <list>
+#include <map>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <utility>
@@ -50,6 +54,8 @@
 #define COMPILER_WARNS_ABOUT_ABSTRACT_VBASE_INIT
 #endif
 
+static void GDALMDArrayChunkCacheInvalidate(const GDALAbstractMDArray *poArray);
+
 /************************************************************************/
 /*                       GDALMDArrayUnscaled                            */
 /************************************************************************/
@@ -2257,8 +2263,13 @@ bool GDALAbstractMDArray::Write(const GUInt64 *arrayStartIdx,
         return false;
     }
 
-    return IWrite(arrayStartIdx, count, arrayStep, bufferStride, bufferDataType,
-                  pSrcBuffer);
+    const bool bRet = IWrite(arrayStartIdx, count, arrayStep, bufferStride,
+                             bufferDataType, pSrcBuffer);
+
+    // Decoded chunks of the array are now stale
+    GDALMDArrayChunkCacheInvalidate(this);
+
+    return bRet;
 }
 
 /************************************************************************/
@@ -2967,6 +2978,11 @@ enum class Caller
  * This method is to be used when doing operations on an array, or a subset of
  * it, in a chunk by chunk way.
  *
+ * Chunk boundaries are multiples of chunkSize. Passing the output of
+ * GetProcessingChunkSize(0) as chunkSize thus visits the array one natural
+ * block (as returned by GetBlockSize()) at a time, in row-major order of the
+ * blocks, which is the I/O-optimal granularity for chunked formats.
+ *
  * @param arrayStartIdx Values representing the starting index to use
  *                      in each dimension (in [0, aoDims[i].GetSize()-1] range).
  *                      Array of GetDimensionCount() values. Must not be
@@ -4237,6 +4253,173 @@ bool GDALMDArray::Cache(CSLConstList papszOptions) const
                                    nCost, GetTotalCopyCost(), nullptr, nullptr);
 }
 
+/************************************************************************/
+/*                        GDALMDArrayChunkCache                         */
+/************************************************************************/
+
+namespace
+{
+// Process-wide cache of decoded chunks of arrays, shared by the drivers whose
+// arrays opt in with GDALMDArray::EnableChunkCache().
+// Chunks are stored with the data type of their array, in row-major order,
+// and evicted in least recently used order once their total size exceeds the
+// value of the GDAL_MDARRAY_CHUNK_CACHE_SIZE configuration option.
+// Keys start with the filename and the full name of the array, so that
+// several objects opened on the same array share their chunks, and that a
+// write through any of them invalidates the chunks of all of them.
+class GDALMDArrayChunkCache
+{
+    struct Entry
+    {
+        std::string osKey{};
+        std::shared_ptr<const std::vector<GByte>> poData{};
+    };
+
+    std::mutex m_oMutex{};
+    // Most recently used first
+    std::list<Entry> m_oList{};
+    // Ordered, so that all chunks of an array or of a file can be found from
+    // the prefix of their key
+    std::map<std::string, std::list<Entry>::iterator> m_oMap{};
+    size_t m_nSize = 0;
+
+    GDALMDArrayChunkCache() = default;
+
+  public:
+    // Set once a chunk has been inserted, so that writes and dataset
+    // closing do not pay for the cache when it is not used.
+    static std::atomic<bool> gbUsed;
+
+    static GDALMDArrayChunkCache &Get()
+    {
+        // Never destroyed, as arrays may be destroyed at process exit
+        static GDALMDArrayChunkCache *poCache = new GDALMDArrayChunkCache();
+        return *poCache;
+    }
+
+    static std::string GetFileKeyPrefix(const std::string &osFilename)
+    {
+        return osFilename + '\n';
+    }
+
+    // Returns the prefix of the keys of the chunks of an array, or an empty
+    // string if its chunks cannot be cached.
+    static std::string GetArrayKeyPrefix(const GDALMDArray *poArray)
+    {
+        const auto &osFilename = poArray->GetFilename();
+        if (osFilename.empty())
+            return std::string();
+        return GetFileKeyPrefix(osFilename) + poArray->GetFullName() + '\n';
+    }
+
+    std::shared_ptr<const std::vector<GByte>> Find(const std::string &osKey)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        const auto oIter = m_oMap.find(osKey);
+        if (oIter == m_oMap.end())
+            return nullptr;
+        m_oList.splice(m_oList.begin(), m_oList, oIter->second);
+        return oIter->second->poData;
+    }
+
+    void Insert(const std::string &osKey,
+                const std::shared_ptr<const std::vector<GByte>> &poData,
+                size_t nMaxSize)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        gbUsed = true;
+        const auto oIter = m_oMap.find(osKey);
+        if (oIter != m_oMap.end())
+        {
+            m_nSize -= oIter->second->poData->size();
+            m_oList.erase(oIter->second);
+            m_oMap.erase(oIter);
+        }
+        Entry oEntry;
+        oEntry.osKey = osKey;
+        oEntry.poData = poData;
+        m_oList.emplace_front(std::move(oEntry));
+        m_oMap[osKey] = m_oList.begin();
+        m_nSize += poData->size();
+        while (m_nSize > nMaxSize && m_oList.size() > 1)
+        {
+            const auto &oOldest = m_oList.back();
+            m_nSize -= oOldest.poData->size();
+            m_oMap.erase(oOldest.osKey);
+            m_oList.pop_back();
+        }
+    }
+
+    // Removes the chunks whose key starts with osKeyPrefix
+    void Invalidate(const std::string &osKeyPrefix)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        auto oIter = m_oMap.lower_bound(osKeyPrefix);
+        while (oIter != m_oMap.end() &&
+               oIter->first.compare(0, osKeyPrefix.size(), osKeyPrefix) == 0)
+        {
+            m_nSize -= oIter->second->poData->size();
+            m_oList.erase(oIter->second);
+            oIter = m_oMap.erase(oIter);
+        }
+    }
+};
+
+std::atomic<bool> GDALMDArrayChunkCache::gbUsed{false};
+}  // namespace
+
+/************************************************************************/
+/*                  GDALMDArrayChunkCacheInvalidate()                   */
+/************************************************************************/
+
+static void GDALMDArrayChunkCacheInvalidate(const GDALAbstractMDArray *poArray)
+{
+    if (!GDALMDArrayChunkCache::gbUsed)
+        return;
+    const auto poMDArray = dynamic_cast<const GDALMDArray *>(poArray);
+    if (poMDArray == nullptr)
+        return;
+    const std::string osKeyPrefix(
+        GDALMDArrayChunkCache::GetArrayKeyPrefix(poMDArray));
+    if (!osKeyPrefix.empty())
+        GDALMDArrayChunkCache::Get().Invalidate(osKeyPrefix);
+}
+
+/************************************************************************/
+/*                GDALMDArrayChunkCacheInvalidateFile()                 */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// Called when a dataset is closed, to release the chunks of its arrays.
+void GDALMDArrayChunkCacheInvalidateFile(const char *pszFilename)
+{
+    if (GDALMDArrayChunkCache::gbUsed && pszFilename[0] != '\0')
+    {
+        GDALMDArrayChunkCache::Get().Invalidate(
+            GDALMDArrayChunkCache::GetFileKeyPrefix(pszFilename));
+    }
+}
+//! @endcond
+
+/************************************************************************/
+/*                          EnableChunkCache()                          */
+/************************************************************************/
+
+/** Allow decoded chunks of this array to be kept in the process-wide chunk
+ * cache, enabled with the GDAL_MDARRAY_CHUNK_CACHE_SIZE configuration option.
+ *
+ * This is meant to be called by drivers, once the array is constructed, for
+ * arrays whose IRead() implementation decodes data from their dataset. It
+ * must not be called for arrays that only forward their requests to other
+ * arrays.
+ *
+ * @since GDAL 3.9
+ */
+void GDALMDArray::EnableChunkCache()
+{
+    m_bChunkCacheEnabled = true;
+}
+
 /************************************************************************/
 /*                               Read()                                 */
 /************************************************************************/
@@ -4316,10 +4499,251 @@ bool GDALMDArray::Read(const GUInt64 *arrayStartIdx, const size_t *count,
         return false;
     }
 
+    bool bUsedChunkCache = false;
+    if (!array->ReadUsingChunkCache(arrayStartIdx, count, arrayStep,
+                                    bufferStride, bufferDataType, pDstBuffer,
+                                    bUsedChunkCache))
+    {
+        return false;
+    }
+    if (bUsedChunkCache)
+        return true;
+
     return array->IRead(arrayStartIdx, count, arrayStep, bufferStride,
                         bufferDataType, pDstBuffer);
 }
 
+/************************************************************************/
+/*                         ReadUsingChunkCache()                        */
+/************************************************************************/
+
+// If the GDAL_MDARRAY_CHUNK_CACHE_SIZE configuration option is set to a
+// number of bytes, serves the request from decoded chunks of the array,
+// reading whole chunks with IRead() if they are not in the process-wide
+// chunk cache. This avoids decoding again and again the same chunks when
+// the requests are not aligned on them, like when extracting time series.
+// bUsedOut is set to false if the request is not eligible, in which case
+// the caller must use IRead().
+
+bool GDALMDArray::ReadUsingChunkCache(
+    const GUInt64 *arrayStartIdx, const size_t *count, const GInt64 *arrayStep,
+    const GPtrDiff_t *bufferStride, const GDALExtendedDataType &bufferDataType,
+    void *pDstBuffer, bool &bUsedOut) const
+{
+    bUsedOut = false;
+
+    const GIntBig nCacheSizeBig = CPLAtoGIntBig(
+        CPLGetConfigOption("GDAL_MDARRAY_CHUNK_CACHE_SIZE", "0"));
+    if (nCacheSizeBig <= 0)
+        return true;
+    const size_t nCacheSize = static_cast<size_t>(std::min<GUIntBig>(
+        static_cast<GUIntBig>(nCacheSizeBig),
+        std::numeric_limits<size_t>::max()));
+
+    const auto &dims = GetDimensions();
+    const size_t nDims = dims.size();
+    const auto &oType = GetDataType();
+    if (nDims == 0 || !m_bChunkCacheEnabled ||
+        oType.GetClass() != GEDTC_NUMERIC ||
+        bufferDataType.GetClass() != GEDTC_NUMERIC)
+    {
+        return true;
+    }
+    std::string osArrayKey(GDALMDArrayChunkCache::GetArrayKeyPrefix(this));
+    if (osArrayKey.empty())
+        return true;
+    auto &oCache = GDALMDArrayChunkCache::Get();
+    // Chunks cached before a resize of the array must not be used after it,
+    // nor by another object of the array with a different data type or
+    // block size.
+    const auto anBlockSize = GetBlockSize();
+    osArrayKey += std::to_string(static_cast<int>(oType.GetNumericDataType()));
+    osArrayKey += ',';
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        osArrayKey += std::to_string(dims[i]->GetSize());
+        osArrayKey += 'x';
+        osArrayKey += std::to_string(anBlockSize[i]);
+        osArrayKey += ',';
+    }
+    osArrayKey += '\n';
+
+    const size_t nDTSize = oType.GetSize();
+    size_t nChunkSize = nDTSize;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (anBlockSize[i] == 0 || arrayStep[i] < 0)
+            return true;
+        const GUInt64 nBlockSize =
+            std::min(anBlockSize[i], dims[i]->GetSize());
+        if (nBlockSize > nCacheSize / nChunkSize)
+            return true;
+        nChunkSize *= static_cast<size_t>(nBlockSize);
+    }
+    // Leave room for several chunks
+    if (nChunkSize > nCacheSize / 4)
+        return true;
+
+    // Split the request along each dimension into segments of values that
+    // belong to the same chunk
+    struct Segment
+    {
+        GUInt64 nChunkIdx = 0;
+        size_t nFirst = 0;  // index of the first value in the request
+        size_t nCount = 0;
+    };
+    std::vector<std::vector<Segment>> aoSegments(nDims);
+    const size_t nMaxChunks = nCacheSize / nChunkSize;
+    size_t nChunks = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const GUInt64 nBlockSize = anBlockSize[i];
+        const GUInt64 nStep = static_cast<GUInt64>(arrayStep[i]);
+        size_t k = 0;
+        while (k < count[i])
+        {
+            // Do not thrash the cache with requests over too many chunks
+            if (nChunks * (aoSegments[i].size() + 1) > nMaxChunks)
+                return true;
+            const GUInt64 nIdx = arrayStartIdx[i] + k * nStep;
+            Segment oSegment;
+            oSegment.nChunkIdx = nIdx / nBlockSize;
+            oSegment.nFirst = k;
+            oSegment.nCount = count[i] - k;
+            if (nStep > 0)
+            {
+                const GUInt64 nCountInChunk =
+                    ((oSegment.nChunkIdx + 1) * nBlockSize - 1 - nIdx) /
+                        nStep +
+                    1;
+                if (nCountInChunk < oSegment.nCount)
+                    oSegment.nCount = static_cast<size_t>(nCountInChunk);
+            }
+            aoSegments[i].push_back(oSegment);
+            k += oSegment.nCount;
+        }
+        nChunks *= aoSegments[i].size();
+    }
+
+    bUsedOut = true;
+
+    const size_t nBufferDTSize = bufferDataType.GetSize();
+    GByte *pabyDstBuffer = static_cast<GByte *>(pDstBuffer);
+    std::vector<size_t> anSegmentIdx(nDims);
+    std::vector<GUInt64> anChunkStartIdx(nDims);
+    std::vector<size_t> anChunkCount(nDims);
+    std::vector<GPtrDiff_t> anChunkStride(nDims);
+    const std::vector<GInt64> anChunkStep(nDims, 1);
+    std::vector<size_t> anIdx(nDims);
+    while (true)
+    {
+        std::string osKey(osArrayKey);
+        for (size_t i = 0; i < nDims; ++i)
+        {
+            const auto &oSegment = aoSegments[i][anSegmentIdx[i]];
+            anChunkStartIdx[i] = oSegment.nChunkIdx * anBlockSize[i];
+            anChunkCount[i] = static_cast<size_t>(std::min(
+                anBlockSize[i], dims[i]->GetSize() - anChunkStartIdx[i]));
+            osKey += std::to_string(oSegment.nChunkIdx);
+            osKey += ',';
+        }
+        GPtrDiff_t nStride = 1;
+        for (size_t i = nDims; i > 0;)
+        {
+            --i;
+            anChunkStride[i] = nStride;
+            nStride *= static_cast<GPtrDiff_t>(anChunkCount[i]);
+        }
+
+        auto poChunk = oCache.Find(osKey);
+        if (!poChunk)
+        {
+            auto poNewChunk = std::make_shared<std::vector<GByte>>();
+            try
+            {
+                poNewChunk->resize(static_cast<size_t>(nStride) * nDTSize);
+            }
+            catch (const std::bad_alloc &e)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+                return false;
+            }
+            if (!IRead(anChunkStartIdx.data(), anChunkCount.data(),
+                       anChunkStep.data(), anChunkStride.data(), oType,
+                       poNewChunk->data()))
+            {
+                return false;
+            }
+            oCache.Insert(osKey, poNewChunk, nCacheSize);
+            poChunk = std::move(poNewChunk);
+        }
+
+        // Copy the values of the request that are in the chunk, row by row
+        for (size_t i = 0; i < nDims; ++i)
+            anIdx[i] = aoSegments[i][anSegmentIdx[i]].nFirst;
+        const auto &oLastSegment =
+            aoSegments[nDims - 1][anSegmentIdx[nDims - 1]];
+        while (true)
+        {
+            size_t nSrcOffset = 0;
+            GPtrDiff_t nDstOffset = 0;
+            for (size_t i = 0; i < nDims; ++i)
+            {
+                nSrcOffset += static_cast<size_t>(
+                    (arrayStartIdx[i] + anIdx[i] * arrayStep[i] -
+                     anChunkStartIdx[i]) *
+                    anChunkStride[i]);
+                nDstOffset += static_cast<GPtrDiff_t>(anIdx[i]) *
+                              bufferStride[i];
+            }
+            if (!GDALExtendedDataType::CopyValues(
+                    poChunk->data() + nSrcOffset * nDTSize, oType,
+                    static_cast<GPtrDiff_t>(arrayStep[nDims - 1]),
+                    pabyDstBuffer +
+                        nDstOffset * static_cast<GPtrDiff_t>(nBufferDTSize),
+                    bufferDataType, bufferStride[nDims - 1],
+                    oLastSegment.nCount))
+            {
+                return false;
+            }
+
+            size_t iDim = nDims - 1;
+            bool bNextRow = false;
+            while (iDim > 0)
+            {
+                --iDim;
+                const auto &oSegment = aoSegments[iDim][anSegmentIdx[iDim]];
+                if (++anIdx[iDim] < oSegment.nFirst + oSegment.nCount)
+                {
+                    bNextRow = true;
+                    break;
+                }
+                anIdx[iDim] = oSegment.nFirst;
+            }
+            if (!bNextRow)
+                break;
+        }
+
+        // Next chunk
+        size_t iDim = nDims;
+        bool bNextChunk = false;
+        while (iDim > 0)
+        {
+            --iDim;
+            if (++anSegmentIdx[iDim] < aoSegments[iDim].size())
+            {
+                bNextChunk = true;
+                break;
+            }
+            anSegmentIdx[iDim] = 0;
+        }
+        if (!bNextChunk)
+            break;
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                          GetRootGroup()                              */
 /************************************************************************/
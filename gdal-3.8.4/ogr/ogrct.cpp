@@ -36,7 +36,6 @@
 #include <cstring>
 #include <limits>
 #include <list>
-#include <mutex>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -86,11 +85,23 @@ static void CPLGettimeofday(struct CPLTimeVal *tp, void * /* timezonep*/)
 #endif  // DEBUG_PERF
 
 // Cache of OGRProjCT objects
-static std::mutex g_oCTCacheMutex;
 class OGRProjCT;
 typedef std::string CTCacheKey;
 typedef std::unique_ptr<OGRProjCT> CTCacheValue;
-static lru11::Cache<CTCacheKey, CTCacheValue> *g_poCTCache = nullptr;
+typedef lru11::ShardedCache<CTCacheKey, CTCacheValue> CTCacheType;
+
+static CTCacheType *GetCTCache()
+{
+    // Intentionally never destroyed: OGRProjCT objects must not be destroyed
+    // at process exit, after PROJ contexts. OSRCTCleanCache() empties it.
+    // Each of the 8 shards holds 16 entries, plus 10 before being pruned, so
+    // that up to 64 transformations in use, as with the former single cache
+    // of 64 + 10 entries, are unlikely to overflow one shard.
+    static CTCacheType *const poCTCache =
+        new CTCacheType(/* maxSize = */ 128, /* elasticity = */ 80,
+                        /* maxWeight = */ 0, /* nShards = */ 8);
+    return poCTCache;
+}
 
 /************************************************************************/
 /*             OGRCoordinateTransformationOptions::Private              */
@@ -3551,9 +3562,7 @@ OGRCoordinateTransformation *OGRProjCT::GetInverse() const
 
 void OSRCTCleanCache()
 {
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    delete g_poCTCache;
-    g_poCTCache = nullptr;
+    GetCTCache()->clear();
 }
 
 /************************************************************************/
@@ -3596,24 +3605,13 @@ CTCacheKey OGRProjCT::MakeCacheKey(
 
 void OGRProjCT::InsertIntoCache(OGRProjCT *poCT)
 {
-    {
-        std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-        if (g_poCTCache == nullptr)
-        {
-            g_poCTCache = new lru11::Cache<CTCacheKey, CTCacheValue>();
-        }
-    }
     const auto key = MakeCacheKey(poCT->poSRSSource, poCT->m_osSrcSRS.c_str(),
                                   poCT->poSRSTarget,
                                   poCT->m_osTargetSRS.c_str(), poCT->m_options);
 
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    if (g_poCTCache->contains(key))
-    {
-        delete poCT;
-        return;
-    }
-    g_poCTCache->insert(key, std::unique_ptr<OGRProjCT>(poCT));
+    // If there is already an entry for that key, poCT is destroyed here.
+    CTCacheValue value(poCT);
+    GetCTCache()->insertIfAbsent(key, std::move(value));
 }
 
 /************************************************************************/
@@ -3625,23 +3623,16 @@ OGRProjCT *OGRProjCT::FindFromCache(
     const OGRSpatialReference *poTarget, const char *pszTargetSRS,
     const OGRCoordinateTransformationOptions &options)
 {
-    {
-        std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-        if (g_poCTCache == nullptr || g_poCTCache->empty())
-            return nullptr;
-    }
+    auto poCTCache = GetCTCache();
+    if (poCTCache->empty())
+        return nullptr;
 
     const auto key =
         MakeCacheKey(poSource, pszSrcSRS, poTarget, pszTargetSRS, options);
     // Get value from cache and remove it
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    CTCacheValue *cachedValue = g_poCTCache->getPtr(key);
-    if (cachedValue)
-    {
-        auto poCT = cachedValue->release();
-        g_poCTCache->remove(key);
-        return poCT;
-    }
+    CTCacheValue cachedValue;
+    if (poCTCache->tryTake(key, cachedValue))
+        return cachedValue.release();
     return nullptr;
 }
 
@@ -41,6 +41,8 @@
 
 #include <limits>
 
+#include "include_fast_float.h"
+
 #if (!defined(JSON_C_VERSION_NUM)) || (JSON_C_VERSION_NUM < JSON_C_VER_013)
 const size_t ESTIMATE_BASE_OBJECT_SIZE = sizeof(struct json_object);
 #elif JSON_C_VERSION_NUM == JSON_C_VER_013  // no way to get the size
@@ -272,8 +274,8 @@ void OGRJSONCollectionStreamingParser::StartObjectMember(const char *pszKey,
             if (!m_abFirstMember.back())
                 m_osJson += ",";
             m_abFirstMember.back() = false;
-            m_osJson +=
-                CPLJSonStreamingParser::GetSerializedString(pszKey) + ":";
+            CPLJSonStreamingParser::AppendSerializedString(m_osJson, pszKey);
+            m_osJson += ':';
         }
 
         m_nCurObjMemEstimate += ESTIMATE_OBJECT_ELT_SIZE;
@@ -392,12 +394,63 @@ void OGRJSONCollectionStreamingParser::String(const char *pszValue, size_t nLen)
         }
         if (m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3)
         {
-            m_osJson += CPLJSonStreamingParser::GetSerializedString(pszValue);
+            CPLJSonStreamingParser::AppendSerializedString(m_osJson, pszValue);
         }
         AppendObject(json_object_new_string(pszValue));
     }
 }
 
+/************************************************************************/
+/*                        ParseStrictJSONNumber()                       */
+/************************************************************************/
+
+// Fast path for the numbers that follow the strict JSON grammar, that is
+// the vast majority of them. Returns false for anything else (Infinity, NaN,
+// malformed or overflowing numbers), which is left to the generic code.
+static bool ParseStrictJSONNumber(const char *pszValue, size_t nLen,
+                                  bool &bIsReal, double &dfVal)
+{
+    const char *pszIter = pszValue;
+    const char *const pszEnd = pszValue + nLen;
+    const auto SkipDigits = [&pszIter, pszEnd]()
+    {
+        const char *pszStart = pszIter;
+        while (pszIter < pszEnd && *pszIter >= '0' && *pszIter <= '9')
+            ++pszIter;
+        return pszIter != pszStart;
+    };
+
+    if (pszIter < pszEnd && *pszIter == '-')
+        ++pszIter;
+    if (!SkipDigits())
+        return false;
+    bIsReal = false;
+    if (pszIter < pszEnd && *pszIter == '.')
+    {
+        ++pszIter;
+        if (!SkipDigits())
+            return false;
+        bIsReal = true;
+    }
+    if (pszIter < pszEnd && (*pszIter == 'e' || *pszIter == 'E'))
+    {
+        ++pszIter;
+        if (pszIter < pszEnd && (*pszIter == '+' || *pszIter == '-'))
+            ++pszIter;
+        if (!SkipDigits())
+            return false;
+        bIsReal = true;
+    }
+    if (pszIter != pszEnd)
+        return false;
+    if (!bIsReal)
+        return true;
+
+    const auto answer = fast_float::from_chars(pszValue, pszEnd, dfVal);
+    return answer.ec == std::errc() && answer.ptr == pszEnd &&
+           CPLIsFinite(dfVal);
+}
+
 /************************************************************************/
 /*                              Number()                                */
 /************************************************************************/
@@ -429,7 +482,16 @@ void OGRJSONCollectionStreamingParser::Number(const char *pszValue, size_t nLen)
             m_osJson.append(pszValue, nLen);
         }
 
-        if (CPLGetValueType(pszValue) == CPL_VALUE_REAL)
+        bool bIsReal = false;
+        double dfVal = 0;
+        if (ParseStrictJSONNumber(pszValue, nLen, bIsReal, dfVal))
+        {
+            if (bIsReal)
+                AppendObject(json_object_new_double(dfVal));
+            else
+                AppendObject(json_object_new_int64(CPLAtoGIntBig(pszValue)));
+        }
+        else if (CPLGetValueType(pszValue) == CPL_VALUE_REAL)
         {
             AppendObject(json_object_new_double(CPLAtof(pszValue)));
         }
@@ -27,6 +27,7 @@
 
 #include "cpl_compressor.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_conv.h"  // CPLZLibInflate()
@@ -60,6 +61,11 @@
 #include <lz4.h>
 #endif
 
+#include "cpl_worker_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <mutex>
 #include <type_traits>
@@ -69,6 +75,34 @@ static std::mutex gMutex;
 static std::vector<CPLCompressor *> *gpCompressors = nullptr;
 static std::vector<CPLCompressor *> *gpDecompressors = nullptr;
 
+namespace
+{
+// Contexts that the builtin codecs reuse while a thread processes the
+// chunks of a CPLCompressChunked() or CPLDecompressChunked() call, instead
+// of creating them for each chunk.
+struct CPLCodecContexts
+{
+#ifdef HAVE_ZSTD
+    ZSTD_CCtx *psZSTDCCtx = nullptr;
+    ZSTD_DCtx *psZSTDDCtx = nullptr;
+#endif
+
+    CPLCodecContexts() = default;
+
+    ~CPLCodecContexts()
+    {
+#ifdef HAVE_ZSTD
+        ZSTD_freeCCtx(psZSTDCCtx);
+        ZSTD_freeDCtx(psZSTDDCtx);
+#endif
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLCodecContexts)
+};
+}  // namespace
+
+static thread_local CPLCodecContexts *tlsCodecContexts = nullptr;
+
 #ifdef HAVE_BLOSC
 static bool CPLBloscCompressor(const void *input_data, size_t input_size,
                                void **output_data, size_t *output_size,
@@ -390,16 +424,24 @@ static bool CPLZSTDCompressor(const void *input_data, size_t input_size,
         output_size != nullptr && *output_size != 0)
     {
         const int level = atoi(CSLFetchNameValueDef(options, "LEVEL", "13"));
-        ZSTD_CCtx *ctx = ZSTD_createCCtx();
+        CPLCodecContexts *psContexts = tlsCodecContexts;
+        ZSTD_CCtx *ctx = psContexts ? psContexts->psZSTDCCtx : nullptr;
         if (ctx == nullptr)
         {
-            *output_size = 0;
-            return false;
+            ctx = ZSTD_createCCtx();
+            if (ctx == nullptr)
+            {
+                *output_size = 0;
+                return false;
+            }
+            if (psContexts)
+                psContexts->psZSTDCCtx = ctx;
         }
 
         size_t ret = ZSTD_compressCCtx(ctx, *output_data, *output_size,
                                        input_data, input_size, level);
-        ZSTD_freeCCtx(ctx);
+        if (!psContexts)
+            ZSTD_freeCCtx(ctx);
         if (ZSTD_isError(ret))
         {
             *output_size = 0;
@@ -480,6 +522,21 @@ static size_t CPLZSTDGetDecompressedSize(const void *input_data,
     return static_cast<size_t>(nRet);
 }
 
+static size_t CPLZSTDDecompress(void *dst, size_t dstCapacity,
+                                const void *src, size_t srcSize)
+{
+    CPLCodecContexts *psContexts = tlsCodecContexts;
+    if (psContexts)
+    {
+        if (psContexts->psZSTDDCtx == nullptr)
+            psContexts->psZSTDDCtx = ZSTD_createDCtx();
+        if (psContexts->psZSTDDCtx)
+            return ZSTD_decompressDCtx(psContexts->psZSTDDCtx, dst,
+                                       dstCapacity, src, srcSize);
+    }
+    return ZSTD_decompress(dst, dstCapacity, src, srcSize);
+}
+
 static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
                                 void **output_data, size_t *output_size,
                                 CSLConstList /* options */,
@@ -488,8 +545,8 @@ static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
     if (output_data != nullptr && *output_data != nullptr &&
         output_size != nullptr && *output_size != 0)
     {
-        size_t ret =
-            ZSTD_decompress(*output_data, *output_size, input_data, input_size);
+        size_t ret = CPLZSTDDecompress(*output_data, *output_size, input_data,
+                                       input_size);
         if (ZSTD_isError(ret))
         {
             *output_size = CPLZSTDGetDecompressedSize(input_data, input_size);
@@ -518,7 +575,7 @@ static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
         }
 
         size_t ret =
-            ZSTD_decompress(*output_data, nOutSize, input_data, input_size);
+            CPLZSTDDecompress(*output_data, nOutSize, input_data, input_size);
         if (ZSTD_isError(ret))
         {
             *output_size = 0;
@@ -1997,6 +2054,415 @@ const CPLCompressor *CPLGetDecompressor(const char *pszId)
     return nullptr;
 }
 
+/************************************************************************/
+/*                        CPLProcessChunks()                            */
+/************************************************************************/
+
+// Calls fnProcessChunk() for each chunk index, from up to nThreads threads,
+// including the calling one. Returns false as soon as one call fails.
+static bool CPLProcessChunks(size_t nChunks, int nThreads,
+                             const std::function<bool(size_t)> &fnProcessChunk)
+{
+    std::atomic<size_t> nNextChunk{0};
+    std::atomic<bool> bSuccess{true};
+    std::mutex oErrorsMutex;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    const auto fnJob = [nChunks, &nNextChunk, &bSuccess, &fnProcessChunk,
+                        &oErrorsMutex, &aoErrors](bool bInWorkerThread)
+    {
+        // Errors of worker threads are emitted by the calling thread.
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoJobErrors;
+        if (bInWorkerThread)
+            CPLInstallErrorHandlerAccumulator(aoJobErrors);
+
+        CPLCodecContexts oContexts;
+        CPLCodecContexts *psPreviousContexts = tlsCodecContexts;
+        tlsCodecContexts = &oContexts;
+        while (bSuccess)
+        {
+            const size_t i = nNextChunk++;
+            if (i >= nChunks)
+                break;
+            if (!fnProcessChunk(i))
+                bSuccess = false;
+        }
+        tlsCodecContexts = psPreviousContexts;
+
+        if (bInWorkerThread)
+        {
+            CPLUninstallErrorHandlerAccumulator();
+            std::lock_guard<std::mutex> oLock(oErrorsMutex);
+            aoErrors.insert(aoErrors.end(), aoJobErrors.begin(),
+                            aoJobErrors.end());
+        }
+    };
+
+    const int nJobs = static_cast<int>(
+        std::min(static_cast<size_t>(std::max(1, nThreads)), nChunks));
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? CPLGetGlobalThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poQueue;
+    if (poPool)
+    {
+        poQueue = poPool->CreateJobQueue();
+        for (int i = 1; i < nJobs; ++i)
+        {
+            if (!poQueue->SubmitJob([&fnJob]() { fnJob(true); }))
+                break;
+        }
+    }
+    fnJob(false);
+    if (poQueue)
+        poQueue->WaitCompletion();
+
+    for (const auto &oError : aoErrors)
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    return bSuccess;
+}
+
+// Header of chunked streams: signature, uncompressed size, chunk size, and
+// compressed size of each chunk, all as little-endian 64-bit integers.
+constexpr char CHUNKED_SIGNATURE[] = "CPLCHNK1";
+constexpr size_t CHUNKED_SIGNATURE_SIZE = sizeof(CHUNKED_SIGNATURE) - 1;
+constexpr size_t CHUNKED_HEADER_SIZE = CHUNKED_SIGNATURE_SIZE + 2 * 8;
+
+static void CPLWriteUInt64LE(GByte *pabyDst, uint64_t nVal)
+{
+    CPL_LSBPTR64(&nVal);
+    memcpy(pabyDst, &nVal, sizeof(nVal));
+}
+
+static uint64_t CPLReadUInt64LE(const GByte *pabySrc)
+{
+    uint64_t nVal;
+    memcpy(&nVal, pabySrc, sizeof(nVal));
+    CPL_LSBPTR64(&nVal);
+    return nVal;
+}
+
+/************************************************************************/
+/*                        CPLCompressChunked()                          */
+/************************************************************************/
+
+/** Compress a buffer as independent chunks, in parallel.
+ *
+ * The input is split into chunks of CHUNK_SIZE bytes (the last one may be
+ * smaller), that are compressed independently with the compressor, using
+ * a thread pool. The output is made of a header indexing the chunks,
+ * followed by their compressed data, and can be decompressed, also in
+ * parallel, with CPLDecompressChunked().
+ *
+ * The compressor is called with the passed options, so the ones it
+ * accepts, such as LEVEL, can be specified. When it is a filter, such as
+ * "delta" or "shuffle", CHUNK_SIZE should be a multiple of the size of its
+ * elements.
+ *
+ * The following options are also recognized:
+ * <ul>
+ * <li>CHUNK_SIZE=number_of_bytes. Defaults to 1048576.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS. Defaults to the value
+ * of the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
+ *
+ * The valid situations for output_data and output_size are the same as for
+ * a CPLCompressionFunc.
+ *
+ * @param compressor Compressor. Should NOT be NULL.
+ * @param input_data Input data. Should not be NULL.
+ * @param input_size Size of input data, in bytes.
+ * @param output_data Pointer to output data.
+ * @param output_size Pointer to output size.
+ * @param options NULL terminated list of options. Or NULL.
+ * @return true in case of success.
+ * @since GDAL 3.9
+ */
+bool CPLCompressChunked(const CPLCompressor *compressor, const void *input_data,
+                        size_t input_size, void **output_data,
+                        size_t *output_size, CSLConstList options)
+{
+    if (output_size == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid use of API");
+        return false;
+    }
+
+    const GIntBig nChunkSizeOpt =
+        CPLAtoGIntBig(CSLFetchNameValueDef(options, "CHUNK_SIZE", "1048576"));
+    if (nChunkSizeOpt <= 0 || static_cast<GUIntBig>(nChunkSizeOpt) >
+                                  std::numeric_limits<size_t>::max())
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Invalid CHUNK_SIZE");
+        *output_size = 0;
+        return false;
+    }
+    const size_t nChunkSize = static_cast<size_t>(nChunkSizeOpt);
+
+    const GByte *pabyInput = static_cast<const GByte *>(input_data);
+    const size_t nChunks =
+        input_size / nChunkSize + (input_size % nChunkSize ? 1 : 0);
+    const auto GetChunkSize = [input_size, nChunkSize](size_t i)
+    { return std::min(nChunkSize, input_size - i * nChunkSize); };
+    if (nChunks > (std::numeric_limits<size_t>::max() - CHUNKED_HEADER_SIZE) /
+                      sizeof(uint64_t))
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Too many chunks");
+        *output_size = 0;
+        return false;
+    }
+    const size_t nHeaderSize = CHUNKED_HEADER_SIZE + nChunks * sizeof(uint64_t);
+
+    /* -------------------------------------------------------------------- */
+    /*      Sum the maximum output size of each chunk, as returned by the   */
+    /*      compressor.                                                     */
+    /* -------------------------------------------------------------------- */
+    if (output_data == nullptr)
+    {
+        std::vector<size_t> anChunkBound(nChunks, 0);
+        const bool bOK = CPLProcessChunks(
+            nChunks, CPLGetNumThreads(options),
+            [compressor, pabyInput, nChunkSize, options, &GetChunkSize,
+             &anChunkBound](size_t i)
+            {
+                return compressor->pfnFunc(
+                           pabyInput + i * nChunkSize, GetChunkSize(i),
+                           nullptr, &anChunkBound[i], options,
+                           compressor->user_data) &&
+                       anChunkBound[i] != 0;
+            });
+
+        *output_size = nHeaderSize;
+        for (size_t i = 0; bOK && i < nChunks; ++i)
+        {
+            if (anChunkBound[i] >
+                std::numeric_limits<size_t>::max() - *output_size)
+            {
+                *output_size = 0;
+                return false;
+            }
+            *output_size += anChunkBound[i];
+        }
+        if (!bOK)
+        {
+            // Unknown
+            *output_size = 0;
+        }
+        return true;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Compress each chunk in its own buffer.                          */
+    /* -------------------------------------------------------------------- */
+    std::vector<void *> apChunkData(nChunks, nullptr);
+    std::vector<size_t> anChunkCompressedSize(nChunks, 0);
+    const bool bOK = CPLProcessChunks(
+        nChunks, CPLGetNumThreads(options),
+        [compressor, pabyInput, nChunkSize, options, &GetChunkSize,
+         &apChunkData, &anChunkCompressedSize](size_t i)
+        {
+            return compressor->pfnFunc(
+                pabyInput + i * nChunkSize, GetChunkSize(i), &apChunkData[i],
+                &anChunkCompressedSize[i], options, compressor->user_data);
+        });
+
+    size_t nTotalSize = nHeaderSize;
+    for (size_t i = 0; bOK && i < nChunks; ++i)
+        nTotalSize += anChunkCompressedSize[i];
+
+    bool bRet = bOK;
+    if (!bOK)
+    {
+        *output_size = 0;
+    }
+    else if (*output_data != nullptr && *output_size < nTotalSize)
+    {
+        *output_size = nTotalSize;
+        bRet = false;
+    }
+    else
+    {
+        if (*output_data == nullptr)
+            *output_data = VSI_MALLOC_VERBOSE(nTotalSize);
+        bRet = *output_data != nullptr;
+        *output_size = bRet ? nTotalSize : 0;
+    }
+
+    if (bRet)
+    {
+        GByte *pabyOutput = static_cast<GByte *>(*output_data);
+        memcpy(pabyOutput, CHUNKED_SIGNATURE, CHUNKED_SIGNATURE_SIZE);
+        CPLWriteUInt64LE(pabyOutput + CHUNKED_SIGNATURE_SIZE, input_size);
+        CPLWriteUInt64LE(pabyOutput + CHUNKED_SIGNATURE_SIZE + 8, nChunkSize);
+        size_t nOffset = nHeaderSize;
+        for (size_t i = 0; i < nChunks; ++i)
+        {
+            CPLWriteUInt64LE(pabyOutput + CHUNKED_HEADER_SIZE + i * 8,
+                             anChunkCompressedSize[i]);
+            memcpy(pabyOutput + nOffset, apChunkData[i],
+                   anChunkCompressedSize[i]);
+            nOffset += anChunkCompressedSize[i];
+        }
+    }
+
+    for (void *pChunkData : apChunkData)
+        VSIFree(pChunkData);
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                       CPLDecompressChunked()                         */
+/************************************************************************/
+
+/** Decompress the output of CPLCompressChunked(), in parallel.
+ *
+ * The chunks are decompressed with the decompressor matching the
+ * compressor passed to CPLCompressChunked(), directly into the output
+ * buffer, using a thread pool.
+ *
+ * The NUM_THREADS option of CPLCompressChunked() is recognized, and the
+ * options are passed to the decompressor.
+ *
+ * The valid situations for output_data and output_size are the same as for
+ * a CPLCompressionFunc.
+ *
+ * @param decompressor Decompressor. Should NOT be NULL.
+ * @param input_data Input data. Should not be NULL.
+ * @param input_size Size of input data, in bytes.
+ * @param output_data Pointer to output data.
+ * @param output_size Pointer to output size.
+ * @param options NULL terminated list of options. Or NULL.
+ * @return true in case of success.
+ * @since GDAL 3.9
+ */
+bool CPLDecompressChunked(const CPLCompressor *decompressor,
+                          const void *input_data, size_t input_size,
+                          void **output_data, size_t *output_size,
+                          CSLConstList options)
+{
+    if (output_size == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid use of API");
+        return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read and validate the header.                                   */
+    /* -------------------------------------------------------------------- */
+    const GByte *pabyInput = static_cast<const GByte *>(input_data);
+    if (input_size < CHUNKED_HEADER_SIZE ||
+        memcmp(pabyInput, CHUNKED_SIGNATURE, CHUNKED_SIGNATURE_SIZE) != 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Not a chunked stream");
+        *output_size = 0;
+        return false;
+    }
+    const uint64_t nUncompressedSize =
+        CPLReadUInt64LE(pabyInput + CHUNKED_SIGNATURE_SIZE);
+    const uint64_t nChunkSize64 =
+        CPLReadUInt64LE(pabyInput + CHUNKED_SIGNATURE_SIZE + 8);
+    if (nChunkSize64 == 0 ||
+        nUncompressedSize > std::numeric_limits<size_t>::max() ||
+        nUncompressedSize / nChunkSize64 >
+            (input_size - CHUNKED_HEADER_SIZE) / sizeof(uint64_t))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid chunked stream header");
+        *output_size = 0;
+        return false;
+    }
+    const size_t nUncompressed = static_cast<size_t>(nUncompressedSize);
+    const size_t nChunkSize = static_cast<size_t>(
+        std::min<uint64_t>(nChunkSize64, std::max<uint64_t>(1, nUncompressed)));
+    const size_t nChunks = nUncompressed / nChunkSize +
+                           (nUncompressed % nChunkSize ? 1 : 0);
+    const size_t nHeaderSize = CHUNKED_HEADER_SIZE + nChunks * sizeof(uint64_t);
+    if (nHeaderSize > input_size)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Truncated chunked stream");
+        *output_size = 0;
+        return false;
+    }
+
+    std::vector<size_t> anChunkOffset(nChunks + 1);
+    anChunkOffset[0] = nHeaderSize;
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+        const uint64_t nCompressedSize =
+            CPLReadUInt64LE(pabyInput + CHUNKED_HEADER_SIZE + i * 8);
+        if (nCompressedSize == 0 ||
+            nCompressedSize > input_size - anChunkOffset[i])
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Truncated chunked stream");
+            *output_size = 0;
+            return false;
+        }
+        anChunkOffset[i + 1] =
+            anChunkOffset[i] + static_cast<size_t>(nCompressedSize);
+    }
+
+    if (output_data == nullptr)
+    {
+        *output_size = nUncompressed;
+        return true;
+    }
+
+    bool bAllocated = false;
+    if (*output_data == nullptr)
+    {
+        *output_data = VSI_MALLOC_VERBOSE(std::max<size_t>(1, nUncompressed));
+        if (*output_data == nullptr)
+        {
+            *output_size = 0;
+            return false;
+        }
+        bAllocated = true;
+    }
+    else if (*output_size < nUncompressed)
+    {
+        *output_size = nUncompressed;
+        return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Decompress each chunk at its place in the output.               */
+    /* -------------------------------------------------------------------- */
+    GByte *pabyOutput = static_cast<GByte *>(*output_data);
+    const bool bOK = CPLProcessChunks(
+        nChunks, CPLGetNumThreads(options),
+        [decompressor, pabyInput, pabyOutput, nUncompressed, nChunkSize,
+         options, &anChunkOffset](size_t i)
+        {
+            const size_t nExpectedSize =
+                std::min(nChunkSize, nUncompressed - i * nChunkSize);
+            void *pChunkOutput = pabyOutput + i * nChunkSize;
+            size_t nChunkOutputSize = nExpectedSize;
+            if (!decompressor->pfnFunc(
+                    pabyInput + anChunkOffset[i],
+                    anChunkOffset[i + 1] - anChunkOffset[i], &pChunkOutput,
+                    &nChunkOutputSize, options, decompressor->user_data) ||
+                nChunkOutputSize != nExpectedSize)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Decompression of chunk " CPL_FRMT_GUIB " failed",
+                         static_cast<GUIntBig>(i));
+                return false;
+            }
+            return true;
+        });
+
+    if (!bOK)
+    {
+        if (bAllocated)
+        {
+            VSIFree(*output_data);
+            *output_data = nullptr;
+        }
+        *output_size = 0;
+        return false;
+    }
+    *output_size = nUncompressed;
+    return true;
+}
+
 static void
 CPLDestroyCompressorRegistryInternal(std::vector<CPLCompressor *> *&v)
 {
@@ -119,6 +119,16 @@ const CPLCompressor CPL_DLL *CPLGetCompressor(const char *pszId);
 
 const CPLCompressor CPL_DLL *CPLGetDecompressor(const char *pszId);
 
+bool CPL_DLL CPLCompressChunked(const CPLCompressor *compressor,
+                                const void *input_data, size_t input_size,
+                                void **output_data, size_t *output_size,
+                                CSLConstList options);
+
+bool CPL_DLL CPLDecompressChunked(const CPLCompressor *decompressor,
+                                  const void *input_data, size_t input_size,
+                                  void **output_data, size_t *output_size,
+                                  CSLConstList options);
+
 /*! @cond Doxygen_Suppress */
 void CPL_DLL CPLDestroyCompressorRegistry(void);
 /*! @endcond */
@@ -58,6 +58,7 @@
 #include "cpl_conv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <climits>
@@ -76,10 +77,13 @@
 #include <xlocale.h>  // for LC_NUMERIC_MASK on MacOS
 #endif
 
+#include <memory>
+#include <new>
 #ifdef DEBUG_CONFIG_OPTIONS
 #include <set>
 #endif
 #include <string>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_multiproc.h"
@@ -101,6 +105,8 @@ void OGRAPISPYCPLSetThreadLocalConfigOption(const char *, const char *);
 
 static CPLMutex *hConfigMutex = nullptr;
 static volatile char **g_papszConfigOptions = nullptr;
+// Incremented each time g_papszConfigOptions is modified.
+static std::atomic<unsigned> g_nConfigOptionsGeneration{1};
 static bool gbIgnoreEnvVariables =
     false;  // if true, only take into account configuration options set through
             // configuration file or
@@ -1765,6 +1771,7 @@ void CPLSetConfigOptions(const char *const *papszConfigOptions)
     CSLDestroy(const_cast<char **>(g_papszConfigOptions));
     g_papszConfigOptions = const_cast<volatile char **>(
         CSLDuplicate(const_cast<char **>(papszConfigOptions)));
+    g_nConfigOptionsGeneration++;
 }
 
 /************************************************************************/
@@ -1795,6 +1802,102 @@ const char *CPL_STDCALL CPLGetThreadLocalConfigOption(const char *pszKey,
     return pszResult;
 }
 
+/************************************************************************/
+/*                        CPLConfigOptionCache                          */
+/************************************************************************/
+
+namespace
+{
+// Per-thread cache of lookups in g_papszConfigOptions, so that reading an
+// option does not take hConfigMutex. An entry is valid while
+// g_nConfigOptionsGeneration keeps the value it had when the entry was
+// filled. Entries point to the strings of g_papszConfigOptions, so that
+// returned pointers remain valid until the option is set again, as without
+// the cache, and not only during the life of the calling thread.
+// As any key may be queried, the table is emptied once it holds
+// MAX_ENTRIES entries.
+class CPLConfigOptionCache
+{
+  public:
+    struct Entry
+    {
+        std::string osKey{};
+        const char *pszValue = nullptr;
+        unsigned nGeneration = 0;
+    };
+
+    Entry &Get(const char *pszKey);
+
+  private:
+    static constexpr size_t MAX_ENTRIES = 512;
+
+    // Open addressing table, whose size is a power of two.
+    std::vector<Entry> m_aoEntries{};
+    size_t m_nCount = 0;
+
+    static size_t Hash(const char *pszKey);
+    Entry &Find(const char *pszKey);
+};
+
+// Case insensitive FNV-1a hash, as keys are compared with EQUAL().
+size_t CPLConfigOptionCache::Hash(const char *pszKey)
+{
+    size_t nHash = 2166136261U;
+    for (; *pszKey; ++pszKey)
+    {
+        nHash ^= static_cast<unsigned char>(
+            toupper(static_cast<unsigned char>(*pszKey)));
+        nHash *= 16777619U;
+    }
+    return nHash;
+}
+
+// Returns the entry of pszKey, or the empty slot where to insert it.
+CPLConfigOptionCache::Entry &CPLConfigOptionCache::Find(const char *pszKey)
+{
+    const size_t nMask = m_aoEntries.size() - 1;
+    size_t i = Hash(pszKey) & nMask;
+    while (!m_aoEntries[i].osKey.empty() &&
+           !EQUAL(m_aoEntries[i].osKey.c_str(), pszKey))
+    {
+        i = (i + 1) & nMask;
+    }
+    return m_aoEntries[i];
+}
+
+CPLConfigOptionCache::Entry &CPLConfigOptionCache::Get(const char *pszKey)
+{
+    if (m_nCount >= MAX_ENTRIES)
+    {
+        m_aoEntries.clear();
+        m_nCount = 0;
+    }
+    if ((m_nCount + 1) * 2 > m_aoEntries.size())
+    {
+        std::vector<Entry> aoOldEntries(std::move(m_aoEntries));
+        m_aoEntries.clear();
+        m_aoEntries.resize(std::max<size_t>(64, aoOldEntries.size() * 2));
+        for (auto &oEntry : aoOldEntries)
+        {
+            if (!oEntry.osKey.empty())
+                Find(oEntry.osKey.c_str()) = std::move(oEntry);
+        }
+    }
+    Entry &oEntry = Find(pszKey);
+    if (oEntry.osKey.empty())
+    {
+        oEntry.osKey = pszKey;
+        ++m_nCount;
+    }
+    return oEntry;
+}
+
+void CPLConfigOptionCacheFreeFunc(void *pData)
+{
+    delete static_cast<CPLConfigOptionCache *>(pData);
+}
+}  // namespace
+
 /************************************************************************/
 /*                   CPLGetGlobalConfigOption()                         */
 /************************************************************************/
@@ -1811,15 +1914,39 @@ const char *CPL_STDCALL CPLGetGlobalConfigOption(const char *pszKey,
     CPLAccessConfigOption(pszKey, TRUE);
 #endif
 
-    CPLMutexHolderD(&hConfigMutex);
+    int bMemoryError = FALSE;
+    auto poCache = static_cast<CPLConfigOptionCache *>(
+        CPLGetTLSEx(CTLS_CONFIGOPTIONSCACHE, &bMemoryError));
+    // Empty keys would be confused with free slots of the cache.
+    if (poCache == nullptr && !bMemoryError && pszKey[0] != '\0')
+    {
+        poCache = new (std::nothrow) CPLConfigOptionCache();
+        if (poCache)
+            CPLSetTLSWithFreeFunc(CTLS_CONFIGOPTIONSCACHE, poCache,
+                                  CPLConfigOptionCacheFreeFunc);
+    }
+    if (poCache == nullptr || pszKey[0] == '\0')
+    {
+        CPLMutexHolderD(&hConfigMutex);
+        const char *pszResult = CSLFetchNameValue(
+            const_cast<char **>(g_papszConfigOptions), pszKey);
+        return pszResult ? pszResult : pszDefault;
+    }
 
-    const char *pszResult =
-        CSLFetchNameValue(const_cast<char **>(g_papszConfigOptions), pszKey);
+    auto &oEntry = poCache->Get(pszKey);
+    if (oEntry.nGeneration !=
+        g_nConfigOptionsGeneration.load(std::memory_order_acquire))
+    {
+        CPLMutexHolderD(&hConfigMutex);
+        oEntry.pszValue = CSLFetchNameValue(
+            const_cast<char **>(g_papszConfigOptions), pszKey);
+        oEntry.nGeneration = g_nConfigOptionsGeneration;
+    }
 
-    if (pszResult == nullptr)
+    if (oEntry.pszValue == nullptr)
         return pszDefault;
 
-    return pszResult;
+    return oEntry.pszValue;
 }
 
 /************************************************************************/
@@ -1949,6 +2076,7 @@ void CPL_STDCALL CPLSetConfigOption(const char *pszKey, const char *pszValue)
 
     g_papszConfigOptions = const_cast<volatile char **>(CSLSetNameValue(
         const_cast<char **>(g_papszConfigOptions), pszKey, pszValue));
+    g_nConfigOptionsGeneration++;
 
     NotifyOtherComponentsConfigOptionChanged(pszKey, pszValue,
                                              /*bTheadLocal=*/false);
@@ -2086,6 +2214,7 @@ void CPL_STDCALL CPLFreeConfig()
 
         CSLDestroy(const_cast<char **>(g_papszConfigOptions));
         g_papszConfigOptions = nullptr;
+        g_nConfigOptionsGeneration++;
 
         int bMemoryError = FALSE;
         char **papszTLConfigOptions = reinterpret_cast<char **>(
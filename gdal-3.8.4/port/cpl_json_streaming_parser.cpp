@@ -32,6 +32,7 @@
 #include <ctype.h>   // isdigit...
 #include <stdio.h>   // snprintf
 #include <string.h>  // strlen
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -39,6 +40,17 @@
 #include "cpl_string.h"
 #include "cpl_json_streaming_parser.h"
 
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2
+#endif
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 /************************************************************************/
 /*                       CPLJSonStreamingParser()                       */
 /************************************************************************/
@@ -117,15 +129,135 @@ void CPLJSonStreamingParser::AdvanceChar(const char *&pStr, size_t &nLength)
     m_nCharCounter++;
 }
 
+/************************************************************************/
+/*                             AdvanceSpan()                            */
+/************************************************************************/
+
+// Equivalent to calling AdvanceChar() nCount times, provided that the
+// skipped characters contain no end-of-line character.
+void CPLJSonStreamingParser::AdvanceSpan(const char *&pStr, size_t &nLength,
+                                         size_t nCount)
+{
+    m_nLastChar = pStr[nCount - 1];
+    m_nCharCounter += static_cast<int>(nCount);
+    pStr += nCount;
+    nLength -= nCount;
+}
+
+#ifdef USE_SSE2
+
+/************************************************************************/
+/*                          GetFirstBitSet()                            */
+/************************************************************************/
+
+static inline int GetFirstBitSet(int nMask)
+{
+#ifdef _MSC_VER
+    unsigned long nIdx;
+    _BitScanForward(&nIdx, static_cast<unsigned long>(nMask));
+    return static_cast<int>(nIdx);
+#else
+    return __builtin_ctz(static_cast<unsigned>(nMask));
+#endif
+}
+
+#endif
+
+/************************************************************************/
+/*                           CountBlanks()                              */
+/************************************************************************/
+
+// Returns the number of leading space and tabulation characters of pStr.
+static size_t CountBlanks(const char *pStr, size_t nLength)
+{
+    size_t i = 0;
+#ifdef USE_SSE2
+    const __m128i xmmSpace = _mm_set1_epi8(' ');
+    const __m128i xmmTab = _mm_set1_epi8('\t');
+    for (; i + 16 <= nLength; i += 16)
+    {
+        const __m128i xmmVal =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pStr + i));
+        const int nMask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(xmmVal, xmmSpace),
+                         _mm_cmpeq_epi8(xmmVal, xmmTab)));
+        if (nMask != 0xFFFF)
+            return i + GetFirstBitSet(~nMask);
+    }
+#endif
+    while (i < nLength && (pStr[i] == ' ' || pStr[i] == '\t'))
+        ++i;
+    return i;
+}
+
+/************************************************************************/
+/*                         CountStringChars()                           */
+/************************************************************************/
+
+// Returns the number of leading characters of pStr that can be copied as
+// they are in a string token, that is until the first double quote,
+// backslash or end-of-line character.
+static size_t CountStringChars(const char *pStr, size_t nLength)
+{
+    size_t i = 0;
+#ifdef USE_SSE2
+    const __m128i xmmQuote = _mm_set1_epi8('"');
+    const __m128i xmmBackslash = _mm_set1_epi8('\\');
+    const __m128i xmmCR = _mm_set1_epi8('\r');
+    const __m128i xmmLF = _mm_set1_epi8('\n');
+    for (; i + 16 <= nLength; i += 16)
+    {
+        const __m128i xmmVal =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pStr + i));
+        const int nMask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(xmmVal, xmmQuote),
+                                      _mm_cmpeq_epi8(xmmVal, xmmBackslash)),
+                         _mm_or_si128(_mm_cmpeq_epi8(xmmVal, xmmCR),
+                                      _mm_cmpeq_epi8(xmmVal, xmmLF))));
+        if (nMask != 0)
+            return i + GetFirstBitSet(nMask);
+    }
+#endif
+    for (; i < nLength; ++i)
+    {
+        const char ch = pStr[i];
+        if (ch == '"' || ch == '\\' || ch == '\r' || ch == '\n')
+            break;
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                            IsNumberChar()                            */
+/************************************************************************/
+
+static inline bool IsNumberChar(char ch)
+{
+    return (ch >= '0' && ch <= '9') || ch == '.' || ch == '-' || ch == '+' ||
+           ch == 'e' || ch == 'E';
+}
+
 /************************************************************************/
 /*                               SkipSpace()                            */
 /************************************************************************/
 
 void CPLJSonStreamingParser::SkipSpace(const char *&pStr, size_t &nLength)
 {
-    while (nLength > 0 && isspace(*pStr))
+    while (nLength > 0)
     {
-        AdvanceChar(pStr, nLength);
+        if (*pStr == ' ' || *pStr == '\t')
+        {
+            // Indentation of pretty-printed documents
+            AdvanceSpan(pStr, nLength, CountBlanks(pStr, nLength));
+        }
+        else if (isspace(*pStr))
+        {
+            AdvanceChar(pStr, nLength);
+        }
+        else
+        {
+            break;
+        }
     }
 }
 
@@ -456,6 +588,21 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
         {
             while (nLength)
             {
+                // Copy all the number characters at once, up to the maximum
+                // token size (exceeding it is dealt with just below)
+                size_t nCount = 0;
+                const size_t nMaxCount =
+                    std::min(nLength, 1024 - m_osToken.size());
+                while (nCount < nMaxCount && IsNumberChar(pStr[nCount]))
+                    ++nCount;
+                if (nCount)
+                {
+                    m_osToken.append(pStr, nCount);
+                    AdvanceSpan(pStr, nLength, nCount);
+                    if (nLength == 0)
+                        break;
+                }
+
                 char ch = *pStr;
                 if (ch == '+' || ch == '-' || isdigit(ch) || ch == '.' ||
                     ch == 'e' || ch == 'E')
@@ -546,6 +693,21 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
                     return EmitException("Too many characters in number");
                 }
 
+                if (!m_bInUnicode && !m_bInStringEscape)
+                {
+                    // Copy all the characters up to the next special one
+                    // at once
+                    const size_t nCount = CountStringChars(
+                        pStr,
+                        std::min(nLength, m_nMaxStringSize - m_osToken.size()));
+                    if (nCount)
+                    {
+                        m_osToken.append(pStr, nCount);
+                        AdvanceSpan(pStr, nLength, nCount);
+                        continue;
+                    }
+                }
+
                 char ch = *pStr;
                 if (m_bInUnicode)
                 {
@@ -903,10 +1065,34 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
 
 std::string CPLJSonStreamingParser::GetSerializedString(const char *pszStr)
 {
-    std::string osStr("\"");
-    for (int i = 0; pszStr[i]; i++)
+    std::string osStr;
+    AppendSerializedString(osStr, pszStr);
+    return osStr;
+}
+
+/************************************************************************/
+/*                      AppendSerializedString()                        */
+/************************************************************************/
+
+void CPLJSonStreamingParser::AppendSerializedString(std::string &osStr,
+                                                    const char *pszStr)
+{
+    osStr += '"';
+    while (true)
     {
-        char ch = pszStr[i];
+        // Copy characters that need no escaping at once
+        size_t nCount = 0;
+        while (static_cast<unsigned char>(pszStr[nCount]) >= ' ' &&
+               pszStr[nCount] != '"' && pszStr[nCount] != '\\')
+        {
+            ++nCount;
+        }
+        osStr.append(pszStr, nCount);
+        pszStr += nCount;
+
+        const char ch = *pszStr;
+        if (ch == '\0')
+            break;
         if (ch == '\b')
             osStr += "\\b";
         else if (ch == '\f')
@@ -921,13 +1107,11 @@ std::string CPLJSonStreamingParser::GetSerializedString(const char *pszStr)
             osStr += "\\\"";
         else if (ch == '\\')
             osStr += "\\\\";
-        else if (static_cast<unsigned char>(ch) < ' ')
-            osStr += CPLSPrintf("\\u%04X", ch);
         else
-            osStr += ch;
+            osStr += CPLSPrintf("\\u%04X", ch);
+        ++pszStr;
     }
-    osStr += "\"";
-    return osStr;
+    osStr += '"';
 }
 
 /*! @endcond */
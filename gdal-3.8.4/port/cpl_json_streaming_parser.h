@@ -88,6 +88,7 @@ class CPL_DLL CPLJSonStreamingParser
     }
     void SkipSpace(const char *&pStr, size_t &nLength);
     void AdvanceChar(const char *&pStr, size_t &nLength);
+    void AdvanceSpan(const char *&pStr, size_t &nLength, size_t nCount);
     bool EmitUnexpectedChar(char ch, const char *pszExpecting = nullptr);
     bool StartNewToken(const char *&pStr, size_t &nLength);
     bool CheckAndEmitTrueFalseOrNull(char ch);
@@ -109,6 +110,7 @@ class CPL_DLL CPLJSonStreamingParser
     }
 
     static std::string GetSerializedString(const char *pszStr);
+    static void AppendSerializedString(std::string &osStr, const char *pszStr);
 
     virtual void Reset();
     virtual bool Parse(const char *pStr, size_t nLength, bool bFinished);
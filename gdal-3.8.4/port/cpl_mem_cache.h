@@ -33,9 +33,12 @@
 
 #pragma once
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <stdexcept>
 #include <thread>
 #include <unordered_map>
@@ -310,6 +313,411 @@ class Cache
     size_t elasticity_;
 };
 
+/**
+ * default weigher of ShardedCache: all entries weigh nothing, so that only
+ * the number of entries is bounded
+ */
+struct NullWeigher
+{
+    template <class K, class V>
+    size_t operator()(const K &, const V &) const
+    {
+        return 0;
+    }
+};
+
+/**
+ * hit/miss statistics of a ShardedCache
+ */
+struct CacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/**
+ *	A thread-safe LRU cache, templated by
+ *		Key - key type
+ *		Value - value type
+ *		Hash - hash functor of Key
+ *		Weigher - functor returning the weight (typically the size in
+ *bytes) of a (key, value) pair. Defaults to NullWeigher
+ *
+ *	Entries are spread among independent shards, each protected by its own
+ *mutex and having its own LRU list, so that concurrent threads accessing
+ *different keys seldom contend. The maxSize, elasticity and maxWeight limits
+ *are split evenly among the shards, so eviction is only approximately LRU
+ *at the scale of the whole cache.
+ *
+ *	Contrary to Cache, no method returns a reference or a pointer into the
+ *cache, as it could be invalidated by another thread. Values are copied or
+ *moved out instead.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>,
+          class Weigher = NullWeigher>
+class ShardedCache
+{
+  public:
+    typedef KeyValuePair<Key, Value> node_type;
+    typedef std::list<node_type> list_type;
+
+    /**
+     * maxSize and elasticity have the same meaning as in Cache.
+     * maxWeight is the maximum total weight of the entries, as computed by
+     * Weigher, or 0 for no limit on the weight.
+     * nShards is rounded down to a power of two, and reduced so that each
+     * shard can hold at least 8 entries.
+     */
+    explicit ShardedCache(size_t maxSize = 64, size_t elasticity = 10,
+                          size_t maxWeight = 0, size_t nShards = 16)
+        : maxSize_(maxSize), elasticity_(elasticity), maxWeight_(maxWeight)
+    {
+        nShards = std::max<size_t>(1, nShards);
+        while ((nShards & (nShards - 1)) != 0)
+            nShards &= nShards - 1;
+        while (nShards > 1 && maxSize != 0 && maxSize / nShards < 8)
+            nShards /= 2;
+        nShards_ = nShards;
+        while ((static_cast<size_t>(1) << shardShift_) < nShards_)
+            ++shardShift_;
+        size_t space = nShards_ * sizeof(Shard) + alignof(Shard);
+        shardsStorage_.reset(new unsigned char[space]);
+        void *ptr = shardsStorage_.get();
+        shards_ = static_cast<Shard *>(
+            std::align(alignof(Shard), nShards_ * sizeof(Shard), ptr, space));
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            new (shards_ + i) Shard();
+            shards_[i].maxSize = (maxSize + nShards_ - 1) / nShards_;
+            shards_[i].elasticity = (elasticity + nShards_ - 1) / nShards_;
+            shards_[i].maxWeight = (maxWeight + nShards_ - 1) / nShards_;
+        }
+    }
+
+    ~ShardedCache()
+    {
+        for (size_t i = 0; i < nShards_; ++i)
+            shards_[i].~Shard();
+    }
+
+    size_t size() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+    bool empty() const
+    {
+        return size() == 0;
+    }
+    size_t getWeight() const
+    {
+        size_t weight = 0;
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            Guard g(shards_[i].lock);
+            weight += shards_[i].weight;
+        }
+        return weight;
+    }
+    void clear()
+    {
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            Shard &shard = shards_[i];
+            list_type keys;
+            {
+                Guard g(shard.lock);
+                count_ -= shard.cache.size();
+                shard.cache.clear();
+                keys.swap(shard.keys);
+                shard.weight = 0;
+            }
+            // values are destroyed outside of the lock
+        }
+    }
+    void insert(const Key &k, const Value &v)
+    {
+        Value copy(v);
+        insert(k, std::move(copy));
+    }
+    void insert(const Key &k, Value &&v)
+    {
+        list_type evicted;
+        Shard &shard = getShard(k);
+        Guard g(shard.lock);
+        const auto iter = shard.cache.find(k);
+        if (iter != shard.cache.end())
+        {
+            shard.weight -= iter->second.weight;
+            iter->second.weight = weigher_(k, v);
+            shard.weight += iter->second.weight;
+            iter->second.it->value = std::move(v);
+            shard.keys.splice(shard.keys.begin(), shard.keys, iter->second.it);
+        }
+        else
+        {
+            add(shard, k, std::move(v));
+        }
+        prune(shard, evicted);
+    }
+    /**
+     * inserts the value only if the key is not already in the cache.
+     * returns false (and leaves v untouched) otherwise
+     */
+    bool insertIfAbsent(const Key &k, Value &&v)
+    {
+        list_type evicted;
+        Shard &shard = getShard(k);
+        Guard g(shard.lock);
+        if (shard.cache.find(k) != shard.cache.end())
+            return false;
+        add(shard, k, std::move(v));
+        prune(shard, evicted);
+        return true;
+    }
+    bool tryGet(const Key &kIn, Value &vOut)
+    {
+        Shard &shard = getShard(kIn);
+        Guard g(shard.lock);
+        const auto iter = shard.cache.find(kIn);
+        if (iter == shard.cache.end())
+        {
+            ++shard.stats.misses;
+            return false;
+        }
+        ++shard.stats.hits;
+        shard.keys.splice(shard.keys.begin(), shard.keys, iter->second.it);
+        vOut = iter->second.it->value;
+        return true;
+    }
+    /**
+     * removes the entry of the key from the cache and moves its value to
+     * vOut, if found
+     */
+    bool tryTake(const Key &kIn, Value &vOut)
+    {
+        list_type removed;
+        Shard &shard = getShard(kIn);
+        Guard g(shard.lock);
+        const auto iter = shard.cache.find(kIn);
+        if (iter == shard.cache.end())
+        {
+            ++shard.stats.misses;
+            return false;
+        }
+        ++shard.stats.hits;
+        vOut = std::move(iter->second.it->value);
+        erase(shard, iter, removed);
+        return true;
+    }
+    /**
+     * returns a copy of the stored object (if found)
+     */
+    Value getCopy(const Key &k)
+    {
+        Value v;
+        if (!tryGet(k, v))
+            throw KeyNotFound();
+        return v;
+    }
+    bool remove(const Key &k)
+    {
+        list_type removed;
+        Shard &shard = getShard(k);
+        Guard g(shard.lock);
+        const auto iter = shard.cache.find(k);
+        if (iter == shard.cache.end())
+        {
+            return false;
+        }
+        erase(shard, iter, removed);
+        return true;
+    }
+    /**
+     * removes all entries for which pred(const node_type&) returns true.
+     * returns the number of removed entries
+     */
+    template <typename F> size_t removeIf(F pred)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            Shard &shard = shards_[i];
+            list_type removed;
+            Guard g(shard.lock);
+            for (auto it = shard.keys.begin(); it != shard.keys.end();)
+            {
+                auto next = std::next(it);
+                if (pred(static_cast<const node_type &>(*it)))
+                {
+                    erase(shard, shard.cache.find(it->key), removed);
+                    ++count;
+                }
+                it = next;
+            }
+        }
+        return count;
+    }
+    bool contains(const Key &k) const
+    {
+        const Shard &shard = getShard(k);
+        Guard g(shard.lock);
+        return shard.cache.find(k) != shard.cache.end();
+    }
+
+    size_t getMaxSize() const
+    {
+        return maxSize_;
+    }
+    size_t getElasticity() const
+    {
+        return elasticity_;
+    }
+    size_t getMaxWeight() const
+    {
+        return maxWeight_;
+    }
+    size_t getShardCount() const
+    {
+        return nShards_;
+    }
+    /**
+     * walks over all entries, shard by shard. Each shard is locked while it
+     * is walked, so f must not call back into the cache
+     */
+    template <typename F> void cwalk(F &f) const
+    {
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            Guard g(shards_[i].lock);
+            std::for_each(shards_[i].keys.begin(), shards_[i].keys.end(), f);
+        }
+    }
+
+    CacheStats getStats() const
+    {
+        CacheStats stats;
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            Guard g(shards_[i].lock);
+            stats.hits += shards_[i].stats.hits;
+            stats.misses += shards_[i].stats.misses;
+            stats.evictions += shards_[i].stats.evictions;
+        }
+        return stats;
+    }
+    void resetStats()
+    {
+        for (size_t i = 0; i < nShards_; ++i)
+        {
+            Guard g(shards_[i].lock);
+            shards_[i].stats = CacheStats();
+        }
+    }
+
+  private:
+    // Disallow copying.
+    ShardedCache(const ShardedCache &) = delete;
+    ShardedCache &operator=(const ShardedCache &) = delete;
+
+    using Guard = std::lock_guard<std::mutex>;
+
+    struct Slot
+    {
+        typename list_type::iterator it{};
+        size_t weight = 0;
+    };
+    typedef std::unordered_map<Key, Slot, Hash> map_type;
+
+    // Aligned on cache lines, so that consecutive shards do not share one
+    struct alignas(64) Shard
+    {
+        mutable std::mutex lock{};
+        map_type cache{};
+        list_type keys{};
+        size_t weight = 0;
+        size_t maxSize = 0;
+        size_t elasticity = 0;
+        size_t maxWeight = 0;
+        CacheStats stats{};
+    };
+
+    Shard &getShard(const Key &k)
+    {
+        return shards_[getShardIdx(k)];
+    }
+    const Shard &getShard(const Key &k) const
+    {
+        return shards_[getShardIdx(k)];
+    }
+    size_t getShardIdx(const Key &k) const
+    {
+        if (shardShift_ == 0)
+            return 0;
+        // Fibonacci hashing: use the high bits of the product, so that
+        // hashes differing only by their high or low bits are spread as well.
+        const uint64_t h =
+            static_cast<uint64_t>(hash_(k)) * UINT64_C(0x9E3779B97F4A7C15);
+        return static_cast<size_t>(h >> (64 - shardShift_));
+    }
+
+    void add(Shard &shard, const Key &k, Value &&v)
+    {
+        const size_t weight = weigher_(k, v);
+        shard.keys.emplace_front(k, std::move(v));
+        Slot slot;
+        slot.it = shard.keys.begin();
+        slot.weight = weight;
+        shard.cache.emplace(k, slot);
+        shard.weight += weight;
+        ++count_;
+    }
+
+    // Erased nodes are moved to the out list, so that the values are
+    // destroyed after the shard lock is released.
+    void erase(Shard &shard, typename map_type::iterator iter, list_type &out)
+    {
+        shard.weight -= iter->second.weight;
+        out.splice(out.end(), shard.keys, iter->second.it);
+        shard.cache.erase(iter);
+        --count_;
+    }
+
+    void prune(Shard &shard, list_type &out)
+    {
+        if (shard.maxSize != 0 &&
+            shard.cache.size() > shard.maxSize + shard.elasticity)
+        {
+            while (shard.cache.size() > shard.maxSize)
+            {
+                erase(shard, shard.cache.find(shard.keys.back().key), out);
+                ++shard.stats.evictions;
+            }
+        }
+        // The most recently used entry is always kept, even if it weighs
+        // more than the budget of the shard on its own.
+        while (shard.maxWeight != 0 && shard.weight > shard.maxWeight &&
+               shard.cache.size() > 1)
+        {
+            erase(shard, shard.cache.find(shard.keys.back().key), out);
+            ++shard.stats.evictions;
+        }
+    }
+
+    const size_t maxSize_;
+    const size_t elasticity_;
+    const size_t maxWeight_;
+    size_t nShards_ = 1;
+    unsigned shardShift_ = 0;
+    // operator new does not honour the alignment of Shard before C++17,
+    // so shards are constructed in manually aligned storage.
+    std::unique_ptr<unsigned char[]> shardsStorage_{};
+    Shard *shards_ = nullptr;
+    std::atomic<size_t> count_{0};
+    Hash hash_{};
+    Weigher weigher_{};
+};
+
 }  // namespace lru11
 
 /*! @endcond */
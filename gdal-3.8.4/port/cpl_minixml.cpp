@@ -73,6 +73,85 @@ typedef struct
     CPLXMLNode *psLastChild;
 } StackContext;
 
+/************************************************************************/
+/*                             CPLXMLArena                              */
+/************************************************************************/
+
+// Nodes, and their values, of the trees parsed by CPLXMLArenaTree are
+// carved from large blocks, instead of two heap allocations per node.
+struct CPLXMLArena
+{
+    // Each block starts with a pointer to the previously allocated one.
+    void *pLastBlock = nullptr;
+    char *pabyCur = nullptr;
+    size_t nRemaining = 0;
+
+    static constexpr size_t BLOCK_HEADER_SIZE = 16;
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    CPLXMLArena() = default;
+    ~CPLXMLArena();
+
+    // nAlignment must be a power of two.
+    void *Alloc(size_t nSize, size_t nAlignment)
+    {
+        const size_t nPadding =
+            (0 - reinterpret_cast<GUIntptr_t>(pabyCur)) & (nAlignment - 1);
+        if (pabyCur == nullptr || nPadding + nSize > nRemaining)
+            return AllocFromNewBlock(nSize);
+
+        void *pRet = pabyCur + nPadding;
+        pabyCur += nPadding + nSize;
+        nRemaining -= nPadding + nSize;
+        return pRet;
+    }
+
+  private:
+    void *AllocFromNewBlock(size_t nSize);
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLXMLArena)
+};
+
+constexpr size_t CPLXMLArena::BLOCK_HEADER_SIZE;
+constexpr size_t CPLXMLArena::BLOCK_SIZE;
+
+CPLXMLArena::~CPLXMLArena()
+{
+    while (pLastBlock != nullptr)
+    {
+        void *pPreviousBlock = nullptr;
+        memcpy(&pPreviousBlock, pLastBlock, sizeof(void *));
+        VSIFree(pLastBlock);
+        pLastBlock = pPreviousBlock;
+    }
+}
+
+void *CPLXMLArena::AllocFromNewBlock(size_t nSize)
+{
+    // Large values get a block of their own, so as to not waste the
+    // remaining of the current block.
+    const bool bDedicatedBlock = nSize > BLOCK_SIZE / 4;
+    const size_t nBlockSize =
+        BLOCK_HEADER_SIZE + (bDedicatedBlock ? nSize : BLOCK_SIZE);
+    char *pabyBlock = static_cast<char *>(VSIMalloc(nBlockSize));
+    if (pabyBlock == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate " CPL_FRMT_GUIB " bytes",
+                 static_cast<GUIntBig>(nBlockSize));
+        return nullptr;
+    }
+    memcpy(pabyBlock, &pLastBlock, sizeof(void *));
+    pLastBlock = pabyBlock;
+    if (bDedicatedBlock)
+        return pabyBlock + BLOCK_HEADER_SIZE;
+
+    // The block header keeps the alignment of the block start.
+    pabyCur = pabyBlock + BLOCK_HEADER_SIZE + nSize;
+    nRemaining = BLOCK_SIZE - nSize;
+    return pabyBlock + BLOCK_HEADER_SIZE;
+}
+
 typedef struct
 {
     const char *pszInput;
@@ -90,6 +169,8 @@ typedef struct
 
     CPLXMLNode *psFirstNode;
     CPLXMLNode *psLastNode;
+
+    CPLXMLArena *poArena;
 } ParseContext;
 
 static CPLXMLNode *_CPLCreateXMLNode(CPLXMLNode *poParent, CPLXMLNodeType eType,
@@ -112,24 +193,6 @@ static CPL_INLINE char ReadChar(ParseContext *psContext)
     return chReturn;
 }
 
-/************************************************************************/
-/*                             UnreadChar()                             */
-/************************************************************************/
-
-static CPL_INLINE void UnreadChar(ParseContext *psContext, char chToUnread)
-
-{
-    if (chToUnread == '\0')
-        return;
-
-    CPLAssert(chToUnread == psContext->pszInput[psContext->nInputOffset - 1]);
-
-    psContext->nInputOffset--;
-
-    if (chToUnread == 10)
-        psContext->nInputLine--;
-}
-
 /************************************************************************/
 /*                           ReallocToken()                             */
 /************************************************************************/
@@ -185,6 +248,89 @@ static CPL_INLINE bool _AddToToken(ParseContext *psContext, char chNewChar)
     if (!_AddToToken(psContext, chNewChar))                                    \
         goto fail;
 
+/************************************************************************/
+/*                             SkipInput()                              */
+/*                                                                      */
+/*      Skip the next nLen characters of the input, which must not      */
+/*      contain the nul terminator, while keeping the line count.       */
+/************************************************************************/
+
+static CPL_INLINE void SkipInput(ParseContext *psContext, size_t nLen)
+
+{
+    const char *pszIter = psContext->pszInput + psContext->nInputOffset;
+    for (size_t i = 0; i < nLen; ++i)
+    {
+        if (pszIter[i] == 10)
+            psContext->nInputLine++;
+    }
+    psContext->nInputOffset += static_cast<int>(nLen);
+}
+
+/************************************************************************/
+/*                           AddSpanToToken()                           */
+/*                                                                      */
+/*      Same as ReadChar() + AddToToken() for the next nLen characters  */
+/*      of the input, but appending them at once.                       */
+/************************************************************************/
+
+static bool AddSpanToToken(ParseContext *psContext, size_t nLen)
+
+{
+    while (psContext->nTokenSize + nLen + 2 > psContext->nTokenMaxSize)
+    {
+        if (!ReallocToken(psContext))
+            return false;
+    }
+
+    memcpy(psContext->pszToken + psContext->nTokenSize,
+           psContext->pszInput + psContext->nInputOffset, nLen);
+    psContext->nTokenSize += nLen;
+    psContext->pszToken[psContext->nTokenSize] = '\0';
+    SkipInput(psContext, nLen);
+    return true;
+}
+
+/************************************************************************/
+/*                         AddSpanUntilToken()                          */
+/*                                                                      */
+/*      Add the input up to the pszDelimiter string, or to the end of   */
+/*      the input if it is not found, and skip the delimiter.           */
+/************************************************************************/
+
+static bool AddSpanUntilToken(ParseContext *psContext,
+                              const char *pszDelimiter)
+
+{
+    const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+    const char *pszFound = strstr(pszStart, pszDelimiter);
+    if (!AddSpanToToken(psContext, pszFound ? pszFound - pszStart
+                                            : strlen(pszStart)))
+        return false;
+    if (pszFound)
+        SkipInput(psContext, strlen(pszDelimiter));
+    return true;
+}
+
+/************************************************************************/
+/*                           UnescapeToken()                            */
+/************************************************************************/
+
+static void UnescapeToken(ParseContext *psContext)
+
+{
+    // Do we need to unescape it?
+    if (memchr(psContext->pszToken, '&', psContext->nTokenSize) != nullptr)
+    {
+        int nLength = 0;
+        char *pszUnescaped =
+            CPLUnescapeString(psContext->pszToken, &nLength, CPLES_XML);
+        strcpy(psContext->pszToken, pszUnescaped);
+        CPLFree(pszUnescaped);
+        psContext->nTokenSize = strlen(psContext->pszToken);
+    }
+}
+
 /************************************************************************/
 /*                             ReadToken()                              */
 /************************************************************************/
@@ -195,37 +341,37 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
     psContext->nTokenSize = 0;
     psContext->pszToken[0] = '\0';
 
+    const char *pszSpace = psContext->pszInput + psContext->nInputOffset;
+    const char *pszSpaceEnd = pszSpace;
+    while (isspace(static_cast<unsigned char>(*pszSpaceEnd)))
+        pszSpaceEnd++;
+    SkipInput(psContext, pszSpaceEnd - pszSpace);
+
     char chNext = ReadChar(psContext);
-    while (isspace(static_cast<unsigned char>(chNext)))
-        chNext = ReadChar(psContext);
+
+    // Only check for the <!...> constructs below when they may be present.
+    const bool bExclamationMark =
+        chNext == '<' && psContext->pszInput[psContext->nInputOffset] == '!';
 
     /* -------------------------------------------------------------------- */
     /*      Handle comments.                                                */
     /* -------------------------------------------------------------------- */
-    if (chNext == '<' &&
+    if (bExclamationMark &&
         STARTS_WITH_CI(psContext->pszInput + psContext->nInputOffset, "!--"))
     {
         psContext->eTokenType = TComment;
 
         // Skip "!--" characters.
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
+        SkipInput(psContext, 3);
 
-        while (!STARTS_WITH_CI(psContext->pszInput + psContext->nInputOffset,
-                               "-->") &&
-               (chNext = ReadChar(psContext)) != '\0')
-            AddToToken(psContext, chNext);
-
-        // Skip "-->" characters.
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
+        // Collect up to and skip "-->" characters.
+        if (!AddSpanUntilToken(psContext, "-->"))
+            goto fail;
     }
     /* -------------------------------------------------------------------- */
     /*      Handle DOCTYPE.                                                 */
     /* -------------------------------------------------------------------- */
-    else if (chNext == '<' &&
+    else if (bExclamationMark &&
              STARTS_WITH_CI(psContext->pszInput + psContext->nInputOffset,
                             "!DOCTYPE"))
     {
@@ -304,31 +450,18 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
     /* -------------------------------------------------------------------- */
     /*      Handle CDATA.                                                   */
     /* -------------------------------------------------------------------- */
-    else if (chNext == '<' &&
+    else if (bExclamationMark &&
              STARTS_WITH_CI(psContext->pszInput + psContext->nInputOffset,
                             "![CDATA["))
     {
         psContext->eTokenType = TString;
 
         // Skip !CDATA[
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
-
-        while (!STARTS_WITH_CI(psContext->pszInput + psContext->nInputOffset,
-                               "]]>") &&
-               (chNext = ReadChar(psContext)) != '\0')
-            AddToToken(psContext, chNext);
+        SkipInput(psContext, 8);
 
-        // Skip "]]>" characters.
-        ReadChar(psContext);
-        ReadChar(psContext);
-        ReadChar(psContext);
+        // Collect up to and skip "]]>" characters.
+        if (!AddSpanUntilToken(psContext, "]]>"))
+            goto fail;
     }
     /* -------------------------------------------------------------------- */
     /*      Simple single tokens of interest.                               */
@@ -384,10 +517,11 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
     {
         psContext->eTokenType = TString;
 
-        while ((chNext = ReadChar(psContext)) != '"' && chNext != '\0')
-            AddToToken(psContext, chNext);
+        const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+        if (!AddSpanToToken(psContext, strcspn(pszStart, "\"")))
+            goto fail;
 
-        if (chNext != '"')
+        if (ReadChar(psContext) != '"')
         {
             psContext->eTokenType = TNone;
             eLastErrorType = CE_Failure;
@@ -397,25 +531,17 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
                 psContext->nInputLine);
         }
 
-        // Do we need to unescape it?
-        if (strchr(psContext->pszToken, '&') != nullptr)
-        {
-            int nLength = 0;
-            char *pszUnescaped =
-                CPLUnescapeString(psContext->pszToken, &nLength, CPLES_XML);
-            strcpy(psContext->pszToken, pszUnescaped);
-            CPLFree(pszUnescaped);
-            psContext->nTokenSize = strlen(psContext->pszToken);
-        }
+        UnescapeToken(psContext);
     }
     else if (psContext->bInElement && chNext == '\'')
     {
         psContext->eTokenType = TString;
 
-        while ((chNext = ReadChar(psContext)) != '\'' && chNext != '\0')
-            AddToToken(psContext, chNext);
+        const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+        if (!AddSpanToToken(psContext, strcspn(pszStart, "'")))
+            goto fail;
 
-        if (chNext != '\'')
+        if (ReadChar(psContext) != '\'')
         {
             psContext->eTokenType = TNone;
             eLastErrorType = CE_Failure;
@@ -425,16 +551,7 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
                 psContext->nInputLine);
         }
 
-        // Do we need to unescape it?
-        if (strchr(psContext->pszToken, '&') != nullptr)
-        {
-            int nLength = 0;
-            char *pszUnescaped =
-                CPLUnescapeString(psContext->pszToken, &nLength, CPLES_XML);
-            strcpy(psContext->pszToken, pszUnescaped);
-            CPLFree(pszUnescaped);
-            psContext->nTokenSize = strlen(psContext->pszToken);
-        }
+        UnescapeToken(psContext);
     }
     /* -------------------------------------------------------------------- */
     /*      Collect an unquoted string, terminated by a open angle          */
@@ -445,20 +562,11 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
         psContext->eTokenType = TString;
 
         AddToToken(psContext, chNext);
-        while ((chNext = ReadChar(psContext)) != '<' && chNext != '\0')
-            AddToToken(psContext, chNext);
-        UnreadChar(psContext, chNext);
+        const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+        if (!AddSpanToToken(psContext, strcspn(pszStart, "<")))
+            goto fail;
 
-        // Do we need to unescape it?
-        if (strchr(psContext->pszToken, '&') != nullptr)
-        {
-            int nLength = 0;
-            char *pszUnescaped =
-                CPLUnescapeString(psContext->pszToken, &nLength, CPLES_XML);
-            strcpy(psContext->pszToken, pszUnescaped);
-            CPLFree(pszUnescaped);
-            psContext->nTokenSize = strlen(psContext->pszToken);
-        }
+        UnescapeToken(psContext);
     }
 
     /* -------------------------------------------------------------------- */
@@ -472,17 +580,19 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
         // Add the first character to the token regardless of what it is.
         AddToToken(psContext, chNext);
 
-        for (chNext = ReadChar(psContext);
-             (chNext >= 'A' && chNext <= 'Z') ||
-             (chNext >= 'a' && chNext <= 'z') || chNext == '-' ||
-             chNext == '_' || chNext == '.' || chNext == ':' ||
-             (chNext >= '0' && chNext <= '9');
-             chNext = ReadChar(psContext))
+        const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+        const char *pszEnd = pszStart;
+        for (chNext = *pszEnd; (chNext >= 'A' && chNext <= 'Z') ||
+                               (chNext >= 'a' && chNext <= 'z') ||
+                               chNext == '-' || chNext == '_' ||
+                               chNext == '.' || chNext == ':' ||
+                               (chNext >= '0' && chNext <= '9');
+             chNext = *(++pszEnd))
         {
-            AddToToken(psContext, chNext);
         }
 
-        UnreadChar(psContext, chNext);
+        if (!AddSpanToToken(psContext, pszEnd - pszStart))
+            goto fail;
     }
 
     return psContext->eTokenType;
@@ -581,6 +691,53 @@ static void AttachNode(ParseContext *psContext, CPLXMLNode *psNode)
     }
 }
 
+/************************************************************************/
+/*                          CreateParsedNode()                          */
+/*                                                                      */
+/*      Create a node whose value is the current token, either on the   */
+/*      heap or in the arena of the parse context.                      */
+/************************************************************************/
+
+static CPLXMLNode *CreateParsedNode(ParseContext *psContext,
+                                    CPLXMLNode *poParent, CPLXMLNodeType eType)
+
+{
+    CPLXMLArena *poArena = psContext->poArena;
+    if (poArena == nullptr)
+        return _CPLCreateXMLNode(poParent, eType, psContext->pszToken);
+
+    CPLXMLNode *psNode = static_cast<CPLXMLNode *>(
+        poArena->Alloc(sizeof(CPLXMLNode), alignof(CPLXMLNode)));
+    if (psNode == nullptr)
+        return nullptr;
+    char *pszValue =
+        static_cast<char *>(poArena->Alloc(psContext->nTokenSize + 1, 1));
+    if (pszValue == nullptr)
+        return nullptr;
+    memcpy(pszValue, psContext->pszToken, psContext->nTokenSize + 1);
+
+    psNode->eType = eType;
+    psNode->pszValue = pszValue;
+    psNode->psNext = nullptr;
+    psNode->psChild = nullptr;
+
+    // The parser only attaches the value of attributes, to their newly
+    // created node.
+    if (poParent != nullptr)
+    {
+        CPLAssert(poParent->psChild == nullptr);
+        poParent->psChild = psNode;
+    }
+
+    return psNode;
+}
+
+/************************************************************************/
+/*                           ParseXMLString()                           */
+/************************************************************************/
+
+static CPLXMLNode *ParseXMLString(const char *pszString, CPLXMLArena *poArena);
+
 /************************************************************************/
 /*                         CPLParseXMLString()                          */
 /************************************************************************/
@@ -610,6 +767,12 @@ static void AttachNode(ParseContext *psContext, CPLXMLNode *psNode)
 
 CPLXMLNode *CPLParseXMLString(const char *pszString)
 
+{
+    return ParseXMLString(pszString, nullptr);
+}
+
+static CPLXMLNode *ParseXMLString(const char *pszString, CPLXMLArena *poArena)
+
 {
     if (pszString == nullptr)
     {
@@ -660,6 +823,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
     sContext.papsStack = nullptr;
     sContext.psFirstNode = nullptr;
     sContext.psLastNode = nullptr;
+    sContext.poArena = poArena;
 
 #ifdef DEBUG
     bool bRecoverableError = true;
@@ -693,7 +857,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
             if (sContext.pszToken[0] != '/')
             {
                 psElement =
-                    _CPLCreateXMLNode(nullptr, CXT_Element, sContext.pszToken);
+                    CreateParsedNode(&sContext, nullptr, CXT_Element);
                 if (!psElement)
                     break;
                 AttachNode(&sContext, psElement);
@@ -781,7 +945,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TToken)
         {
             CPLXMLNode *psAttr =
-                _CPLCreateXMLNode(nullptr, CXT_Attribute, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Attribute);
             if (!psAttr)
                 break;
             AttachNode(&sContext, psAttr);
@@ -839,7 +1003,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
                 break;
             }
 
-            if (!_CPLCreateXMLNode(psAttr, CXT_Text, sContext.pszToken))
+            if (!CreateParsedNode(&sContext, psAttr, CXT_Text))
                 break;
         }
 
@@ -916,7 +1080,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TComment)
         {
             CPLXMLNode *psValue =
-                _CPLCreateXMLNode(nullptr, CXT_Comment, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Comment);
             if (!psValue)
                 break;
             AttachNode(&sContext, psValue);
@@ -929,7 +1093,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TLiteral)
         {
             CPLXMLNode *psValue =
-                _CPLCreateXMLNode(nullptr, CXT_Literal, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Literal);
             if (!psValue)
                 break;
             AttachNode(&sContext, psValue);
@@ -942,7 +1106,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TString && !sContext.bInElement)
         {
             CPLXMLNode *psValue =
-                _CPLCreateXMLNode(nullptr, CXT_Text, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Text);
             if (!psValue)
                 break;
             AttachNode(&sContext, psValue);
@@ -999,7 +1163,9 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
     // has been set we would never get failures
     if (eLastErrorType == CE_Failure)
     {
-        CPLDestroyXMLNode(sContext.psFirstNode);
+        // Nodes allocated in an arena are freed with it.
+        if (poArena == nullptr)
+            CPLDestroyXMLNode(sContext.psFirstNode);
         sContext.psFirstNode = nullptr;
         sContext.psLastNode = nullptr;
     }
@@ -2276,3 +2442,43 @@ CPLXMLNode *CPLXMLTreeCloser::getDocumentElement()
     }
     return doc;
 }
+
+/************************************************************************/
+/*                          CPLXMLArenaTree()                           */
+/************************************************************************/
+
+/** Constructor */
+CPLXMLArenaTree::CPLXMLArenaTree() = default;
+
+/************************************************************************/
+/*                          ~CPLXMLArenaTree()                          */
+/************************************************************************/
+
+/** Destructor, which frees all the nodes of the tree. */
+CPLXMLArenaTree::~CPLXMLArenaTree() = default;
+
+/************************************************************************/
+/*                       CPLXMLArenaTree::Parse()                       */
+/************************************************************************/
+
+/**
+ * \brief Parse an XML string into tree form.
+ *
+ * Same as CPLParseXMLString(), except that the returned tree is owned by
+ * this object, and must not be modified.  A previously parsed tree is
+ * freed.
+ *
+ * @param pszString the document to parse.
+ *
+ * @return parsed tree or NULL on error.
+ * @since GDAL 3.9
+ */
+CPLXMLNode *CPLXMLArenaTree::Parse(const char *pszString)
+{
+    m_psRoot = nullptr;
+    m_poArena = cpl::make_unique<CPLXMLArena>();
+    m_psRoot = ParseXMLString(pszString, m_poArena.get());
+    if (m_psRoot == nullptr)
+        m_poArena.reset();
+    return m_psRoot;
+}
@@ -216,6 +216,42 @@ extern "C++"
         CPLXMLNode *getDocumentElement();
     };
 
+    /*! @cond Doxygen_Suppress */
+    struct CPLXMLArena;
+    /*! @endcond */
+
+    /** Parse XML documents into a tree whose nodes are allocated in a few
+     * large memory blocks, which are freed together when the instance goes
+     * out of scope.
+     *
+     * This is faster than CPLParseXMLString() / CPLDestroyXMLNode() for large
+     * documents, but the tree must be considered as read-only: its nodes
+     * must not be modified, added, removed or destroyed. CPLCloneXMLTree()
+     * can be used to get a regular copy of it.
+     *
+     * @since GDAL 3.9
+     */
+    class CPL_DLL CPLXMLArenaTree
+    {
+      public:
+        CPLXMLArenaTree();
+        ~CPLXMLArenaTree();
+
+        CPLXMLNode *Parse(const char *pszString);
+
+        /** Returns the root of the last parsed tree, or NULL */
+        CPLXMLNode *get() const
+        {
+            return m_psRoot;
+        }
+
+      private:
+        std::unique_ptr<CPLXMLArena> m_poArena{};
+        CPLXMLNode *m_psRoot = nullptr;
+
+        CPL_DISALLOW_COPY_ASSIGN(CPLXMLArenaTree)
+    };
+
 }  // extern "C++"
 
 #endif /* __cplusplus */
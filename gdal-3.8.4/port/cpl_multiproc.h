@@ -234,10 +234,10 @@ class CPL_DLL CPLLockHolder
 #define CTLS_CONFIGOPTIONS 14           /* cpl_conv.cpp */
 #define CTLS_FINDFILE 15                /* cpl_findfile.cpp */
 #define CTLS_VSIERRORCONTEXT 16         /* cpl_vsi_error.cpp */
-/* 17: unused */
-#define CTLS_PROJCONTEXTHOLDER 18      /* ogr_proj_p.cpp */
-#define CTLS_GDALDEFAULTOVR_ANTIREC 19 /* gdaldefaultoverviews.cpp */
-#define CTLS_HTTPFETCHCALLBACK 20      /* cpl_http.cpp */
+#define CTLS_CONFIGOPTIONSCACHE 17      /* cpl_conv.cpp */
+#define CTLS_PROJCONTEXTHOLDER 18       /* ogr_proj_p.cpp */
+#define CTLS_GDALDEFAULTOVR_ANTIREC 19  /* gdaldefaultoverviews.cpp */
+#define CTLS_HTTPFETCHCALLBACK 20       /* cpl_http.cpp */
 
 #define CTLS_MAX 32
 
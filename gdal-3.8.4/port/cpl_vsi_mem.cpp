@@ -156,6 +156,10 @@ class VSIMemHandle final : public VSIVirtualHandle
     }
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+    std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        const VSIAsyncReadCallback &fnCompletion) override;
 };
 
 /************************************************************************/
@@ -446,6 +450,27 @@ size_t VSIMemHandle::PRead(void *pBuffer, size_t nSize,
     return 0;
 }
 
+/************************************************************************/
+/*                        ReadMultiRangeAsync()                         */
+/************************************************************************/
+
+std::unique_ptr<VSIAsyncReadRequest> VSIMemHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, const VSIAsyncReadCallback &fnCompletion)
+{
+    // Copying from memory is cheaper than handing the request to a thread.
+    int nRet = 0;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (PRead(ppData[i], panSizes[i], panOffsets[i]) != panSizes[i])
+        {
+            nRet = -1;
+            break;
+        }
+    }
+    return VSIAsyncReadRequest::CreateCompleted(nRet, fnCompletion);
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
@@ -39,6 +39,7 @@
 #include "cpl_string.h"
 #include "cpl_multiproc.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -54,6 +55,14 @@
 #undef CopyFile
 #endif
 
+class VSIAsyncReadRequest;
+
+/** Function called on completion of an asynchronous read request.
+ * nStatus is 0 in case of success, -1 otherwise.
+ * @since GDAL 3.9
+ */
+typedef std::function<void(int nStatus)> VSIAsyncReadCallback;
+
 /************************************************************************/
 /*                           VSIVirtualHandle                           */
 /************************************************************************/
@@ -108,6 +117,10 @@ struct CPL_DLL VSIVirtualHandle
     virtual bool HasPRead() const;
     virtual size_t PRead(void *pBuffer, size_t nSize,
                          vsi_l_offset nOffset) const;
+    virtual std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        const VSIAsyncReadCallback &fnCompletion);
 
     // NOTE: when adding new methods, besides the "actual" implementations,
     // also consider the VSICachedFile one.
@@ -117,6 +130,47 @@ struct CPL_DLL VSIVirtualHandle
     }
 };
 
+/************************************************************************/
+/*                         VSIAsyncReadRequest                          */
+/************************************************************************/
+
+/** Pending asynchronous read, as returned by
+ * VSIVirtualHandle::ReadMultiRangeAsync().
+ *
+ * Destroying the object waits for the completion of the request.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL VSIAsyncReadRequest
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIAsyncReadRequest)
+
+  protected:
+    //! @cond Doxygen_Suppress
+    VSIAsyncReadRequest() = default;
+    //! @endcond
+
+  public:
+    virtual ~VSIAsyncReadRequest();
+
+    /** Returns whether the request has completed, without blocking. */
+    virtual bool IsDone() const = 0;
+
+    /** Waits for the completion of the request, and emits the errors that
+     * occurred while serving it. Returns 0 in case of success, -1 otherwise.
+     */
+    virtual int Wait() = 0;
+
+    //! @cond Doxygen_Suppress
+    static std::unique_ptr<VSIAsyncReadRequest>
+    CreateCompleted(int nStatus, const VSIAsyncReadCallback &fnCompletion);
+
+    static std::unique_ptr<VSIAsyncReadRequest>
+    Submit(std::function<int()> &&fnRead,
+           const VSIAsyncReadCallback &fnCompletion);
+    //! @endcond
+};
+
 /************************************************************************/
 /*                        VSIVirtualHandleCloser                        */
 /************************************************************************/
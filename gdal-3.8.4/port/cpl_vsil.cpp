@@ -41,6 +41,7 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
@@ -52,9 +53,11 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
 #include "cpl_vsil_curl_class.h"
 
 // To avoid aliasing to GetDiskFreeSpace to GetDiskFreeSpaceA on Windows
@@ -3383,3 +3386,266 @@ size_t VSIVirtualHandle::PRead(CPL_UNUSED void *pBuffer,
 {
     return 0;
 }
+
+/************************************************************************/
+/*                        ReadMultiRangeAsync()                         */
+/************************************************************************/
+
+/** Start reading several ranges of bytes from file, without blocking.
+ *
+ * This is the asynchronous counterpart of ReadMultiRange(): ranges must be
+ * sorted in ascending start offset and must not overlap. ppData[i] must
+ * remain valid until the request has completed, whereas the ppData,
+ * panOffsets and panSizes arrays themselves may be freed once the method
+ * returns.
+ *
+ * No other method of the handle may be called, and no other asynchronous
+ * request may be issued on it, until the request has completed.
+ *
+ * The default implementation runs ReadMultiRange() in a worker thread of the
+ * global GDAL thread pool, sized after the GDAL_NUM_THREADS configuration
+ * option. If no worker has started the request when Wait() is called, the
+ * waiting thread runs it itself. File systems for which reading is cheap may
+ * serve the request synchronously, in which case the returned request is
+ * already completed.
+ *
+ * @param nRanges number of ranges to read.
+ * @param ppData array of nRanges buffer into which the data should be read
+ *               (ppData[i] must be at list panSizes[i] bytes).
+ * @param panOffsets array of nRanges offsets at which the data should be read.
+ * @param panSizes array of nRanges sizes of objects to read (in bytes).
+ * @param fnCompletion function called once the request has completed, before
+ *                     VSIAsyncReadRequest::Wait() returns. It may be called
+ *                     from another thread, or from this method itself.
+ *                     May be empty.
+ * @return a (non-null) request object.
+ * @since GDAL 3.9
+ */
+std::unique_ptr<VSIAsyncReadRequest> VSIVirtualHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, const VSIAsyncReadCallback &fnCompletion)
+{
+    struct Ranges
+    {
+        std::vector<void *> apData{};
+        std::vector<vsi_l_offset> anOffsets{};
+        std::vector<size_t> anSizes{};
+    };
+
+    auto poRanges = std::make_shared<Ranges>();
+    poRanges->apData.assign(ppData, ppData + nRanges);
+    poRanges->anOffsets.assign(panOffsets, panOffsets + nRanges);
+    poRanges->anSizes.assign(panSizes, panSizes + nRanges);
+
+    VSIVirtualHandle *poThis = this;
+    return VSIAsyncReadRequest::Submit(
+        [poThis, poRanges]()
+        {
+            return poThis->ReadMultiRange(
+                static_cast<int>(poRanges->apData.size()),
+                poRanges->apData.data(), poRanges->anOffsets.data(),
+                poRanges->anSizes.data());
+        },
+        fnCompletion);
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                         VSIAsyncReadRequest                          */
+/* ==================================================================== */
+/************************************************************************/
+
+#ifndef DOXYGEN_SKIP
+
+VSIAsyncReadRequest::~VSIAsyncReadRequest() = default;
+
+namespace
+{
+
+/************************************************************************/
+/*                    VSICompletedAsyncReadRequest                      */
+/************************************************************************/
+
+class VSICompletedAsyncReadRequest final : public VSIAsyncReadRequest
+{
+    const int m_nStatus;
+
+  public:
+    explicit VSICompletedAsyncReadRequest(int nStatus) : m_nStatus(nStatus)
+    {
+    }
+
+    bool IsDone() const override
+    {
+        return true;
+    }
+
+    int Wait() override
+    {
+        return m_nStatus;
+    }
+};
+
+/************************************************************************/
+/*                     VSIThreadedAsyncReadRequest                      */
+/************************************************************************/
+
+// State shared between the request object and the worker thread serving it.
+struct VSIAsyncReadState
+{
+    std::function<int()> fnRead{};
+    VSIAsyncReadCallback fnCompletion{};
+
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    bool bStarted = false;
+    bool bDone = false;
+    int nStatus = -1;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+
+class VSIThreadedAsyncReadRequest final : public VSIAsyncReadRequest
+{
+    std::shared_ptr<VSIAsyncReadState> m_poState;
+
+  public:
+    explicit VSIThreadedAsyncReadRequest(
+        const std::shared_ptr<VSIAsyncReadState> &poState)
+        : m_poState(poState)
+    {
+    }
+
+    ~VSIThreadedAsyncReadRequest() override
+    {
+        VSIThreadedAsyncReadRequest::Wait();
+    }
+
+    bool IsDone() const override
+    {
+        std::lock_guard<std::mutex> oLock(m_poState->oMutex);
+        return m_poState->bDone;
+    }
+
+    int Wait() override
+    {
+        // Run the request from this thread if no worker has picked it yet,
+        // which may never happen if all workers are busy waiting for
+        // requests like this one.
+        bool bRunHere = false;
+        {
+            std::lock_guard<std::mutex> oLock(m_poState->oMutex);
+            if (!m_poState->bStarted)
+            {
+                m_poState->bStarted = true;
+                bRunHere = true;
+            }
+        }
+        if (bRunHere)
+            Run(m_poState);
+
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+        int nStatus;
+        {
+            std::unique_lock<std::mutex> oLock(m_poState->oMutex);
+            while (!m_poState->bDone)
+                m_poState->oCV.wait(oLock);
+            std::swap(aoErrors, m_poState->aoErrors);
+            nStatus = m_poState->nStatus;
+        }
+        for (const auto &oError : aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        return nStatus;
+    }
+
+    static void Run(const std::shared_ptr<VSIAsyncReadState> &poState);
+    static void JobFunc(void *pData);
+};
+
+/************************************************************************/
+/*                              JobFunc()                               */
+/************************************************************************/
+
+void VSIThreadedAsyncReadRequest::JobFunc(void *pData)
+{
+    std::unique_ptr<std::shared_ptr<VSIAsyncReadState>> ppoState(
+        static_cast<std::shared_ptr<VSIAsyncReadState> *>(pData));
+    const auto &poState = *ppoState;
+    {
+        std::lock_guard<std::mutex> oLock(poState->oMutex);
+        // Already run, or being run, by Wait()
+        if (poState->bStarted)
+            return;
+        poState->bStarted = true;
+    }
+    Run(poState);
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+void VSIThreadedAsyncReadRequest::Run(
+    const std::shared_ptr<VSIAsyncReadState> &poState)
+{
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    CPLInstallErrorHandlerAccumulator(aoErrors);
+    const int nStatus = poState->fnRead();
+    CPLUninstallErrorHandlerAccumulator();
+    poState->fnRead = nullptr;
+
+    if (poState->fnCompletion)
+        poState->fnCompletion(nStatus);
+
+    std::lock_guard<std::mutex> oLock(poState->oMutex);
+    poState->nStatus = nStatus;
+    poState->aoErrors = std::move(aoErrors);
+    poState->bDone = true;
+    poState->oCV.notify_all();
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                          CreateCompleted()                           */
+/************************************************************************/
+
+/** Returns a request that has already completed with nStatus, after having
+ * called fnCompletion. */
+std::unique_ptr<VSIAsyncReadRequest>
+VSIAsyncReadRequest::CreateCompleted(int nStatus,
+                                     const VSIAsyncReadCallback &fnCompletion)
+{
+    if (fnCompletion)
+        fnCompletion(nStatus);
+    return cpl::make_unique<VSICompletedAsyncReadRequest>(nStatus);
+}
+
+/************************************************************************/
+/*                               Submit()                               */
+/************************************************************************/
+
+/** Runs fnRead in the global thread pool, or synchronously if the pool
+ * cannot be created. */
+std::unique_ptr<VSIAsyncReadRequest>
+VSIAsyncReadRequest::Submit(std::function<int()> &&fnRead,
+                            const VSIAsyncReadCallback &fnCompletion)
+{
+    auto poPool = CPLGetGlobalThreadPool(
+        CPLGetNumThreads(nullptr, nullptr, /* nMaxThreads = */ 1024));
+    if (poPool == nullptr)
+        return CreateCompleted(fnRead(), fnCompletion);
+
+    auto poState = std::make_shared<VSIAsyncReadState>();
+    poState->fnRead = std::move(fnRead);
+    poState->fnCompletion = fnCompletion;
+    auto poRequest = cpl::make_unique<VSIThreadedAsyncReadRequest>(poState);
+    auto ppoState = new std::shared_ptr<VSIAsyncReadState>(poState);
+    if (!poPool->SubmitJob(VSIThreadedAsyncReadRequest::JobFunc, ppoState))
+    {
+        // Run by Wait()
+        delete ppoState;
+    }
+    return std::unique_ptr<VSIAsyncReadRequest>(poRequest.release());
+}
+
+#endif  // #ifndef DOXYGEN_SKIP
@@ -32,10 +32,16 @@
 
 #include <algorithm>
 #include <array>
+#include <ctime>
 #include <set>
 #include <map>
 #include <memory>
 
+#ifndef _WIN32
+#include <utime.h>
+#endif
+
+#include "cpl_atomic_ops.h"
 #include "cpl_aws.h"
 #include "cpl_json.h"
 #include "cpl_json_header.h"
@@ -47,6 +53,7 @@
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_mem_cache.h"
+#include "cpl_sha256.h"
 
 #ifndef S_IRUSR
 #define S_IRUSR 00400
@@ -3639,13 +3646,340 @@ VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(const CPLString & /*osURL*/)
 VSICurlFilesystemHandlerBase::RegionCacheType *
 VSICurlFilesystemHandlerBase::GetRegionCache()
 {
-    // should be called under hMutex taken
-    if (m_poRegionCacheDoNotUseDirectly == nullptr)
+    // Lazily created, so that configuration options set after the
+    // installation of the file system handler are taken into account.
+    std::call_once(
+        m_oRegionCacheOnce,
+        [this]()
+        {
+            const size_t nMaxRegions = static_cast<size_t>(GetMaxRegions());
+            m_poRegionCacheDoNotUseDirectly =
+                cpl::make_unique<RegionCacheType>(
+                    nMaxRegions, /* elasticity = */ 10,
+                    /* maxWeight = */ nMaxRegions *
+                        VSICURLGetDownloadChunkSize());
+        });
+    return m_poRegionCacheDoNotUseDirectly.get();
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                        Persistent region cache                       */
+/* ==================================================================== */
+/************************************************************************/
+
+// When CPL_VSIL_CURL_DISK_CACHE_DIR is set, downloaded regions are also
+// stored in that directory, so that they survive the process. Entries are
+// keyed by URL, ETag (or size and modification time when there is no ETag),
+// offset and chunk size, so that a modified remote file does not hit stale
+// entries. As URLs may contain credentials (signed URLs, SAS tokens...), the
+// key itself is never written to disk: each entry is a file whose name is
+// the SHA256 of its key, and that starts with a HMAC-SHA256 of the key to
+// detect collisions. Directories are created readable by the user only.
+//
+// Several processes may share a cache directory: entries are written to a
+// temporary file and renamed, so that readers see either nothing or a
+// complete entry. The modification time of an entry is refreshed when it is
+// hit, and each process evicts the least recently used entries once it has
+// written enough data for the directory to possibly exceed
+// CPL_VSIL_CURL_DISK_CACHE_SIZE. Setting it to 0 disables the cache.
+
+constexpr char DISK_CACHE_MAGIC[] = "GDALVSICURLCACHE2";
+constexpr size_t DISK_CACHE_MAGIC_SIZE = sizeof(DISK_CACHE_MAGIC) - 1;
+constexpr GIntBig DISK_CACHE_SIZE_DEFAULT = 1024 * 1024 * 1024;
+// Refresh the modification time of hit entries at most that often.
+constexpr int DISK_CACHE_TOUCH_DELAY_SEC = 600;
+// Temporary files older than that are leftovers of crashed processes.
+constexpr int DISK_CACHE_STALE_TMP_DELAY_SEC = 3600;
+
+static std::mutex goDiskCacheMutex;
+static GIntBig gnDiskCacheBytesWrittenSinceTrim = -1;
+
+/************************************************************************/
+/*                      VSICURLGetDiskCacheSize()                       */
+/************************************************************************/
+
+static GIntBig VSICURLGetDiskCacheSize()
+{
+    const char *pszSize =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE", nullptr);
+    if (pszSize == nullptr)
+        return DISK_CACHE_SIZE_DEFAULT;
+    const GIntBig nSize = CPLAtoGIntBig(pszSize);
+    if (CPLGetValueType(pszSize) != CPL_VALUE_INTEGER || nSize < 0)
+    {
+        static bool bHasWarned = false;
+        if (!bHasWarned)
+        {
+            bHasWarned = true;
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for CPL_VSIL_CURL_DISK_CACHE_SIZE: %s. "
+                     "Using " CPL_FRMT_GIB " instead",
+                     pszSize, DISK_CACHE_SIZE_DEFAULT);
+        }
+        return DISK_CACHE_SIZE_DEFAULT;
+    }
+    return nSize;
+}
+
+/************************************************************************/
+/*                       VSICURLGetDiskCacheDir()                       */
+/************************************************************************/
+
+// Returns the directory of the persistent cache, or nullptr if it is
+// disabled.
+
+static const char *VSICURLGetDiskCacheDir()
+{
+    const char *pszDir =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0' ||
+        VSICURLGetDiskCacheSize() == 0)
     {
-        m_poRegionCacheDoNotUseDirectly.reset(
-            new RegionCacheType(static_cast<size_t>(GetMaxRegions())));
+        return nullptr;
     }
-    return m_poRegionCacheDoNotUseDirectly.get();
+    return pszDir;
+}
+
+/************************************************************************/
+/*                     VSICURLGetDiskCacheKeyCheck()                    */
+/************************************************************************/
+
+// Returns the digest stored in an entry to check that it matches osKey.
+
+static std::array<GByte, CPL_SHA256_HASH_SIZE>
+VSICURLGetDiskCacheKeyCheck(const std::string &osKey)
+{
+    std::array<GByte, CPL_SHA256_HASH_SIZE> abyCheck;
+    CPL_HMAC_SHA256(DISK_CACHE_MAGIC, DISK_CACHE_MAGIC_SIZE, osKey.data(),
+                    osKey.size(), abyCheck.data());
+    return abyCheck;
+}
+
+/************************************************************************/
+/*                    VSICURLGetDiskCacheFilename()                     */
+/************************************************************************/
+
+static std::string VSICURLGetDiskCacheFilename(const char *pszDir,
+                                               const std::string &osKey)
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const std::string osSubDir =
+        CPLFormFilename(pszDir, std::string(pszHex, 2).c_str(), nullptr);
+    std::string osFilename = CPLFormFilename(osSubDir.c_str(), pszHex, nullptr);
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+/************************************************************************/
+/*                       VSICURLDiskCacheTrim()                         */
+/************************************************************************/
+
+// Removes the least recently used entries until the cache directory is
+// below 90% of its maximum size.
+
+static void VSICURLDiskCacheTrim(const char *pszDir, GIntBig nMaxSize)
+{
+    struct Entry
+    {
+        std::string osFilename{};
+        GIntBig nSize = 0;
+        GIntBig nMTime = 0;
+    };
+
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const GIntBig nNow = static_cast<GIntBig>(time(nullptr));
+    const CPLStringList aosSubDirs(VSIReadDir(pszDir));
+    for (const char *pszSubDir : aosSubDirs)
+    {
+        if (strlen(pszSubDir) != 2)
+            continue;
+        const std::string osSubDir =
+            CPLFormFilename(pszDir, pszSubDir, nullptr);
+        const CPLStringList aosFiles(VSIReadDir(osSubDir.c_str()));
+        for (const char *pszFile : aosFiles)
+        {
+            if (pszFile[0] == '.')
+                continue;
+            Entry oEntry;
+            oEntry.osFilename =
+                CPLFormFilename(osSubDir.c_str(), pszFile, nullptr);
+            VSIStatBufL sStat;
+            if (VSIStatL(oEntry.osFilename.c_str(), &sStat) != 0 ||
+                !VSI_ISREG(sStat.st_mode))
+            {
+                continue;
+            }
+            if (EQUAL(CPLGetExtension(pszFile), "tmp"))
+            {
+                if (nNow - static_cast<GIntBig>(sStat.st_mtime) >
+                    DISK_CACHE_STALE_TMP_DELAY_SEC)
+                {
+                    VSIUnlink(oEntry.osFilename.c_str());
+                }
+                continue;
+            }
+            oEntry.nSize = static_cast<GIntBig>(sStat.st_size);
+            oEntry.nMTime = static_cast<GIntBig>(sStat.st_mtime);
+            nTotalSize += oEntry.nSize;
+            aoEntries.emplace_back(std::move(oEntry));
+        }
+    }
+
+    if (nTotalSize <= nMaxSize)
+        return;
+
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.nMTime < b.nMTime; });
+    const GIntBig nTargetSize = nMaxSize / 10 * 9;
+    int nRemoved = 0;
+    for (const auto &oEntry : aoEntries)
+    {
+        if (nTotalSize <= nTargetSize)
+            break;
+        // Another process may have removed it already: not an error.
+        VSIUnlink(oEntry.osFilename.c_str());
+        nTotalSize -= oEntry.nSize;
+        ++nRemoved;
+    }
+    CPLDebug("VSICURL", "Disk cache: evicted %d entries", nRemoved);
+}
+
+/************************************************************************/
+/*                         VSICURLDiskCacheGet()                        */
+/************************************************************************/
+
+static std::shared_ptr<std::string>
+VSICURLDiskCacheGet(const char *pszDir, const std::string &osKey)
+{
+    const std::string osFilename = VSICURLGetDiskCacheFilename(pszDir, osKey);
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0)
+        return nullptr;
+
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return nullptr;
+
+    // Layout: magic, HMAC-SHA256 of the key, data.
+    std::shared_ptr<std::string> psData;
+    const auto abyCheck = VSICURLGetDiskCacheKeyCheck(osKey);
+    std::string osHeader(DISK_CACHE_MAGIC_SIZE + abyCheck.size(), '\0');
+    if (static_cast<vsi_l_offset>(sStat.st_size) >= osHeader.size() &&
+        VSIFReadL(&osHeader[0], osHeader.size(), 1, fp) == 1 &&
+        memcmp(osHeader.data(), DISK_CACHE_MAGIC, DISK_CACHE_MAGIC_SIZE) ==
+            0 &&
+        memcmp(osHeader.data() + DISK_CACHE_MAGIC_SIZE, abyCheck.data(),
+               abyCheck.size()) == 0)
+    {
+        const size_t nDataSize = static_cast<size_t>(
+            static_cast<vsi_l_offset>(sStat.st_size) - osHeader.size());
+        psData = std::make_shared<std::string>(nDataSize, '\0');
+        if (nDataSize > 0 && VSIFReadL(&(*psData)[0], nDataSize, 1, fp) != 1)
+        {
+            psData.reset();
+        }
+    }
+    VSIFCloseL(fp);
+
+#ifndef _WIN32
+    if (psData && static_cast<GIntBig>(time(nullptr)) -
+                          static_cast<GIntBig>(sStat.st_mtime) >
+                      DISK_CACHE_TOUCH_DELAY_SEC)
+    {
+        // Mark the entry as recently used for eviction.
+        utime(osFilename.c_str(), nullptr);
+    }
+#endif
+
+    return psData;
+}
+
+/************************************************************************/
+/*                         VSICURLDiskCachePut()                        */
+/************************************************************************/
+
+static void VSICURLDiskCachePut(const char *pszDir, const std::string &osKey,
+                                const char *pData, size_t nSize)
+{
+    const std::string osFilename = VSICURLGetDiskCacheFilename(pszDir, osKey);
+    const std::string osSubDir = CPLGetPath(osFilename.c_str());
+    VSIStatBufL sStat;
+    if (VSIStatL(osSubDir.c_str(), &sStat) != 0)
+        VSIMkdirRecursive(osSubDir.c_str(), 0700);
+
+    // Write to a private file and rename it, so that concurrent readers
+    // never see a partial entry.
+    static int nTmpCounter = 0;
+    const std::string osTmpFilename =
+        osFilename + CPLSPrintf(".%d_%d.tmp", CPLGetCurrentProcessID(),
+                                CPLAtomicInc(&nTmpCounter));
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+        return;
+    const auto abyCheck = VSICURLGetDiskCacheKeyCheck(osKey);
+    bool bOK =
+        VSIFWriteL(DISK_CACHE_MAGIC, DISK_CACHE_MAGIC_SIZE, 1, fp) == 1 &&
+        VSIFWriteL(abyCheck.data(), abyCheck.size(), 1, fp) == 1 &&
+        (nSize == 0 || VSIFWriteL(pData, nSize, 1, fp) == 1);
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    const GIntBig nMaxSize = VSICURLGetDiskCacheSize();
+    {
+        std::lock_guard<std::mutex> oLock(goDiskCacheMutex);
+        // Trim on the first write of the process, and then after having
+        // written a tenth of the maximum size.
+        if (gnDiskCacheBytesWrittenSinceTrim >= 0)
+        {
+            gnDiskCacheBytesWrittenSinceTrim += static_cast<GIntBig>(nSize);
+            if (gnDiskCacheBytesWrittenSinceTrim < nMaxSize / 10)
+                return;
+        }
+        gnDiskCacheBytesWrittenSinceTrim = 0;
+    }
+    VSICURLDiskCacheTrim(pszDir, nMaxSize);
+}
+
+/************************************************************************/
+/*                       VSICURLGetDiskCacheKey()                       */
+/************************************************************************/
+
+// Returns the key of a region in the persistent cache, or an empty string
+// if that cache is disabled or if the remote file cannot be versioned.
+
+static std::string VSICURLGetDiskCacheKey(const char *pszURL,
+                                          vsi_l_offset nFileOffsetStart)
+{
+    FileProp oFileProp;
+    if (!VSICURLGetCachedFileProp(pszURL, oFileProp))
+        return std::string();
+
+    std::string osVersion;
+    if (!oFileProp.ETag.empty())
+        osVersion = "etag:" + oFileProp.ETag;
+    else if (oFileProp.bHasComputedFileSize && oFileProp.mTime != 0)
+        osVersion = CPLSPrintf("size:" CPL_FRMT_GUIB ",mtime:" CPL_FRMT_GIB,
+                               static_cast<GUIntBig>(oFileProp.fileSize),
+                               static_cast<GIntBig>(oFileProp.mTime));
+    else
+        return std::string();
+
+    std::string osKey(pszURL);
+    osKey += '\n';
+    osKey += osVersion;
+    osKey += CPLSPrintf("\n" CPL_FRMT_GUIB "\n%d",
+                        static_cast<GUIntBig>(nFileOffsetStart),
+                        VSICURLGetDownloadChunkSize());
+    return osKey;
 }
 
 /************************************************************************/
@@ -3656,17 +3990,36 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
                                         vsi_l_offset nFileOffsetStart)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
-    std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
-        return out;
+        std::shared_ptr<std::string> out;
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+                out))
+        {
+            return out;
+        }
+    }
+
+    const char *pszDiskCacheDir = VSICURLGetDiskCacheDir();
+    if (pszDiskCacheDir)
+    {
+        const std::string osKey =
+            VSICURLGetDiskCacheKey(pszURL, nFileOffsetStart);
+        if (!osKey.empty())
+        {
+            auto psData = VSICURLDiskCacheGet(pszDiskCacheDir, osKey);
+            if (psData)
+            {
+                GetRegionCache()->insert(
+                    FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+                    psData);
+                return psData;
+            }
+        }
     }
 
     return nullptr;
@@ -3680,12 +4033,22 @@ void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
                                              size_t nSize, const char *pData)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+            std::move(value));
+    }
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    const char *pszDiskCacheDir = VSICURLGetDiskCacheDir();
+    if (pszDiskCacheDir)
+    {
+        const std::string osKey =
+            VSICURLGetDiskCacheKey(pszURL, nFileOffsetStart);
+        if (!osKey.empty())
+            VSICURLDiskCachePut(pszDiskCacheDir, osKey, pData, nSize);
+    }
 }
 
 /************************************************************************/
@@ -3801,20 +4164,10 @@ void VSICurlFilesystemHandlerBase::InvalidateCachedData(const char *pszURL)
     oCacheFileProp.remove(std::string(pszURL));
 
     // Invalidate all cached regions for this URL
-    std::list<FilenameOffsetPair> keysToRemove;
-    std::string osURL(pszURL);
-    auto lambda =
-        [&keysToRemove,
-         &osURL](const lru11::KeyValuePair<FilenameOffsetPair,
-                                           std::shared_ptr<std::string>> &kv)
-    {
-        if (kv.key.filename_ == osURL)
-            keysToRemove.push_back(kv.key);
-    };
-    auto *poRegionCache = GetRegionCache();
-    poRegionCache->cwalk(lambda);
-    for (auto &key : keysToRemove)
-        poRegionCache->remove(key);
+    const std::string osURL(pszURL);
+    GetRegionCache()->removeIf(
+        [&osURL](const RegionCacheType::node_type &kv)
+        { return kv.key.filename_ == osURL; });
 }
 
 /************************************************************************/
@@ -3850,21 +4203,11 @@ void VSICurlFilesystemHandlerBase::PartialClearCache(
     CPLMutexHolder oHolder(&hMutex);
 
     CPLString osURL = GetURLFromFilename(pszFilenamePrefix);
-    {
-        std::list<FilenameOffsetPair> keysToRemove;
-        auto lambda =
-            [&keysToRemove, &osURL](
-                const lru11::KeyValuePair<FilenameOffsetPair,
-                                          std::shared_ptr<std::string>> &kv)
+    GetRegionCache()->removeIf(
+        [&osURL](const RegionCacheType::node_type &kv)
         {
-            if (strncmp(kv.key.filename_.c_str(), osURL, osURL.size()) == 0)
-                keysToRemove.push_back(kv.key);
-        };
-        auto *poRegionCache = GetRegionCache();
-        poRegionCache->cwalk(lambda);
-        for (auto &key : keysToRemove)
-            poRegionCache->remove(key);
-    }
+            return strncmp(kv.key.filename_.c_str(), osURL, osURL.size()) == 0;
+        });
 
     {
         std::list<std::string> keysToRemove;
@@ -3973,6 +4316,13 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' "                \
     "description='Size in bytes of the global /vsicurl/ cache' "               \
     "default='16384000'/>"                                                     \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' "             \
+    "description='Directory of a persistent cache of downloaded regions, "     \
+    "shared between processes'/>"                                              \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' "           \
+    "description='Maximum size in bytes of the persistent cache, or 0 to "     \
+    "disable it' "                                                             \
+    "default='1073741824'/>"                                                   \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' "    \
     "description='Whether to skip files with Glacier storage class in "        \
     "directory listing.' default='YES'/>"
@@ -188,14 +188,21 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
         }
     };
 
-    using RegionCacheType = lru11::Cache<
-        FilenameOffsetPair, std::shared_ptr<std::string>, lru11::NullLock,
-        std::unordered_map<
-            FilenameOffsetPair,
-            typename std::list<lru11::KeyValuePair<
-                FilenameOffsetPair, std::shared_ptr<std::string>>>::iterator,
-            FilenameOffsetPairHasher>>;
+    struct RegionWeigher
+    {
+        std::size_t operator()(const FilenameOffsetPair &,
+                               const std::shared_ptr<std::string> &v) const
+        {
+            return v->size();
+        }
+    };
+
+    // Thread-safe on its own: does not need hMutex to be taken.
+    using RegionCacheType =
+        lru11::ShardedCache<FilenameOffsetPair, std::shared_ptr<std::string>,
+                            FilenameOffsetPairHasher, RegionWeigher>;
 
+    std::once_flag m_oRegionCacheOnce{};
     std::unique_ptr<RegionCacheType>
         m_poRegionCacheDoNotUseDirectly{};  // do not access directly. Use
                                             // GetRegionCache();
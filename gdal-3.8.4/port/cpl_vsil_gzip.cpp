@@ -98,6 +98,7 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
 #include <iterator>
 #include <limits>
 #include <list>
@@ -2877,6 +2878,989 @@ vsi_l_offset VSIGZipWriteHandle::Tell()
     return nCurOffset;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                         VSIGZipReadHandleMT                          */
+/* ==================================================================== */
+/************************************************************************/
+
+// Reader that inflates in parallel the independent parts of a gzip file:
+// - members of BGZF files, whose size is given in their header,
+// - parts separated by the 0x00 0x00 0xff 0xff 0x00 0x00 0x00 0xff 0xff
+//   sequence emitted after a dictionary reset by VSIGZipWriteHandleMT and
+//   pigz -i.
+// The compressed stream is cut into "segments" at those boundaries, which
+// are inflated by the global thread pool ahead of the reading position.
+// As the marker may also appear in the payload of stored blocks, a cut is
+// only accepted once the inflation of the preceding segment has ended on a
+// block boundary. Otherwise that segment is inflated again, merged with the
+// next one.
+// The compressed and uncompressed offsets of consumed segments are indexed,
+// so that seeking back to already read data only requires inflating the
+// segment it belongs to.
+
+constexpr GByte GZIP_FULL_FLUSH_MARKER[] = {0x00, 0x00, 0xff, 0xff, 0x00,
+                                            0x00, 0x00, 0xff, 0xff};
+constexpr size_t GZIP_FULL_FLUSH_MARKER_SIZE = sizeof(GZIP_FULL_FLUSH_MARKER);
+
+/************************************************************************/
+/*                        VSIGZipParseHeader()                          */
+/************************************************************************/
+
+// Parses the gzip member header at the start of pabyData. Returns its size,
+// 0 if more bytes are needed, or -1 if this is not a gzip header.
+// *pnBGZFBlockSize is set to the total size of the member for BGZF blocks.
+
+static int VSIGZipParseHeader(const GByte *pabyData, size_t nSize,
+                              size_t *pnBGZFBlockSize)
+{
+    *pnBGZFBlockSize = 0;
+    if (nSize < 10)
+        return 0;
+    if (pabyData[0] != gz_magic[0] || pabyData[1] != gz_magic[1] ||
+        pabyData[2] != Z_DEFLATED || (pabyData[3] & RESERVED) != 0)
+    {
+        return -1;
+    }
+    const int nFlags = pabyData[3];
+    size_t nPos = 10;
+    if (nFlags & EXTRA_FIELD)
+    {
+        if (nSize < nPos + 2)
+            return 0;
+        const size_t nXLen = pabyData[nPos] | (pabyData[nPos + 1] << 8);
+        nPos += 2;
+        if (nSize < nPos + nXLen)
+            return 0;
+        for (size_t i = 0; i + 4 <= nXLen;)
+        {
+            const GByte *pabySub = pabyData + nPos + i;
+            const size_t nSubLen = pabySub[2] | (pabySub[3] << 8);
+            if (pabySub[0] == 'B' && pabySub[1] == 'C' && nSubLen == 2 &&
+                i + 6 <= nXLen)
+            {
+                *pnBGZFBlockSize = (pabySub[4] | (pabySub[5] << 8)) + 1;
+            }
+            i += 4 + nSubLen;
+        }
+        nPos += nXLen;
+    }
+    for (const int nFlag : {ORIG_NAME, COMMENT})
+    {
+        if (nFlags & nFlag)
+        {
+            const void *pEnd = memchr(pabyData + nPos, 0, nSize - nPos);
+            if (pEnd == nullptr)
+                return 0;
+            nPos = static_cast<const GByte *>(pEnd) - pabyData + 1;
+        }
+    }
+    if (nFlags & HEAD_CRC)
+    {
+        nPos += 2;
+        if (nSize < nPos)
+            return 0;
+    }
+    if (nPos > static_cast<size_t>(INT_MAX))
+        return -1;
+    return static_cast<int>(nPos);
+}
+
+/************************************************************************/
+/*                     VSIGZipFindFullFlushMarker()                     */
+/************************************************************************/
+
+// Returns the position of the first full flush marker in
+// pabyData[nStart, nSize), or std::string::npos.
+
+static size_t VSIGZipFindFullFlushMarker(const char *pabyData, size_t nSize,
+                                         size_t nStart)
+{
+    // The first 0xff byte of the marker is at index 2.
+    size_t nPos = nStart;
+    while (nPos + GZIP_FULL_FLUSH_MARKER_SIZE <= nSize)
+    {
+        const void *pFound = memchr(pabyData + nPos + 2, 0xff,
+                                    nSize - GZIP_FULL_FLUSH_MARKER_SIZE + 1 -
+                                        nPos);
+        if (pFound == nullptr)
+            break;
+        nPos = static_cast<const char *>(pFound) - pabyData - 2;
+        if (memcmp(pabyData + nPos, GZIP_FULL_FLUSH_MARKER,
+                   GZIP_FULL_FLUSH_MARKER_SIZE) == 0)
+        {
+            return nPos;
+        }
+        ++nPos;
+    }
+    return std::string::npos;
+}
+
+class VSIGZipReadHandleMT final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIGZipReadHandleMT)
+
+    struct Job
+    {
+        std::mutex sMutex_{};
+        std::condition_variable sCond_{};
+        vsi_l_offset nCompressedOffset_ = 0;
+        size_t nCompressedSize_ = 0;
+        bool bStartsWithHeader_ = false;
+        bool bLastSegment_ = false;
+        std::string sCompressedData_{};
+
+        // Part of the output belonging to a single member.
+        struct Part
+        {
+            size_t nSize = 0;
+            uLong nCRC = 0;
+            bool bMemberEnd = false;
+            uLong nExpectedCRC = 0;
+            uLong nExpectedSize = 0;
+        };
+
+        std::string sUncompressedData_{};
+        std::vector<Part> aoParts_{};
+        // Whether inflation ended on a block or member boundary
+        bool bCleanEnd_ = false;
+        bool bTooLarge_ = false;
+        bool bOK_ = false;
+        bool bStarted_ = false;
+        bool bDone_ = false;
+    };
+
+    struct IndexEntry
+    {
+        vsi_l_offset nCompressedOffset;
+        vsi_l_offset nUncompressedOffset;
+        bool bStartsWithHeader;
+    };
+
+    VSIVirtualHandle *poBaseHandle_ = nullptr;
+    std::string osBaseFilename_{};
+    bool bBGZF_ = false;
+    CPLWorkerThreadPool *poPool_ = nullptr;
+    size_t nMaxJobs_ = 0;
+    // Number of segments inflated ahead of the one being read
+    size_t nReadAhead_ = 0;
+    std::list<std::shared_ptr<Job>> apoJobs_{};
+
+    // Splitting of the compressed stream
+    vsi_l_offset nSplitOffset_ = 0;  // file offset of sPending_
+    bool bSplitStartsWithHeader_ = true;
+    std::string sPending_{};
+    size_t nScanPos_ = 0;
+    // Size below which the next cut is not accepted
+    size_t nMinCut_ = 0;
+    bool bBaseEOF_ = false;
+
+    // Current segment
+    std::string sCurData_{};
+    vsi_l_offset nCurDataOffset_ = 0;
+    vsi_l_offset nNextDataOffset_ = 0;
+    vsi_l_offset nCurOffset_ = 0;
+    std::vector<IndexEntry> asIndex_{};
+
+    // CRC check of the member being read
+    bool bCRCValid_ = true;
+    uLong nMemberCRC_ = 0;
+    vsi_l_offset nMemberSize_ = 0;
+
+    bool bEOF_ = false;
+    bool bError_ = false;
+    bool bNotSplittable_ = false;
+    bool bEndReached_ = false;
+
+    // Sequential reader used for streams that cannot be split
+    std::unique_ptr<VSIGZipHandle> poSequential_{};
+
+    static void InflateSegment(Job *psJob);
+    static void InflateSegmentJob(void *inData);
+    static void WaitJob(Job *psJob);
+    bool SplitNextSegment(std::string &osSegment, bool &bStartsWithHeader,
+                          vsi_l_offset &nOffset);
+    void SubmitJobs(size_t nJobs);
+    void CancelJobs();
+    bool ConsumeNextSegment();
+    bool EnsureCurrentData();
+    void RestartAt(const IndexEntry &oEntry);
+    bool SwitchToSequential();
+
+  public:
+    VSIGZipReadHandleMT(VSIVirtualHandle *poBaseHandle,
+                        const std::string &osBaseFilename, bool bBGZF,
+                        CPLWorkerThreadPool *poPool, int nThreads);
+    ~VSIGZipReadHandleMT() override;
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Close() override;
+};
+
+// Segments are cut at the first boundary after that many compressed bytes.
+constexpr size_t GZIP_MT_MIN_SEGMENT_SIZE = 64 * 1024;
+// If no boundary is found in that many bytes, the stream is not splittable.
+constexpr size_t GZIP_MT_MAX_SEGMENT_SIZE = 64 * 1024 * 1024;
+// Highly compressed streams, whose segments inflate to more than that,
+// are read sequentially.
+constexpr size_t GZIP_MT_MAX_UNCOMPRESSED_SEGMENT_SIZE = 64 * 1024 * 1024;
+constexpr size_t GZIP_MT_READ_SIZE = 1024 * 1024;
+
+/************************************************************************/
+/*                        VSIGZipReadHandleMT()                         */
+/************************************************************************/
+
+VSIGZipReadHandleMT::VSIGZipReadHandleMT(VSIVirtualHandle *poBaseHandle,
+                                         const std::string &osBaseFilename,
+                                         bool bBGZF,
+                                         CPLWorkerThreadPool *poPool,
+                                         int nThreads)
+    : poBaseHandle_(poBaseHandle), osBaseFilename_(osBaseFilename),
+      bBGZF_(bBGZF), poPool_(poPool),
+      nMaxJobs_(static_cast<size_t>(nThreads) * 2), nReadAhead_(nMaxJobs_)
+{
+    poBaseHandle_->Seek(0, SEEK_SET);
+}
+
+/************************************************************************/
+/*                       ~VSIGZipReadHandleMT()                         */
+/************************************************************************/
+
+VSIGZipReadHandleMT::~VSIGZipReadHandleMT()
+{
+    VSIGZipReadHandleMT::Close();
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Close()
+{
+    CancelJobs();
+    poSequential_.reset();
+    int nRet = 0;
+    if (poBaseHandle_)
+    {
+        nRet = poBaseHandle_->Close();
+        delete poBaseHandle_;
+        poBaseHandle_ = nullptr;
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                           VSIGZipCRC32()                             */
+/************************************************************************/
+
+// crc32() on a buffer whose size may not fit in a uInt.
+
+static uLong VSIGZipCRC32(uLong nCRC, const GByte *pabyData, size_t nSize)
+{
+    while (nSize > 0)
+    {
+        const uInt nChunk = static_cast<uInt>(
+            std::min<size_t>(nSize, std::numeric_limits<uInt>::max()));
+        nCRC = crc32(nCRC, pabyData, nChunk);
+        pabyData += nChunk;
+        nSize -= nChunk;
+    }
+    return nCRC;
+}
+
+/************************************************************************/
+/*                        InflateSegmentJob()                           */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::InflateSegmentJob(void *inData)
+{
+    std::unique_ptr<std::shared_ptr<Job>> ppoJob(
+        static_cast<std::shared_ptr<Job> *>(inData));
+    Job *psJob = ppoJob->get();
+    {
+        std::lock_guard<std::mutex> oLock(psJob->sMutex_);
+        // Already run, or being run, by WaitJob(), or cancelled
+        if (psJob->bStarted_)
+            return;
+        psJob->bStarted_ = true;
+    }
+    InflateSegment(psJob);
+}
+
+/************************************************************************/
+/*                              WaitJob()                               */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::WaitJob(Job *psJob)
+{
+    // Inflate from this thread if no worker has picked the job yet, which
+    // may never happen if this thread is itself one of the busy workers of
+    // the global pool.
+    bool bRunHere = false;
+    {
+        std::lock_guard<std::mutex> oLock(psJob->sMutex_);
+        if (!psJob->bStarted_)
+        {
+            psJob->bStarted_ = true;
+            bRunHere = true;
+        }
+    }
+    if (bRunHere)
+        InflateSegment(psJob);
+
+    std::unique_lock<std::mutex> oLock(psJob->sMutex_);
+    while (!psJob->bDone_)
+        psJob->sCond_.wait(oLock);
+}
+
+/************************************************************************/
+/*                          InflateSegment()                            */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::InflateSegment(Job *psJob)
+{
+    const GByte *pabyIn =
+        reinterpret_cast<const GByte *>(psJob->sCompressedData_.data());
+    const size_t nInSize = psJob->sCompressedData_.size();
+    size_t nInPos = 0;
+    bool bOK = true;
+
+    if (psJob->bStartsWithHeader_)
+    {
+        size_t nBGZFBlockSize = 0;
+        const int nHeaderSize =
+            VSIGZipParseHeader(pabyIn, nInSize, &nBGZFBlockSize);
+        bOK = nHeaderSize > 0;
+        nInPos = bOK ? static_cast<size_t>(nHeaderSize) : 0;
+    }
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    bOK = bOK && inflateInit2(&sStream, -MAX_WBITS) == Z_OK;
+    bool bStreamInit = bOK;
+
+    std::string &osOut = psJob->sUncompressedData_;
+    const GByte *pabyOut = nullptr;
+    size_t nOutSize = 0;
+    size_t nPartStart = 0;
+    while (bOK)
+    {
+        if (osOut.size() - nOutSize < static_cast<size_t>(Z_BUFSIZE))
+        {
+            if (osOut.size() >= GZIP_MT_MAX_UNCOMPRESSED_SEGMENT_SIZE)
+            {
+                psJob->bTooLarge_ = true;
+                bOK = false;
+                break;
+            }
+            osOut.resize(std::min(
+                GZIP_MT_MAX_UNCOMPRESSED_SEGMENT_SIZE,
+                std::max(osOut.size() * 2, 4 * nInSize + Z_BUFSIZE)));
+        }
+        pabyOut = reinterpret_cast<const GByte *>(osOut.data());
+        sStream.next_in = const_cast<Bytef *>(pabyIn + nInPos);
+        sStream.avail_in = static_cast<uInt>(
+            std::min<size_t>(nInSize - nInPos, INT_MAX));
+        sStream.next_out = reinterpret_cast<Bytef *>(&osOut[nOutSize]);
+        sStream.avail_out = static_cast<uInt>(
+            std::min<size_t>(osOut.size() - nOutSize, INT_MAX));
+        const uInt nAvailInBefore = sStream.avail_in;
+        const uInt nAvailOutBefore = sStream.avail_out;
+        const int nRet = inflate(&sStream, Z_NO_FLUSH);
+        nInPos += nAvailInBefore - sStream.avail_in;
+        nOutSize += nAvailOutBefore - sStream.avail_out;
+
+        if (nRet == Z_STREAM_END)
+        {
+            // End of member: check trailer, and go on with the next one.
+            Job::Part oPart;
+            oPart.nSize = nOutSize - nPartStart;
+            oPart.nCRC = VSIGZipCRC32(0U, pabyOut + nPartStart, oPart.nSize);
+            oPart.bMemberEnd = true;
+            if (nInSize - nInPos < 8)
+            {
+                bOK = false;
+                break;
+            }
+            oPart.nExpectedCRC = CPL_LSBUINT32PTR(pabyIn + nInPos);
+            oPart.nExpectedSize = CPL_LSBUINT32PTR(pabyIn + nInPos + 4);
+            nInPos += 8;
+            psJob->aoParts_.push_back(oPart);
+            nPartStart = nOutSize;
+
+            size_t nBGZFBlockSize = 0;
+            const int nHeaderSize = VSIGZipParseHeader(
+                pabyIn + nInPos, nInSize - nInPos, &nBGZFBlockSize);
+            if (nHeaderSize <= 0)
+            {
+                // Trailing garbage is ignored, as done by gzip, but a header
+                // may also be continued in the next segment.
+                psJob->bCleanEnd_ = nInPos == nInSize || nHeaderSize < 0;
+                break;
+            }
+            nInPos += nHeaderSize;
+            bOK = inflateReset(&sStream) == Z_OK;
+        }
+        else if (nRet == Z_OK || nRet == Z_BUF_ERROR)
+        {
+            if (nInPos == nInSize && sStream.avail_out != 0)
+            {
+                // Out of input: this is a valid cut only if inflate() stopped
+                // right before a block header, on a byte boundary, as after
+                // a full flush.
+                psJob->bCleanEnd_ = (sStream.data_type & 0xff) == 128;
+                Job::Part oPart;
+                oPart.nSize = nOutSize - nPartStart;
+                oPart.nCRC =
+                    VSIGZipCRC32(0U, pabyOut + nPartStart, oPart.nSize);
+                psJob->aoParts_.push_back(oPart);
+                break;
+            }
+            if (nRet == Z_BUF_ERROR && sStream.avail_out != 0)
+                bOK = false;
+        }
+        else
+        {
+            bOK = false;
+        }
+    }
+    if (bStreamInit)
+        inflateEnd(&sStream);
+
+    osOut.resize(nOutSize);
+    psJob->sCompressedData_.clear();
+    psJob->sCompressedData_.shrink_to_fit();
+
+    std::lock_guard<std::mutex> oLock(psJob->sMutex_);
+    psJob->bOK_ = bOK;
+    psJob->bDone_ = true;
+    psJob->sCond_.notify_all();
+}
+
+/************************************************************************/
+/*                         SplitNextSegment()                           */
+/************************************************************************/
+
+// Extracts the next independently decodable segment of the compressed
+// stream. Returns false at the end of the stream, or if no boundary could be
+// found (bNotSplittable_ is then set).
+
+bool VSIGZipReadHandleMT::SplitNextSegment(std::string &osSegment,
+                                           bool &bStartsWithHeader,
+                                           vsi_l_offset &nOffset)
+{
+    // Right after a seek, cut at the first boundary to inflate as little as
+    // possible for what may be a random access.
+    const size_t nMinSegmentSize = std::max(
+        nMinCut_, nReadAhead_ == 0 ? 1 : GZIP_MT_MIN_SEGMENT_SIZE);
+    while (true)
+    {
+        size_t nCut = 0;
+        if (bBGZF_)
+        {
+            // Walk member headers, which give the size of each member.
+            while (nScanPos_ < sPending_.size())
+            {
+                size_t nBlockSize = 0;
+                const int nHeaderSize = VSIGZipParseHeader(
+                    reinterpret_cast<const GByte *>(sPending_.data()) +
+                        nScanPos_,
+                    sPending_.size() - nScanPos_, &nBlockSize);
+                if (nHeaderSize == 0 && !bBaseEOF_)
+                    break;
+                if (nHeaderSize <= 0 || nBlockSize == 0)
+                {
+                    // Trailing garbage or non-BGZF member: the inflating
+                    // job will deal with it.
+                    nScanPos_ = sPending_.size();
+                    if (!bBaseEOF_)
+                        break;
+                    continue;
+                }
+                if (nScanPos_ + nBlockSize > sPending_.size() && !bBaseEOF_)
+                    break;
+                nScanPos_ = std::min(nScanPos_ + nBlockSize, sPending_.size());
+                if (nScanPos_ >= nMinSegmentSize)
+                {
+                    nCut = nScanPos_;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // Look for full flush markers, far enough from the start.
+            while (true)
+            {
+                const size_t nPos = VSIGZipFindFullFlushMarker(
+                    sPending_.data(), sPending_.size(), nScanPos_);
+                if (nPos == std::string::npos)
+                {
+                    // A marker may start in the last bytes.
+                    if (sPending_.size() >= GZIP_FULL_FLUSH_MARKER_SIZE)
+                        nScanPos_ = std::max(nScanPos_,
+                                             sPending_.size() -
+                                                 GZIP_FULL_FLUSH_MARKER_SIZE +
+                                                 1);
+                    break;
+                }
+                nScanPos_ = nPos + GZIP_FULL_FLUSH_MARKER_SIZE;
+                if (nScanPos_ >= nMinSegmentSize)
+                {
+                    nCut = nScanPos_;
+                    break;
+                }
+            }
+        }
+
+        if (nCut == 0 && bBaseEOF_)
+            nCut = sPending_.size();
+
+        if (nCut > 0)
+        {
+            nOffset = nSplitOffset_;
+            bStartsWithHeader = bSplitStartsWithHeader_;
+            osSegment.assign(sPending_.data(), nCut);
+            sPending_.erase(0, nCut);
+            nSplitOffset_ += nCut;
+            nScanPos_ = 0;
+            nMinCut_ = 0;
+            bSplitStartsWithHeader_ = bBGZF_;
+            return true;
+        }
+        if (bBaseEOF_)
+            return false;
+
+        if (sPending_.size() >= GZIP_MT_MAX_SEGMENT_SIZE)
+        {
+            CPLDebug("GZIP",
+                     "No split point found in %s: switching to sequential "
+                     "decompression",
+                     osBaseFilename_.c_str());
+            bNotSplittable_ = true;
+            return false;
+        }
+
+        const size_t nReadSize =
+            nReadAhead_ == 0 ? static_cast<size_t>(Z_BUFSIZE)
+                             : GZIP_MT_READ_SIZE;
+        const size_t nOldSize = sPending_.size();
+        sPending_.resize(nOldSize + nReadSize);
+        const size_t nRead =
+            poBaseHandle_->Read(&sPending_[nOldSize], 1, nReadSize);
+        sPending_.resize(nOldSize + nRead);
+        if (nRead < nReadSize)
+            bBaseEOF_ = true;
+    }
+}
+
+/************************************************************************/
+/*                            SubmitJobs()                              */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::SubmitJobs(size_t nJobs)
+{
+    while (apoJobs_.size() < nJobs && !bEndReached_ && !bError_ &&
+           !bNotSplittable_)
+    {
+        auto poJob = std::make_shared<Job>();
+        if (!SplitNextSegment(poJob->sCompressedData_,
+                              poJob->bStartsWithHeader_,
+                              poJob->nCompressedOffset_))
+        {
+            if (!bNotSplittable_)
+                bEndReached_ = true;
+            break;
+        }
+        poJob->nCompressedSize_ = poJob->sCompressedData_.size();
+        poJob->bLastSegment_ = bBaseEOF_ && sPending_.empty();
+        apoJobs_.push_back(poJob);
+        auto ppoJob = new std::shared_ptr<Job>(poJob);
+        if (!poPool_->SubmitJob(InflateSegmentJob, ppoJob))
+        {
+            // Run by WaitJob()
+            delete ppoJob;
+        }
+    }
+}
+
+/************************************************************************/
+/*                            CancelJobs()                              */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::CancelJobs()
+{
+    // Jobs not started yet are skipped by InflateSegmentJob(). Running ones
+    // only access their own Job instance, which they share.
+    for (const auto &poJob : apoJobs_)
+    {
+        std::lock_guard<std::mutex> oLock(poJob->sMutex_);
+        poJob->bStarted_ = true;
+    }
+    apoJobs_.clear();
+}
+
+/************************************************************************/
+/*                        ConsumeNextSegment()                          */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::ConsumeNextSegment()
+{
+    // After a seek, segments are only inflated ahead once reading goes on
+    // sequentially, and the read-ahead depth then doubles at each segment.
+    if (!sCurData_.empty())
+        nReadAhead_ = std::min(nMaxJobs_, std::max<size_t>(1, nReadAhead_ * 2));
+
+    std::shared_ptr<Job> poJob;
+    while (true)
+    {
+        SubmitJobs(std::max<size_t>(1, nReadAhead_));
+        if (apoJobs_.empty())
+            return bNotSplittable_ && !bError_ ? SwitchToSequential() : false;
+
+        poJob = std::move(apoJobs_.front());
+        apoJobs_.pop_front();
+        WaitJob(poJob.get());
+        if (!poJob->bOK_ || poJob->bCleanEnd_ || poJob->bLastSegment_)
+            break;
+
+        // The segment was cut within a block, at bytes looking like a full
+        // flush marker: split again from its start, with a cut further away.
+        CancelJobs();
+        nSplitOffset_ = poJob->nCompressedOffset_;
+        bSplitStartsWithHeader_ = poJob->bStartsWithHeader_;
+        sPending_.clear();
+        nScanPos_ = 0;
+        nMinCut_ = poJob->nCompressedSize_ + 1;
+        bBaseEOF_ = false;
+        bEndReached_ = false;
+        poBaseHandle_->Seek(nSplitOffset_, SEEK_SET);
+    }
+
+    if (poJob->bTooLarge_)
+    {
+        CPLDebug("GZIP",
+                 "Segment at offset " CPL_FRMT_GUIB " of %s inflates to more "
+                 "than %d MB: switching to sequential decompression",
+                 poJob->nCompressedOffset_, osBaseFilename_.c_str(),
+                 static_cast<int>(GZIP_MT_MAX_UNCOMPRESSED_SEGMENT_SIZE >> 20));
+        bNotSplittable_ = true;
+        return SwitchToSequential();
+    }
+    if (poJob->bOK_ && poJob->bLastSegment_ &&
+        (poJob->aoParts_.empty() || !poJob->aoParts_.back().bMemberEnd))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "In file %s, truncated gzip data",
+                 osBaseFilename_.c_str());
+        bError_ = true;
+        return false;
+    }
+    if (!poJob->bOK_)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "In file %s, corrupted gzip data at offset " CPL_FRMT_GUIB,
+                 osBaseFilename_.c_str(), poJob->nCompressedOffset_);
+        CancelJobs();
+        bError_ = true;
+        bEndReached_ = true;
+        return false;
+    }
+
+    if (asIndex_.empty() ||
+        poJob->nCompressedOffset_ > asIndex_.back().nCompressedOffset)
+    {
+        asIndex_.push_back(IndexEntry{poJob->nCompressedOffset_,
+                                      nNextDataOffset_,
+                                      poJob->bStartsWithHeader_});
+    }
+    sCurData_ = std::move(poJob->sUncompressedData_);
+    nCurDataOffset_ = nNextDataOffset_;
+    nNextDataOffset_ += sCurData_.size();
+
+    for (const auto &oPart : poJob->aoParts_)
+    {
+        nMemberCRC_ = crc32_combine(nMemberCRC_, oPart.nCRC,
+                                    static_cast<z_off_t>(oPart.nSize));
+        nMemberSize_ += oPart.nSize;
+        if (!oPart.bMemberEnd)
+            continue;
+        if (bCRCValid_ &&
+            (nMemberCRC_ != oPart.nExpectedCRC ||
+             static_cast<uLong>(nMemberSize_ & 0xffffffffU) !=
+                 oPart.nExpectedSize))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "In file %s, CRC error in gzip member ending before "
+                     "offset " CPL_FRMT_GUIB,
+                     osBaseFilename_.c_str(), nNextDataOffset_);
+            CancelJobs();
+            bError_ = true;
+            bEndReached_ = true;
+            return false;
+        }
+        bCRCValid_ = true;
+        nMemberCRC_ = 0;
+        nMemberSize_ = 0;
+    }
+
+    SubmitJobs(nReadAhead_);
+    return true;
+}
+
+/************************************************************************/
+/*                             RestartAt()                              */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::RestartAt(const IndexEntry &oEntry)
+{
+    CancelJobs();
+    nReadAhead_ = 0;
+    bNotSplittable_ = false;
+    sCurData_.clear();
+    nCurDataOffset_ = oEntry.nUncompressedOffset;
+    nNextDataOffset_ = oEntry.nUncompressedOffset;
+    nSplitOffset_ = oEntry.nCompressedOffset;
+    bSplitStartsWithHeader_ = oEntry.bStartsWithHeader;
+    sPending_.clear();
+    nScanPos_ = 0;
+    nMinCut_ = 0;
+    bBaseEOF_ = false;
+    bEndReached_ = false;
+    // Members are only checked when read from their start.
+    bCRCValid_ = oEntry.bStartsWithHeader;
+    nMemberCRC_ = 0;
+    nMemberSize_ = 0;
+    poBaseHandle_->Seek(oEntry.nCompressedOffset, SEEK_SET);
+}
+
+/************************************************************************/
+/*                        SwitchToSequential()                          */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::SwitchToSequential()
+{
+    if (poSequential_)
+        return false;
+    CancelJobs();
+    poBaseHandle_->Seek(0, SEEK_SET);
+    poSequential_.reset(
+        new VSIGZipHandle(poBaseHandle_, osBaseFilename_.c_str()));
+    // Now owned by poSequential_
+    poBaseHandle_ = nullptr;
+    if (!poSequential_->IsInitOK())
+    {
+        poSequential_.reset();
+        return false;
+    }
+    return poSequential_->Seek(nCurOffset_, SEEK_SET) == 0;
+}
+
+/************************************************************************/
+/*                         EnsureCurrentData()                          */
+/************************************************************************/
+
+// Makes sCurData_ hold the segment containing nCurOffset_. Returns false at
+// end of stream or on error.
+
+bool VSIGZipReadHandleMT::EnsureCurrentData()
+{
+    if (nCurOffset_ >= nCurDataOffset_ &&
+        nCurOffset_ < nCurDataOffset_ + sCurData_.size())
+    {
+        return true;
+    }
+
+    if (bError_)
+        return false;
+
+    // Jump to the indexed segment containing nCurOffset_, unless it is the
+    // next one to be consumed anyway. When nCurOffset_ is after the last
+    // indexed segment, just go on inflating forward.
+    auto oIter = std::upper_bound(
+        asIndex_.begin(), asIndex_.end(), nCurOffset_,
+        [](vsi_l_offset nOffset, const IndexEntry &oEntry)
+        { return nOffset < oEntry.nUncompressedOffset; });
+    if (oIter != asIndex_.begin())
+    {
+        const bool bAfterLastIndexed = oIter == asIndex_.end();
+        --oIter;
+        if ((nCurOffset_ < nCurDataOffset_ || !bAfterLastIndexed) &&
+            oIter->nUncompressedOffset != nNextDataOffset_)
+        {
+            RestartAt(*oIter);
+        }
+    }
+
+    while (!(nCurOffset_ >= nCurDataOffset_ &&
+             nCurOffset_ < nCurDataOffset_ + sCurData_.size()))
+    {
+        if (poSequential_ || !ConsumeNextSegment())
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIGZipReadHandleMT::Read(void *pBuffer, size_t nSize, size_t nMemb)
+{
+    if (poSequential_)
+        return poSequential_->Read(pBuffer, nSize, nMemb);
+
+    const size_t nToRead = nSize * nMemb;
+    size_t nRead = 0;
+    while (nRead < nToRead)
+    {
+        if (!EnsureCurrentData())
+        {
+            if (poSequential_)
+            {
+                nRead += poSequential_->Read(
+                    static_cast<GByte *>(pBuffer) + nRead, 1, nToRead - nRead);
+                return nSize ? nRead / nSize : 0;
+            }
+            bEOF_ = true;
+            break;
+        }
+        const size_t nPosInData =
+            static_cast<size_t>(nCurOffset_ - nCurDataOffset_);
+        const size_t nChunk =
+            std::min(nToRead - nRead, sCurData_.size() - nPosInData);
+        memcpy(static_cast<GByte *>(pBuffer) + nRead,
+               sCurData_.data() + nPosInData, nChunk);
+        nRead += nChunk;
+        nCurOffset_ += nChunk;
+    }
+    return nSize ? nRead / nSize : 0;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    if (poSequential_)
+        return poSequential_->Seek(nOffset, nWhence);
+
+    bEOF_ = false;
+    if (nWhence == SEEK_SET)
+        nCurOffset_ = nOffset;
+    else if (nWhence == SEEK_CUR)
+        nCurOffset_ += nOffset;
+    else
+    {
+        // The uncompressed size is only known once all data is inflated.
+        while (!bEndReached_ || !apoJobs_.empty())
+        {
+            if (!ConsumeNextSegment())
+                break;
+        }
+        if (poSequential_)
+            return poSequential_->Seek(nOffset, nWhence);
+        if (bError_)
+            return -1;
+        nCurOffset_ = nNextDataOffset_ + nOffset;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIGZipReadHandleMT::Tell()
+{
+    if (poSequential_)
+        return poSequential_->Tell();
+    return nCurOffset_;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIGZipReadHandleMT::Write(const void * /* pBuffer */,
+                                  size_t /* nSize */, size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFWriteL is not supported on GZip streams");
+    return 0;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Eof()
+{
+    if (poSequential_)
+        return poSequential_->Eof();
+    return bEOF_;
+}
+
+/************************************************************************/
+/*                      VSICreateGZipReadableMT()                       */
+/************************************************************************/
+
+// Returns a parallel reader if GDAL_NUM_THREADS allows it and the start of
+// the file shows that it is made of independently inflatable parts.
+// Otherwise returns nullptr, and the caller uses VSIGZipHandle.
+
+static VSIVirtualHandle *
+VSICreateGZipReadableMT(VSIFilesystemHandler *poFSHandler,
+                        const char *pszBaseFilename)
+{
+    const int nThreads =
+        CPLGetNumThreads(nullptr, nullptr, /* nMaxThreads = */ 128);
+    if (nThreads <= 1)
+        return nullptr;
+
+    VSIVirtualHandle *poBaseHandle = poFSHandler->Open(pszBaseFilename, "rb");
+    if (poBaseHandle == nullptr)
+        return nullptr;
+
+    // Probe the first megabytes for BGZF headers or full flush markers.
+    std::string osProbe(4 * GZIP_MT_READ_SIZE, '\0');
+    osProbe.resize(poBaseHandle->Read(&osProbe[0], 1, osProbe.size()));
+    size_t nBGZFBlockSize = 0;
+    const int nHeaderSize =
+        VSIGZipParseHeader(reinterpret_cast<const GByte *>(osProbe.data()),
+                           osProbe.size(), &nBGZFBlockSize);
+    bool bBGZF = false;
+    bool bSplittable = false;
+    if (nHeaderSize > 0)
+    {
+        bBGZF = nBGZFBlockSize != 0;
+        bSplittable = bBGZF || VSIGZipFindFullFlushMarker(
+                                   osProbe.data(), osProbe.size(),
+                                   nHeaderSize) != std::string::npos;
+    }
+    if (!bSplittable)
+    {
+        poBaseHandle->Close();
+        delete poBaseHandle;
+        return nullptr;
+    }
+    CPLWorkerThreadPool *poPool = CPLGetGlobalThreadPool(nThreads);
+    if (poPool == nullptr)
+    {
+        poBaseHandle->Close();
+        delete poBaseHandle;
+        return nullptr;
+    }
+    CPLDebug("GZIP", "Using %d threads to inflate %s (%s)", nThreads,
+             pszBaseFilename, bBGZF ? "BGZF" : "full flush markers");
+    return new VSIGZipReadHandleMT(poBaseHandle, pszBaseFilename, bBGZF,
+                                   poPool, nThreads);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIGZipFilesystemHandler                       */
@@ -2984,6 +3968,14 @@ VSIGZipFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
     /*      Otherwise we are in the read access case.                       */
     /* -------------------------------------------------------------------- */
 
+    if (EQUAL(pszAccess, "rb"))
+    {
+        VSIVirtualHandle *poMTHandle = VSICreateGZipReadableMT(
+            poFSHandler, pszFilename + strlen("/vsigzip/"));
+        if (poMTHandle)
+            return poMTHandle;
+    }
+
     VSIGZipHandle *poGZIPHandle = OpenGZipReadOnly(pszFilename, pszAccess);
     if (poGZIPHandle)
         // Wrap the VSIGZipHandle inside a buffered reader that will
@@ -3231,8 +4223,9 @@ const char *VSIGZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression, and for "
+           "decompression of BGZF files and files with independent parts. "
+           "Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
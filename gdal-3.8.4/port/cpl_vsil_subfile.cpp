@@ -37,6 +37,7 @@
 #include <fcntl.h>
 #endif
 #include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_multiproc.h"
@@ -65,9 +66,23 @@ class VSISubFileHandle final : public VSIVirtualHandle
     int Seek(vsi_l_offset nOffset, int nWhence) override;
     vsi_l_offset Tell() override;
     size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+    std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        const VSIAsyncReadCallback &fnCompletion) override;
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
     size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
     int Eof() override;
     int Close() override;
+
+  private:
+    bool GetBaseOffsets(int nRanges, const vsi_l_offset *panOffsets,
+                        const size_t *panSizes,
+                        std::vector<vsi_l_offset> &anBaseOffsets) const;
 };
 
 /************************************************************************/
@@ -221,6 +236,81 @@ size_t VSISubFileHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
     return nRet;
 }
 
+/************************************************************************/
+/*                          GetBaseOffsets()                            */
+/************************************************************************/
+
+// Translates offsets of the subfile into offsets of the base file. Returns
+// false if a range extends beyond the subfile, in which case it must be
+// served by Read() to get the truncation behavior.
+
+bool VSISubFileHandle::GetBaseOffsets(
+    int nRanges, const vsi_l_offset *panOffsets, const size_t *panSizes,
+    std::vector<vsi_l_offset> &anBaseOffsets) const
+{
+    anBaseOffsets.resize(nRanges);
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (nSubregionSize != 0 &&
+            (panOffsets[i] > nSubregionSize ||
+             panSizes[i] > nSubregionSize - panOffsets[i]))
+        {
+            return false;
+        }
+        if (panOffsets[i] >
+            std::numeric_limits<vsi_l_offset>::max() - nSubregionOffset)
+        {
+            return false;
+        }
+        anBaseOffsets[i] = nSubregionOffset + panOffsets[i];
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+int VSISubFileHandle::ReadMultiRange(int nRanges, void **ppData,
+                                     const vsi_l_offset *panOffsets,
+                                     const size_t *panSizes)
+{
+    std::vector<vsi_l_offset> anBaseOffsets;
+    if (!GetBaseOffsets(nRanges, panOffsets, panSizes, anBaseOffsets))
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    return fp->ReadMultiRange(nRanges, ppData, anBaseOffsets.data(),
+                              panSizes);
+}
+
+/************************************************************************/
+/*                        ReadMultiRangeAsync()                         */
+/************************************************************************/
+
+std::unique_ptr<VSIAsyncReadRequest> VSISubFileHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, const VSIAsyncReadCallback &fnCompletion)
+{
+    std::vector<vsi_l_offset> anBaseOffsets;
+    if (!GetBaseOffsets(nRanges, panOffsets, panSizes, anBaseOffsets))
+        return VSIVirtualHandle::ReadMultiRangeAsync(
+            nRanges, ppData, panOffsets, panSizes, fnCompletion);
+    return fp->ReadMultiRangeAsync(nRanges, ppData, anBaseOffsets.data(),
+                                   panSizes, fnCompletion);
+}
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+void VSISubFileHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                                  const size_t *panSizes)
+{
+    std::vector<vsi_l_offset> anBaseOffsets;
+    if (GetBaseOffsets(nRanges, panOffsets, panSizes, anBaseOffsets))
+        fp->AdviseRead(nRanges, anBaseOffsets.data(), panSizes);
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
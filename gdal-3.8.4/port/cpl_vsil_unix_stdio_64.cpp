@@ -255,7 +255,16 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     bool HasPRead() const override;
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
 #endif
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+    std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        const VSIAsyncReadCallback &fnCompletion) override;
 };
 
 /************************************************************************/
@@ -661,7 +670,115 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
     return pread(fileno(fp), pBuffer, nSize, static_cast<off_t>(nOffset));
 #endif
 }
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    // pread() bypasses the FILE* buffer, which may hold pending writes.
+    if (!bReadOnly)
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+
+    // Queue all ranges to the kernel first, so that the block layer can
+    // service them concurrently, and then collect them with pread().
+    if (nRanges > 1)
+        AdviseRead(nRanges, panOffsets, panSizes);
+
+    for (int i = 0; i < nRanges; ++i)
+    {
+        GByte *pabyData = static_cast<GByte *>(ppData[i]);
+        size_t nRemaining = panSizes[i];
+        vsi_l_offset nOffset = panOffsets[i];
+        while (nRemaining > 0)
+        {
+#ifdef HAVE_PREAD64
+            const ssize_t nRead =
+                pread64(fileno(fp), pabyData, nRemaining, nOffset);
+#else
+            const ssize_t nRead = pread(fileno(fp), pabyData, nRemaining,
+                                        static_cast<off_t>(nOffset));
+#endif
+            if (nRead < 0 && errno == EINTR)
+                continue;
+            if (nRead <= 0)
+                return -1;
+            pabyData += nRead;
+            nRemaining -= static_cast<size_t>(nRead);
+            nOffset += static_cast<vsi_l_offset>(nRead);
+        }
+#ifdef VSI_COUNT_BYTES_READ
+        nTotalBytesRead += panSizes[i];
+#endif
+    }
+    return 0;
+}
+#endif
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+void VSIUnixStdioHandle::AdviseRead(
+#ifndef POSIX_FADV_WILLNEED
+    CPL_UNUSED
+#endif
+    int nRanges,
+#ifndef POSIX_FADV_WILLNEED
+    CPL_UNUSED
+#endif
+    const vsi_l_offset *panOffsets,
+#ifndef POSIX_FADV_WILLNEED
+    CPL_UNUSED
+#endif
+    const size_t *panSizes)
+{
+#ifdef POSIX_FADV_WILLNEED
+    // Start asynchronous read-ahead of all ranges at once. Adjacent ranges
+    // are coalesced to limit the number of system calls.
+    const int fd = fileno(fp);
+    int i = 0;
+    while (i < nRanges)
+    {
+        const vsi_l_offset nStart = panOffsets[i];
+        vsi_l_offset nEnd = nStart + panSizes[i];
+        ++i;
+        while (i < nRanges && panOffsets[i] == nEnd)
+        {
+            nEnd += panSizes[i];
+            ++i;
+        }
+        if (static_cast<vsi_l_offset>(static_cast<off_t>(nStart)) != nStart ||
+            static_cast<vsi_l_offset>(static_cast<off_t>(nEnd - nStart)) !=
+                nEnd - nStart)
+        {
+            break;
+        }
+        posix_fadvise(fd, static_cast<off_t>(nStart),
+                      static_cast<off_t>(nEnd - nStart), POSIX_FADV_WILLNEED);
+    }
 #endif
+}
+
+/************************************************************************/
+/*                        ReadMultiRangeAsync()                         */
+/************************************************************************/
+
+std::unique_ptr<VSIAsyncReadRequest> VSIUnixStdioHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, const VSIAsyncReadCallback &fnCompletion)
+{
+    // Have the kernel start fetching the ranges right away, so that the
+    // worker thread mostly collects them from the page cache.
+    if (bReadOnly)
+        AdviseRead(nRanges, panOffsets, panSizes);
+    return VSIVirtualHandle::ReadMultiRangeAsync(nRanges, ppData, panOffsets,
+                                                 panSizes, fnCompletion);
+}
 
 /************************************************************************/
 /* ==================================================================== */
@@ -29,20 +29,18 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <memory>
+#include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
 
-struct CPLWorkerThreadJob
-{
-    CPLThreadFunc pfnFunc;
-    void *pData;
-};
-
-static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
+static thread_local CPLWorkerThread *threadLocalCurrentWorkerThread = nullptr;
 
 /************************************************************************/
 /*                         CPLWorkerThreadPool()                        */
@@ -72,18 +70,13 @@ CPLWorkerThreadPool::~CPLWorkerThreadPool()
     {
         std::lock_guard<std::mutex> oGuard(m_mutex);
         eState = CPLWTS_STOP;
+        m_cvWorkers.notify_all();
     }
 
     for (auto &wt : aWT)
     {
-        {
-            std::lock_guard<std::mutex> oGuard(wt->m_mutex);
-            wt->m_cv.notify_one();
-        }
         CPLJoinThread(wt->hThread);
     }
-
-    CPLListDestroy(psWaitingWorkerThreadsList);
 }
 
 /************************************************************************/
@@ -95,153 +88,189 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
     CPLWorkerThread *psWT = static_cast<CPLWorkerThread *>(user_data);
     CPLWorkerThreadPool *poTP = psWT->poTP;
 
-    threadLocalCurrentThreadPool = poTP;
+    threadLocalCurrentWorkerThread = psWT;
 
     if (psWT->pfnInitFunc)
         psWT->pfnInitFunc(psWT->pInitData);
 
+    {
+        std::lock_guard<std::mutex> oGuard(poTP->m_mutex);
+        poTP->m_nStartedThreads++;
+        poTP->m_cv.notify_all();
+    }
+
     while (true)
     {
-        CPLWorkerThreadJob *psJob = poTP->GetNextJob(psWT);
-        if (psJob == nullptr)
-            break;
+        // Read before looking for jobs, so that a job submitted afterwards
+        // prevents from sleeping.
+        const unsigned nJobsSubmitted = poTP->m_nJobsSubmitted;
 
-        if (psJob->pfnFunc)
+        CPLWorkerThreadJob sJob;
+        if (poTP->TryGetJob(psWT, nullptr, sJob))
         {
-            psJob->pfnFunc(psJob->pData);
+#if DEBUG_VERBOSE
+            CPLDebug("JOB", "%p got a job", psWT);
+#endif
+            poTP->RunJob(sJob);
+            continue;
         }
-        CPLFree(psJob);
+
+        std::unique_lock<std::mutex> oGuard(poTP->m_mutex);
+        if (poTP->eState == CPLWTS_STOP)
+            break;
 #if DEBUG_VERBOSE
-        CPLDebug("JOB", "%p finished a job", psWT);
+        CPLDebug("JOB", "%p sleeping", psWT);
 #endif
-        poTP->DeclareJobFinished();
+        poTP->m_nIdleWorkerThreads++;
+        while (poTP->m_nJobsSubmitted == nJobsSubmitted &&
+               poTP->eState != CPLWTS_STOP)
+        {
+            poTP->m_cvWorkers.wait(oGuard);
+        }
+        // PushJob() already removed reserved threads from the idle count.
+        if (poTP->m_nReservedWorkerThreads > 0)
+            poTP->m_nReservedWorkerThreads--;
+        else
+            poTP->m_nIdleWorkerThreads--;
     }
 }
 
 /************************************************************************/
-/*                             SubmitJob()                              */
+/*                        StartThreadIfNeeded()                         */
 /************************************************************************/
 
-/** Queue a new job.
- *
- * @param pfnFunc Function to run for the job.
- * @param pData User data to pass to the job function.
- * @return true in case of success.
- */
-bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
+// Starts a new thread if less than m_nMaxThreads are running.
+// Must be called with m_mutex held.
+bool CPLWorkerThreadPool::StartThreadIfNeeded()
+{
+    if (static_cast<int>(aWT.size()) >= m_nMaxThreads)
+        return true;
+
+    // CPLDebug("CPL", "Starting new thread...");
+    std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
+    wt->poTP = this;
+    wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
+    if (wt->hThread == nullptr)
+        return !aWT.empty();
+    aWT.emplace_back(std::move(wt));
+    m_nThreadCount = static_cast<int>(aWT.size());
+    return true;
+}
+
+/************************************************************************/
+/*                              PushJob()                               */
+/************************************************************************/
+
+// Queues a job. Jobs submitted from a worker thread of this pool go to the
+// local deque of that thread, where other threads may steal them.
+bool CPLWorkerThreadPool::PushJob(CPLWorkerThreadJob &&sJob)
 {
     CPLAssert(m_nMaxThreads > 0);
 
-    bool bMustIncrementWaitingWorkerThreadsAfterSubmission = false;
-    if (threadLocalCurrentThreadPool == this)
+    CPLWorkerThread *psWT = threadLocalCurrentWorkerThread;
+    if (psWT != nullptr && psWT->poTP == this)
     {
-        // If there are waiting threads or we have not started all allowed
-        // threads, we can submit this job asynchronously
+        // The caller might block waiting for the job by other means than
+        // CPLJobQueue::WaitCompletion(), so only queue it if an idle thread,
+        // or a new one, can be reserved to run it.
+        bool bReserved = false;
         {
-            std::unique_lock<std::mutex> oGuard(m_mutex);
-            if (nWaitingWorkerThreads > 0 ||
-                static_cast<int>(aWT.size()) < m_nMaxThreads)
+            std::lock_guard<std::mutex> oGuard(m_mutex);
+            if (m_nIdleWorkerThreads > 0)
+            {
+                m_nIdleWorkerThreads--;
+                m_nReservedWorkerThreads++;
+                bReserved = true;
+            }
+            else
             {
-                bMustIncrementWaitingWorkerThreadsAfterSubmission = true;
-                nWaitingWorkerThreads--;
+                const size_t nThreadsBefore = aWT.size();
+                StartThreadIfNeeded();
+                bReserved = aWT.size() > nThreadsBefore;
             }
         }
-        if (!bMustIncrementWaitingWorkerThreadsAfterSubmission)
+
+        nPendingJobs++;
+        if (!bReserved)
         {
-            // otherwise there is a risk of deadlock, so execute synchronously.
-            pfnFunc(pData);
+            // Otherwise execute it synchronously to avoid a deadlock.
+            RunJob(sJob);
             return true;
         }
-    }
-
-    CPLWorkerThreadJob *psJob = static_cast<CPLWorkerThreadJob *>(
-        VSI_MALLOC_VERBOSE(sizeof(CPLWorkerThreadJob)));
-    if (psJob == nullptr)
-    {
-        if (bMustIncrementWaitingWorkerThreadsAfterSubmission)
         {
-            std::unique_lock<std::mutex> oGuard(m_mutex);
-            nWaitingWorkerThreads++;
+            std::lock_guard<std::mutex> oGuard(psWT->m_mutex);
+            psWT->m_aoJobs.push_back(std::move(sJob));
         }
-        return false;
     }
-    psJob->pfnFunc = pfnFunc;
-    psJob->pData = pData;
-
-    CPLList *psItem =
-        static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-    if (psItem == nullptr)
+    else
     {
-        VSIFree(psJob);
-        if (bMustIncrementWaitingWorkerThreadsAfterSubmission)
-        {
-            std::unique_lock<std::mutex> oGuard(m_mutex);
-            nWaitingWorkerThreads++;
-        }
-        return false;
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        if (!StartThreadIfNeeded())
+            return false;
+        nPendingJobs++;
+        m_aoJobQueue.push_back(std::move(sJob));
     }
-    psItem->pData = psJob;
 
-    std::unique_lock<std::mutex> oGuard(m_mutex);
+    NotifyNewJobs(1);
+    return true;
+}
 
-    if (bMustIncrementWaitingWorkerThreadsAfterSubmission)
-        nWaitingWorkerThreads++;
+/************************************************************************/
+/*                           NotifyNewJobs()                            */
+/************************************************************************/
 
-    if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+// Must be called after queuing jobs, without m_mutex held.
+void CPLWorkerThreadPool::NotifyNewJobs(unsigned nJobs)
+{
+    m_nJobsSubmitted += nJobs;
+    // Sleeping threads increment those counters with m_mutex held before
+    // checking m_nJobsSubmitted, so none of them can be missed.
+    if (m_nSleepingHelpers > 0)
     {
-        // CPLDebug("CPL", "Starting new thread...");
-        std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
-        wt->pfnInitFunc = nullptr;
-        wt->pInitData = nullptr;
-        wt->poTP = this;
-        wt->bMarkedAsWaiting = false;
-        wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-        if (wt->hThread == nullptr)
-        {
-            VSIFree(psJob);
-            VSIFree(psItem);
-            return false;
-        }
-        else
-        {
-            aWT.emplace_back(std::move(wt));
-        }
+        // Helpers only run jobs of the queue they wait for, so wake up
+        // everyone to be sure that the new jobs are taken.
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_cvWorkers.notify_all();
     }
-
-    psItem->psNext = psJobQueue;
-    psJobQueue = psItem;
-    nPendingJobs++;
-
-    if (psWaitingWorkerThreadsList)
+    else if (m_nIdleWorkerThreads > 0 || m_nReservedWorkerThreads > 0)
     {
-        CPLWorkerThread *psWorkerThread =
-            static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
-
-        CPLAssert(psWorkerThread->bMarkedAsWaiting);
-        psWorkerThread->bMarkedAsWaiting = false;
-
-        CPLList *psNext = psWaitingWorkerThreadsList->psNext;
-        CPLList *psToFree = psWaitingWorkerThreadsList;
-        psWaitingWorkerThreadsList = psNext;
-        nWaitingWorkerThreads--;
-
-        // CPLAssert(
-        //   CPLListCount(psWaitingWorkerThreadsList) == nWaitingWorkerThreads);
-
-#if DEBUG_VERBOSE
-        CPLDebug("JOB", "Waking up %p", psWorkerThread);
-#endif
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        if (nJobs == 1)
+            m_cvWorkers.notify_one();
+        else
+            m_cvWorkers.notify_all();
+    }
+}
 
-        {
-            std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-            oGuard.unlock();
-            psWorkerThread->m_cv.notify_one();
-        }
+/************************************************************************/
+/*                             SubmitJob()                              */
+/************************************************************************/
 
-        CPLFree(psToFree);
-    }
+/** Queue a new job.
+ *
+ * @param pfnFunc Function to run for the job.
+ * @param pData User data to pass to the job function.
+ * @return true in case of success.
+ */
+bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
+{
+    CPLWorkerThreadJob sJob;
+    sJob.pfnFunc = pfnFunc;
+    sJob.pData = pData;
+    return PushJob(std::move(sJob));
+}
 
-    return true;
+/** Queue a new job.
+ *
+ * @param task Function to run for the job.
+ * @return true in case of success.
+ * @since GDAL 3.9
+ */
+bool CPLWorkerThreadPool::SubmitJob(std::function<void()> task)
+{
+    CPLWorkerThreadJob sJob;
+    sJob.task = std::move(task);
+    return PushJob(std::move(sJob));
 }
 
 /************************************************************************/
@@ -259,7 +288,8 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
 {
     CPLAssert(m_nMaxThreads > 0);
 
-    if (threadLocalCurrentThreadPool == this)
+    CPLWorkerThread *psWT = threadLocalCurrentWorkerThread;
+    if (psWT != nullptr && psWT->poTP == this)
     {
         // If SubmitJob() is called from a worker thread of this queue,
         // then synchronously run the task to avoid deadlock.
@@ -270,111 +300,148 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
         return true;
     }
 
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-
-    CPLList *psJobQueueInit = psJobQueue;
-    bool bRet = true;
-
-    for (size_t i = 0; i < apData.size(); i++)
     {
-        if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        for (size_t i = 0; i < apData.size(); i++)
         {
-            std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
-            wt->pfnInitFunc = nullptr;
-            wt->pInitData = nullptr;
-            wt->poTP = this;
-            wt->bMarkedAsWaiting = false;
-            wt->hThread =
-                CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-            if (wt->hThread == nullptr)
-            {
-                if (aWT.empty())
-                    return false;
-            }
-            else
-            {
-                aWT.emplace_back(std::move(wt));
-            }
+            if (!StartThreadIfNeeded())
+                return false;
         }
-
-        CPLWorkerThreadJob *psJob = static_cast<CPLWorkerThreadJob *>(
-            VSI_MALLOC_VERBOSE(sizeof(CPLWorkerThreadJob)));
-        if (psJob == nullptr)
+        for (size_t i = 0; i < apData.size(); i++)
         {
-            bRet = false;
-            break;
+            CPLWorkerThreadJob sJob;
+            sJob.pfnFunc = pfnFunc;
+            sJob.pData = apData[i];
+            m_aoJobQueue.push_back(std::move(sJob));
         }
-        psJob->pfnFunc = pfnFunc;
-        psJob->pData = apData[i];
+        nPendingJobs += static_cast<int>(apData.size());
+    }
 
-        CPLList *psItem =
-            static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-        if (psItem == nullptr)
-        {
-            VSIFree(psJob);
-            bRet = false;
-            break;
-        }
-        psItem->pData = psJob;
+    NotifyNewJobs(static_cast<unsigned>(apData.size()));
+    return true;
+}
 
-        psItem->psNext = psJobQueue;
-        psJobQueue = psItem;
-        nPendingJobs++;
-    }
+/************************************************************************/
+/*                              TryGetJob()                             */
+/************************************************************************/
 
-    if (!bRet)
+// Removes from aoJobs the oldest job that belongs to poQueue, or the oldest
+// job if poQueue is null.
+static bool TakeOldestJob(std::deque<CPLWorkerThreadJob> &aoJobs,
+                          const CPLJobQueue *poQueue, CPLWorkerThreadJob &sJob)
+{
+    for (auto oIter = aoJobs.begin(); oIter != aoJobs.end(); ++oIter)
     {
-        for (CPLList *psIter = psJobQueue; psIter != psJobQueueInit;)
+        if (poQueue == nullptr || oIter->poQueue == poQueue)
         {
-            CPLList *psNext = psIter->psNext;
-            VSIFree(psIter->pData);
-            VSIFree(psIter);
-            nPendingJobs--;
-            psIter = psNext;
+            sJob = std::move(*oIter);
+            aoJobs.erase(oIter);
+            return true;
         }
-        return false;
     }
+    return false;
+}
 
-    for (size_t i = 0; i < apData.size(); i++)
+// Looks for a job to run, without blocking: the most recent job of the local
+// deque of psWorkerThread, then the oldest job submitted from outside the
+// pool, then the oldest job of another worker thread. If poQueue is not null,
+// only jobs of that queue are considered.
+bool CPLWorkerThreadPool::TryGetJob(CPLWorkerThread *psWorkerThread,
+                                    const CPLJobQueue *poQueue,
+                                    CPLWorkerThreadJob &sJob)
+{
     {
-        if (psWaitingWorkerThreadsList && psJobQueue)
+        std::lock_guard<std::mutex> oGuard(psWorkerThread->m_mutex);
+        auto &aoJobs = psWorkerThread->m_aoJobs;
+        for (auto oIter = aoJobs.rbegin(); oIter != aoJobs.rend(); ++oIter)
         {
-            CPLWorkerThread *psWorkerThread;
-
-            psWorkerThread = static_cast<CPLWorkerThread *>(
-                psWaitingWorkerThreadsList->pData);
-
-            CPLAssert(psWorkerThread->bMarkedAsWaiting);
-            psWorkerThread->bMarkedAsWaiting = false;
+            if (poQueue == nullptr || oIter->poQueue == poQueue)
+            {
+                sJob = std::move(*oIter);
+                aoJobs.erase(std::next(oIter).base());
+                return true;
+            }
+        }
+    }
 
-            CPLList *psNext = psWaitingWorkerThreadsList->psNext;
-            CPLList *psToFree = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psNext;
-            nWaitingWorkerThreads--;
+    std::lock_guard<std::mutex> oGuard(m_mutex);
+    if (TakeOldestJob(m_aoJobQueue, poQueue, sJob))
+        return true;
+    for (auto &wt : aWT)
+    {
+        if (wt.get() == psWorkerThread)
+            continue;
+        std::lock_guard<std::mutex> oGuardWT(wt->m_mutex);
+        if (TakeOldestJob(wt->m_aoJobs, poQueue, sJob))
+            return true;
+    }
+    return false;
+}
 
-            // CPLAssert(
-            //    CPLListCount(psWaitingWorkerThreadsList) ==
-            //    nWaitingWorkerThreads);
+/************************************************************************/
+/*                               RunJob()                               */
+/************************************************************************/
 
+void CPLWorkerThreadPool::RunJob(CPLWorkerThreadJob &sJob)
+{
+    if (sJob.task)
+        sJob.task();
+    else if (sJob.pfnFunc)
+        sJob.pfnFunc(sJob.pData);
+    if (sJob.poQueue)
+        sJob.poQueue->DeclareJobFinished();
 #if DEBUG_VERBOSE
-            CPLDebug("JOB", "Waking up %p", psWorkerThread);
+    CPLDebug("JOB", "%p finished a job", threadLocalCurrentWorkerThread);
 #endif
-            {
-                std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-                oGuard.unlock();
-                psWorkerThread->m_cv.notify_one();
-            }
+    DeclareJobFinished();
+}
 
-            CPLFree(psToFree);
-            oGuard.lock();
+/************************************************************************/
+/*                        HelpUntilCompletion()                         */
+/************************************************************************/
+
+// Runs jobs of poQueue in the calling worker thread until at most
+// nMaxRemainingJobs of them are pending. Jobs of other queues are not run,
+// as they could try to take locks held up in the call stack.
+void CPLWorkerThreadPool::HelpUntilCompletion(CPLWorkerThread *psWorkerThread,
+                                              CPLJobQueue *poQueue,
+                                              int nMaxRemainingJobs)
+{
+    while (poQueue->m_nPendingJobs > nMaxRemainingJobs)
+    {
+        const unsigned nJobsSubmitted = m_nJobsSubmitted;
+
+        CPLWorkerThreadJob sJob;
+        if (TryGetJob(psWorkerThread, poQueue, sJob))
+        {
+            RunJob(sJob);
+            continue;
         }
-        else
+
+        // Remaining jobs are running in other threads: sleep until one of
+        // them finishes or a new job is submitted.
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        m_nSleepingHelpers++;
+        while (poQueue->m_nPendingJobs > nMaxRemainingJobs &&
+               m_nJobsSubmitted == nJobsSubmitted)
         {
-            break;
+            m_cvWorkers.wait(oGuard);
         }
+        m_nSleepingHelpers--;
     }
+}
 
-    return true;
+/************************************************************************/
+/*                           WakeUpHelpers()                            */
+/************************************************************************/
+
+void CPLWorkerThreadPool::WakeUpHelpers()
+{
+    if (m_nSleepingHelpers > 0)
+    {
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_cvWorkers.notify_all();
+    }
 }
 
 /************************************************************************/
@@ -465,25 +532,26 @@ bool CPLWorkerThreadPool::Setup(int nThreads, CPLThreadFunc pfnInitFunc,
     }
 
     bool bRet = true;
-    for (int i = static_cast<int>(aWT.size()); i < nThreads; i++)
     {
-        std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
-        wt->pfnInitFunc = pfnInitFunc;
-        wt->pInitData = pasInitData ? pasInitData[i] : nullptr;
-        wt->poTP = this;
-        wt->bMarkedAsWaiting = false;
-        wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-        if (wt->hThread == nullptr)
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        for (int i = static_cast<int>(aWT.size()); i < nThreads; i++)
         {
-            nThreads = i;
-            bRet = false;
-            break;
+            std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
+            wt->pfnInitFunc = pfnInitFunc;
+            wt->pInitData = pasInitData ? pasInitData[i] : nullptr;
+            wt->poTP = this;
+            wt->hThread =
+                CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
+            if (wt->hThread == nullptr)
+            {
+                nThreads = i;
+                bRet = false;
+                break;
+            }
+            aWT.emplace_back(std::move(wt));
         }
-        aWT.emplace_back(std::move(wt));
-    }
+        m_nThreadCount = static_cast<int>(aWT.size());
 
-    {
-        std::lock_guard<std::mutex> oGuard(m_mutex);
         if (nThreads > m_nMaxThreads)
             m_nMaxThreads = nThreads;
     }
@@ -492,7 +560,7 @@ bool CPLWorkerThreadPool::Setup(int nThreads, CPLThreadFunc pfnInitFunc,
     {
         // Wait all threads to be started
         std::unique_lock<std::mutex> oGuard(m_mutex);
-        while (nWaitingWorkerThreads < nThreads)
+        while (m_nStartedThreads < nThreads)
         {
             m_cv.wait(oGuard);
         }
@@ -512,72 +580,7 @@ void CPLWorkerThreadPool::DeclareJobFinished()
 {
     std::lock_guard<std::mutex> oGuard(m_mutex);
     nPendingJobs--;
-    m_cv.notify_one();
-}
-
-/************************************************************************/
-/*                             GetNextJob()                             */
-/************************************************************************/
-
-CPLWorkerThreadJob *
-CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
-{
-    while (true)
-    {
-        std::unique_lock<std::mutex> oGuard(m_mutex);
-        if (eState == CPLWTS_STOP)
-        {
-            return nullptr;
-        }
-        CPLList *psTopJobIter = psJobQueue;
-        if (psTopJobIter)
-        {
-            psJobQueue = psTopJobIter->psNext;
-
-#if DEBUG_VERBOSE
-            CPLDebug("JOB", "%p got a job", psWorkerThread);
-#endif
-            CPLWorkerThreadJob *psJob =
-                static_cast<CPLWorkerThreadJob *>(psTopJobIter->pData);
-            CPLFree(psTopJobIter);
-            return psJob;
-        }
-
-        if (!psWorkerThread->bMarkedAsWaiting)
-        {
-            psWorkerThread->bMarkedAsWaiting = true;
-            nWaitingWorkerThreads++;
-
-            CPLList *psItem =
-                static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-            if (psItem == nullptr)
-            {
-                eState = CPLWTS_ERROR;
-                m_cv.notify_one();
-
-                return nullptr;
-            }
-
-            psItem->pData = psWorkerThread;
-            psItem->psNext = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psItem;
-
-#if DEBUG_VERBOSE
-            CPLAssert(CPLListCount(psWaitingWorkerThreadsList) ==
-                      nWaitingWorkerThreads);
-#endif
-        }
-
-        m_cv.notify_one();
-
-#if DEBUG_VERBOSE
-        CPLDebug("JOB", "%p sleeping", psWorkerThread);
-#endif
-
-        std::unique_lock<std::mutex> oGuardThisThread(psWorkerThread->m_mutex);
-        oGuard.unlock();
-        psWorkerThread->m_cv.wait(oGuardThisThread);
-    }
+    m_cv.notify_all();
 }
 
 /************************************************************************/
@@ -615,38 +618,20 @@ CPLJobQueue::~CPLJobQueue()
     WaitCompletion();
 }
 
-/************************************************************************/
-/*                           JobQueueJob                                */
-/************************************************************************/
-
-struct JobQueueJob
-{
-    CPLJobQueue *poQueue = nullptr;
-    CPLThreadFunc pfnFunc = nullptr;
-    void *pData = nullptr;
-};
-
-/************************************************************************/
-/*                          JobQueueFunction()                          */
-/************************************************************************/
-
-void CPLJobQueue::JobQueueFunction(void *pData)
-{
-    JobQueueJob *poJob = static_cast<JobQueueJob *>(pData);
-    poJob->pfnFunc(poJob->pData);
-    poJob->poQueue->DeclareJobFinished();
-    delete poJob;
-}
-
 /************************************************************************/
 /*                          DeclareJobFinished()                        */
 /************************************************************************/
 
 void CPLJobQueue::DeclareJobFinished()
 {
-    std::lock_guard<std::mutex> oGuard(m_mutex);
-    m_nPendingJobs--;
-    m_cv.notify_one();
+    CPLWorkerThreadPool *poPool = m_poPool;
+    {
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_nPendingJobs--;
+        m_cv.notify_one();
+    }
+    // This object may have been destroyed by now.
+    poPool->WakeUpHelpers();
 }
 
 /************************************************************************/
@@ -661,20 +646,39 @@ void CPLJobQueue::DeclareJobFinished()
  */
 bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
 {
-    JobQueueJob *poJob = new JobQueueJob;
-    poJob->poQueue = this;
-    poJob->pfnFunc = pfnFunc;
-    poJob->pData = pData;
+    CPLWorkerThreadJob sJob;
+    sJob.pfnFunc = pfnFunc;
+    sJob.pData = pData;
+    return PushJob(std::move(sJob));
+}
+
+/** Queue a new job.
+ *
+ * @param task Function to run for the job.
+ * @return true in case of success.
+ * @since GDAL 3.9
+ */
+bool CPLJobQueue::SubmitJob(std::function<void()> task)
+{
+    CPLWorkerThreadJob sJob;
+    sJob.task = std::move(task);
+    return PushJob(std::move(sJob));
+}
+
+bool CPLJobQueue::PushJob(CPLWorkerThreadJob &&sJob)
+{
+    sJob.poQueue = this;
     {
         std::lock_guard<std::mutex> oGuard(m_mutex);
         m_nPendingJobs++;
     }
-    bool bRet = m_poPool->SubmitJob(JobQueueFunction, poJob);
-    if (!bRet)
+    if (!m_poPool->PushJob(std::move(sJob)))
     {
-        delete poJob;
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_nPendingJobs--;
+        return false;
     }
-    return bRet;
+    return true;
 }
 
 /************************************************************************/
@@ -682,6 +686,9 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * When called from a worker thread of the pool, pending jobs of this queue
+ * are run by the calling thread while waiting.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might
@@ -689,9 +696,94 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
  */
 void CPLJobQueue::WaitCompletion(int nMaxRemainingJobs)
 {
+    CPLWorkerThread *psWT = threadLocalCurrentWorkerThread;
+    if (psWT != nullptr && psWT->poTP == m_poPool)
+        m_poPool->HelpUntilCompletion(psWT, this, nMaxRemainingJobs);
+
+    // Also makes sure that DeclareJobFinished() no longer uses m_mutex.
     std::unique_lock<std::mutex> oGuard(m_mutex);
     while (m_nPendingJobs > nMaxRemainingJobs)
     {
         m_cv.wait(oGuard);
     }
 }
+
+/************************************************************************/
+/*                       CPLGetGlobalThreadPool()                       */
+/************************************************************************/
+
+static std::mutex gMutexGlobalThreadPool;
+static CPLWorkerThreadPool *gpoGlobalThreadPool = nullptr;
+
+/** Return the thread pool shared by GDAL and CPL, with at least nThreads
+ * threads.
+ *
+ * GDALGetGlobalThreadPool() returns the same pool.
+ *
+ * @param nThreads Minimum number of threads of the pool.
+ * @return the pool, or nullptr if it could not be created.
+ * @since GDAL 3.9
+ */
+CPLWorkerThreadPool *CPLGetGlobalThreadPool(int nThreads)
+{
+    std::lock_guard<std::mutex> oGuard(gMutexGlobalThreadPool);
+    if (gpoGlobalThreadPool == nullptr)
+    {
+        gpoGlobalThreadPool = new CPLWorkerThreadPool();
+        if (!gpoGlobalThreadPool->Setup(nThreads, nullptr, nullptr, false))
+        {
+            delete gpoGlobalThreadPool;
+            gpoGlobalThreadPool = nullptr;
+        }
+    }
+    else if (nThreads > gpoGlobalThreadPool->GetThreadCount())
+    {
+        // Increase size of thread pool
+        gpoGlobalThreadPool->Setup(nThreads, nullptr, nullptr, false);
+    }
+    return gpoGlobalThreadPool;
+}
+
+/************************************************************************/
+/*                     CPLDestroyGlobalThreadPool()                     */
+/************************************************************************/
+
+/*! @cond Doxygen_Suppress */
+void CPLDestroyGlobalThreadPool()
+{
+    std::lock_guard<std::mutex> oGuard(gMutexGlobalThreadPool);
+    delete gpoGlobalThreadPool;
+    gpoGlobalThreadPool = nullptr;
+}
+/*! @endcond */
+
+/************************************************************************/
+/*                          CPLGetNumThreads()                          */
+/************************************************************************/
+
+/** Returns the number of threads to use.
+ *
+ * The value is taken from the pszItem option of papszOptions if it is set,
+ * or from the GDAL_NUM_THREADS configuration option otherwise. It can be an
+ * integer or ALL_CPUS. When neither is set, 1 is returned, so that
+ * multi-threading is only enabled on request.
+ *
+ * GDALGetNumThreads() is the same function.
+ *
+ * @param papszOptions Options, or nullptr.
+ * @param pszItem Name of the option in papszOptions, or nullptr.
+ * @param nMaxThreads Maximum value returned.
+ * @return a number of threads in [1, nMaxThreads].
+ * @since GDAL 3.9
+ */
+int CPLGetNumThreads(CSLConstList papszOptions, const char *pszItem,
+                     int nMaxThreads)
+{
+    const char *pszThreads =
+        pszItem ? CSLFetchNameValue(papszOptions, pszItem) : nullptr;
+    if (pszThreads == nullptr)
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(nMaxThreads, nThreads));
+}
@@ -33,7 +33,10 @@
 #include "cpl_multiproc.h"
 #include "cpl_list.h"
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -46,9 +49,17 @@
  */
 
 #ifndef DOXYGEN_SKIP
-struct CPLWorkerThreadJob;
+class CPLJobQueue;
 class CPLWorkerThreadPool;
 
+struct CPLWorkerThreadJob
+{
+    CPLThreadFunc pfnFunc = nullptr;
+    void *pData = nullptr;
+    std::function<void()> task{};
+    CPLJobQueue *poQueue = nullptr;
+};
+
 struct CPLWorkerThread
 {
     CPL_DISALLOW_COPY_ASSIGN(CPLWorkerThread)
@@ -58,10 +69,11 @@ struct CPLWorkerThread
     void *pInitData = nullptr;
     CPLWorkerThreadPool *poTP = nullptr;
     CPLJoinableThread *hThread = nullptr;
-    bool bMarkedAsWaiting = false;
 
+    // Jobs submitted from this thread. It pushes and pops them at the back,
+    // other threads steal them from the front.
     std::mutex m_mutex{};
-    std::condition_variable m_cv{};
+    std::deque<CPLWorkerThreadJob> m_aoJobs{};
 };
 
 typedef enum
@@ -72,8 +84,6 @@ typedef enum
 } CPLWorkerThreadState;
 #endif  // ndef DOXYGEN_SKIP
 
-class CPLJobQueue;
-
 /** Pool of worker threads */
 class CPL_DLL CPLWorkerThreadPool
 {
@@ -82,19 +92,34 @@ class CPL_DLL CPLWorkerThreadPool
     std::vector<std::unique_ptr<CPLWorkerThread>> aWT{};
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
+    std::condition_variable m_cvWorkers{};
     volatile CPLWorkerThreadState eState = CPLWTS_OK;
-    CPLList *psJobQueue = nullptr;
-    int nPendingJobs = 0;
+    std::deque<CPLWorkerThreadJob> m_aoJobQueue{};
+    std::atomic<int> nPendingJobs{0};
 
-    CPLList *psWaitingWorkerThreadsList = nullptr;
-    int nWaitingWorkerThreads = 0;
+    std::atomic<unsigned> m_nJobsSubmitted{0};
+    std::atomic<int> m_nIdleWorkerThreads{0};
+    std::atomic<int> m_nReservedWorkerThreads{0};
+    std::atomic<int> m_nSleepingHelpers{0};
+    std::atomic<int> m_nThreadCount{0};
+    int m_nStartedThreads = 0;
 
     int m_nMaxThreads = 0;
 
     static void WorkerThreadFunction(void *user_data);
 
     void DeclareJobFinished();
-    CPLWorkerThreadJob *GetNextJob(CPLWorkerThread *psWorkerThread);
+    bool StartThreadIfNeeded();
+    bool PushJob(CPLWorkerThreadJob &&sJob);
+    void NotifyNewJobs(unsigned nJobs);
+    bool TryGetJob(CPLWorkerThread *psWorkerThread, const CPLJobQueue *poQueue,
+                   CPLWorkerThreadJob &sJob);
+    void RunJob(CPLWorkerThreadJob &sJob);
+    void HelpUntilCompletion(CPLWorkerThread *psWorkerThread,
+                             CPLJobQueue *poQueue, int nMaxRemainingJobs);
+    void WakeUpHelpers();
+
+    friend class CPLJobQueue;
 
   public:
     CPLWorkerThreadPool();
@@ -107,6 +132,7 @@ class CPL_DLL CPLWorkerThreadPool
     std::unique_ptr<CPLJobQueue> CreateJobQueue();
 
     bool SubmitJob(CPLThreadFunc pfnFunc, void *pData);
+    bool SubmitJob(std::function<void()> task);
     bool SubmitJobs(CPLThreadFunc pfnFunc, const std::vector<void *> &apData);
     void WaitCompletion(int nMaxRemainingJobs = 0);
     void WaitEvent();
@@ -118,16 +144,22 @@ class CPL_DLL CPLWorkerThreadPool
     }
 };
 
-/** Job queue */
+/** Job queue.
+ *
+ * Groups jobs submitted to a worker thread pool, so that their completion
+ * can be waited for. Jobs may themselves submit jobs to another queue of the
+ * same pool and wait for them: WaitCompletion() then runs those jobs in the
+ * calling worker thread instead of blocking it.
+ */
 class CPL_DLL CPLJobQueue
 {
     CPL_DISALLOW_COPY_ASSIGN(CPLJobQueue)
     CPLWorkerThreadPool *m_poPool = nullptr;
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
-    int m_nPendingJobs = 0;
+    std::atomic<int> m_nPendingJobs{0};
 
-    static void JobQueueFunction(void *);
+    bool PushJob(CPLWorkerThreadJob &&sJob);
     void DeclareJobFinished();
 
     //! @cond Doxygen_Suppress
@@ -146,7 +178,18 @@ class CPL_DLL CPLJobQueue
     }
 
     bool SubmitJob(CPLThreadFunc pfnFunc, void *pData);
+    bool SubmitJob(std::function<void()> task);
     void WaitCompletion(int nMaxRemainingJobs = 0);
 };
 
+CPLWorkerThreadPool CPL_DLL *CPLGetGlobalThreadPool(int nThreads);
+
+int CPL_DLL CPLGetNumThreads(CSLConstList papszOptions = nullptr,
+                             const char *pszItem = "NUM_THREADS",
+                             int nMaxThreads = 1024);
+
+//! @cond Doxygen_Suppress
+void CPLDestroyGlobalThreadPool();
+//! @endcond
+
 #endif  // CPL_WORKER_THREAD_POOL_H_INCLUDED_